@@ -49,6 +49,12 @@ namespace nd4j {
                 // still do nothing
             }
         }
+
+        const char* deterministic = std::getenv("ND4J_DETERMINISTIC");
+        if (deterministic != nullptr) {
+            std::string det(deterministic);
+            _deterministic.store(det == "1" || det == "true");
+        }
 #endif
     }
 
@@ -130,6 +136,14 @@ namespace nd4j {
         _maxThreads.store(max);
     }
 
+    bool Environment::isDeterministic() {
+        return _deterministic.load();
+    }
+
+    void Environment::setDeterministic(bool reallyDeterministic) {
+        _deterministic.store(reallyDeterministic);
+    }
+
     bool Environment::precisionBoostAllowed() {
         return _precBoost.load();
     }
@@ -38,6 +38,7 @@ namespace nd4j{
         std::atomic<nd4j::DataType> _dataType;
         std::atomic<bool> _precBoost;
         std::atomic<bool> _useMKLDNN{true};
+        std::atomic<bool> _deterministic{false};
 
 #ifdef __ND4J_EXPERIMENTAL__
         const bool _experimental = true;
@@ -72,6 +73,13 @@ namespace nd4j{
         bool isUseMKLDNN() { return _useMKLDNN.load(); }
         void setUseMKLDNN(bool useMKLDNN) { _useMKLDNN.store(useMKLDNN); }
 
+        /**
+         * In deterministic mode reductions combine partial results in fixed order,
+         * so results don't depend on number of threads used
+         */
+        bool isDeterministic();
+        void setDeterministic(bool reallyDeterministic);
+
         nd4j::DataType defaultFloatDataType();
         void setDefaultFloatDataType(nd4j::DataType dtype);
 
@@ -64,7 +64,12 @@ namespace nd4j {
         */
         static nd4j::graph::ResultWrapper* executeFlatBuffer(Nd4jPointer pointer);
 
-        static flatbuffers::Offset<FlatResult> execute(Graph *graph, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request);
+        /**
+        * This method executes given Graph for given inference request, and packs results into FlatResult
+        *
+        * @param variableSpace - optional VariableSpace (i.e. VariableProxy) to be used instead of Graph's own VariableSpace
+        */
+        static flatbuffers::Offset<FlatResult> execute(Graph *graph, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request, VariableSpace *variableSpace = nullptr);
 
         static Graph *importFromTensorFlow(const char *fileName);
 
@@ -40,6 +40,13 @@
 //#include <google/protobuf/io/zero_copy_stream_impl.h>
 
 #include <fcntl.h>
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/mman.h>
+#else
+#include <io.h>
+#include <helpers/mman.h>
+#endif
 
 #include <chrono>
 #include <ctime>
@@ -54,6 +61,8 @@
 #include <graph/ExecutionResult.h>
 #include <graph/exceptions/graph_execution_exception.h>
 #include <graph/exceptions/no_results_exception.h>
+#include <openmp_pragmas.h>
+#include <helpers/ThreadPool.h>
 
 namespace nd4j{
 namespace graph {
@@ -198,6 +207,108 @@ namespace graph {
 }
 
 
+/**
+ * This method checks inputs of given Node, and tells if this Node should be skipped due to inactive input or divergent branch.
+ * Node is marked as inactive in FlowPath if it should be skipped.
+ *
+ * PLEASE NOTE: Merge nodes have own checkout logic, and aren't covered here
+ */
+static bool isNodeSkippable(Graph *graph, FlowPath *flowPath, Node *node) {
+    for (int e = 0; e < node->input()->size(); e++) {
+        auto inputId = node->input()->at(e);
+
+        // not a node. skipping checks
+        if (graph->getMapped()->count(inputId.first) == 0)
+            continue;
+
+        /**
+         * We can skip current node, in two cases:
+         * 1) If previous node was disabled
+         * 2) If previous node was divergent node (i.e. IF op) and code went other way
+         */
+        Node *prevNode = graph->getMapped()->at(inputId.first);
+        if (!flowPath->isNodeActive(inputId.first)) {
+            flowPath->markNodeActive(node->id(), false);
+
+            nd4j_debug("Skipping Node_%i due to inactive input [%i]\n", node->id(), inputId.first);
+            return true;
+
+        } else if (prevNode->isDivergencePoint()) { // literally checking for switch here
+            if (flowPath->branch(inputId.first) != inputId.second) {
+                flowPath->markNodeActive(node->id(), false);
+                nd4j_debug("Skipping Node_%i due to divergent branch [%i]\n", node->id(), inputId.first);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * This method tells if given Node can be executed concurrently with other Nodes from the same layer:
+ * plain custom ops only, without control flow, embedded graphs, inplace execution or external outputs
+ */
+static bool isNodeConcurrent(Node *node) {
+    return node->opType() != OpType_LOGIC && node->hasCustomOp() && !node->hasGraphEmbedded() && !node->isInplace() && !node->hasExternalOutputs() && !node->isDivergencePoint();
+}
+
+/**
+ * This method executes all Nodes of given onion layer concurrently.
+ *
+ * Layer is processed in 3 steps: inputs checks are done sequentially, active Nodes are executed in parallel,
+ * and FlowPath is updated sequentially once all Nodes are done. So FlowPath is never modified from parallel region.
+ */
+static Nd4jStatus executeLayerConcurrently(Graph *graph, int layer, VariableSpace *variableSpace, FlowPath *flowPath) {
+    auto nodes = graph->getOnion()->at(layer);
+
+    std::vector<Node*> active;
+    for (auto node: *nodes) {
+        nd4j_debug("Node: %i <%s>\n", node->id(), node->name()->c_str());
+
+        if (isNodeSkippable(graph, flowPath, node))
+            continue;
+
+        flowPath->markNodeActive(node->id(), true);
+
+        // ContextPrototype is created lazily, so we make sure it exists before going parallel
+        node->getContextPrototype();
+        active.emplace_back(node);
+    }
+
+    const int numNodes = (int) active.size();
+    std::vector<Nd4jStatus> statuses(numNodes, Status::OK());
+    std::vector<Nd4jLong> timings(numNodes, 0L);
+
+    // nodes go through shared pool: ops within them get fair share of threads, and concurrent graphs don't oversubscribe cores
+    ThreadPool::getInstance()->parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+        for (auto e = start; e < stop; e++) {
+            auto timeStart = std::chrono::system_clock::now();
+
+            try {
+                statuses[e] = GraphExecutioner::executeFlatNode(graph, active[e], variableSpace);
+            } catch (std::exception &exc) {
+                nd4j_printf("Node_%i failed: %s\n", active[e]->id(), exc.what());
+                statuses[e] = Status::THROW("Node execution failed");
+            }
+
+            auto timeEnd = std::chrono::system_clock::now();
+            timings[e] = std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count();
+        }
+    }, 0, numNodes);
+
+    for (int e = 0; e < numNodes; e++) {
+        flowPath->setOuterTime(active[e]->id(), timings[e]);
+
+        if (statuses[e] != ND4J_STATUS_OK)
+            return statuses[e];
+
+        flowPath->markExecuted(active[e]->id(), true);
+    }
+
+    return Status::OK();
+}
+
 /**
  * This method executes given Graph instance, and returns error code.
  *
@@ -226,6 +337,13 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
         }
     }
 
+    // intermediate arrays will be placed according to static memory plan, if it was built for current input shapes
+    Nd4jLong planSignature = 0L;
+    if (__variableSpace->isMemoryPlanningEnabled() && MemoryPlan::isPlannable(graph)) {
+        planSignature = MemoryPlan::signature(graph, __variableSpace);
+        __variableSpace->setMemoryPlan(planSignature != 0L ? graph->memoryPlan(planSignature) : nullptr);
+    }
+
     // optionally saving graph build time
     if (Environment::getInstance()->isProfiling())
         flowPath->profile()->setBuildTime(GraphProfile::relativeTime(tb0));
@@ -248,8 +366,30 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
     for (int l = 0; l < (int) graph->getOnion()->size(); l++) {
         int layerSize = graph->getOnion()->count(l) == 1 ? graph->getOnion()->at(l)->size() : 0;
 
+        // independent nodes within the same layer can be executed concurrently, if user asked for that
+        if (pe && layerSize > 1 && frames.empty() && !leftFrame && !Environment::getInstance()->isProfiling() && !Environment::getInstance()->isDebugAndVerbose()) {
+            bool concurrent = true;
+            for (auto node: *graph->getOnion()->at(l)) {
+                if (!isNodeConcurrent(node)) {
+                    concurrent = false;
+                    break;
+                }
+            }
+
+            if (concurrent) {
+                exec_counter += layerSize;
+                if (exec_counter > 10000)
+                    return Status::THROW("Early termination hit");
+
+                auto status = executeLayerConcurrently(graph, l, __variableSpace, flowPath);
+                if (status != Status::OK())
+                    return status;
+
+                continue;
+            }
+        }
+
         int n = 0;
-// this omp block will probably never be the case
         for (; n < layerSize; n++) {
             if (++exec_counter > 10000) {
                 l = graph->getOnion()->size();
@@ -300,36 +440,7 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
 
                 } else {
                     // let's check for input nodes, if they are disabled or contain divergents
-                    for (int e = 0; e < node->input()->size(); e++) {
-                        auto inputId = node->input()->at(e);
-
-                        // not a node. skipping checks
-                        if (graph->getMapped()->count(inputId.first) == 0)
-                            continue;
-
-                        /**
-                         * We can skip current node, in two cases:
-                         * 1) If previous node was disabled
-                         * 2) If previous node was divergent node (i.e. IF op) and code went other way
-                         */
-                        Node *prevNode = graph->getMapped()->at(inputId.first);
-                        if (!flowPath->isNodeActive(inputId.first)) {
-                            shouldSkip = true;
-                            flowPath->markNodeActive(node->id(), false);
-
-                            nd4j_debug("Skipping Node_%i due to inactive input [%i]\n", node->id(), inputId.first);
-                            break;
-
-                        } else if (prevNode->isDivergencePoint()) { // literally checking for switch here
-                            if (flowPath->branch(inputId.first) != inputId.second) {
-                                shouldSkip = true;
-                                flowPath->markNodeActive(node->id(), false);
-                                nd4j_debug("Skipping Node_%i due to divergent branch [%i]\n", node->id(),
-                                           inputId.first);
-                                break;
-                            }
-                        }
-                    }
+                    shouldSkip = isNodeSkippable(graph, flowPath, node);
                 }
 
                 if (shouldSkip)
@@ -486,6 +597,17 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
         //flowPath->profile().printOut();
     }
 
+    // first round for given input shapes goes without plan, and actual array sizes are used to build one
+    if (planSignature != 0L) {
+        if (__variableSpace->memoryPlan() == nullptr) {
+            auto plan = new MemoryPlan();
+            plan->build(graph, MemoryPlan::footprint(graph, __variableSpace));
+            graph->registerMemoryPlan(planSignature, plan);
+        }
+
+        __variableSpace->setMemoryPlan(nullptr);
+    }
+
     // saving memory footprint for current run
     if (__variableSpace->workspace() != nullptr) {
         auto m = __variableSpace->workspace()->getAllocatedSize();
@@ -837,21 +959,21 @@ uint8_t* readFlatBuffers(const char * filename) {
     uint8_t * data = new uint8_t[fileLen];
 
     FILE *in = fopen(filename, "rb");
-    int cnt = 0;
-    int b = 0;
-    while (cnt < fileLen) {
-        b += fread(data + cnt, 1, 1, in);
+    auto cnt = fread(data, 1, fileLen, in);
+    fclose(in);
 
-        cnt++;
+    if (cnt != static_cast<size_t>(fileLen)) {
+        delete[] data;
+        nd4j_printf("File [%s]: only %lld of %lld bytes were read\n", filename, (Nd4jLong) cnt, (Nd4jLong) fileLen);
+        throw std::runtime_error("Failed to read file");
     }
-    fclose(in);
 
     return data;
 }
 
-flatbuffers::Offset<FlatResult> GraphExecutioner::execute(Graph *graph, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request) {
+flatbuffers::Offset<FlatResult> GraphExecutioner::execute(Graph *graph, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request, VariableSpace *variableSpace) {
     ExecutionResult result;
-    auto varSpace = graph->getVariableSpace();
+    auto varSpace = variableSpace == nullptr ? graph->getVariableSpace() : variableSpace;
 
     if (request != nullptr && request->variables() != nullptr) {
         auto vars = request->variables();
@@ -865,11 +987,11 @@ flatbuffers::Offset<FlatResult> GraphExecutioner::execute(Graph *graph, flatbuff
     if (Environment::getInstance()->isDebugAndVerbose())
         graph->printOut();
 
-    auto status = GraphExecutioner::execute(graph);
+    auto status = GraphExecutioner::execute(graph, varSpace);
     if (status != nd4j::Status::OK())
         throw graph_execution_exception(request->id());
 
-    auto outputs = graph->fetchOutputs();
+    auto outputs = graph->fetchOutputs(varSpace);
 
     if (outputs->size() == 0)
         throw no_results_exception(request->id());
@@ -893,9 +1015,34 @@ flatbuffers::Offset<FlatResult> GraphExecutioner::execute(Graph *graph, flatbuff
         *   PLEASE NOTE: This method is mostly suited for tests and debugging/profiling
         */
         Graph* GraphExecutioner::importFromFlatBuffers(const char *filename) {
-            auto data = readFlatBuffers(filename);
-            auto restoredGraph = importFromFlatPointer(reinterpret_cast<Nd4jPointer>(data));
-            delete[] data;
+            long fileLen = getFileSize(filename);
+            if (fileLen < 0) {
+                nd4j_printf("File [%s] wasn't found. Please check path and permissions\n", filename);
+                throw std::runtime_error("File not found");
+            }
+
+            // private mapping: pages are shared via page cache and faulted in lazily, writes stay local
+            void *ptr = MAP_FAILED;
+            int fd = open(filename, O_RDONLY);
+            if (fd >= 0 && fileLen > 0) {
+                ptr = mmap(nullptr, fileLen, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                close(fd);
+            } else if (fd >= 0)
+                close(fd);
+
+            if (ptr == MAP_FAILED) {
+                nd4j_debug("File [%s] can't be mapped, reading it instead\n", filename);
+
+                auto data = readFlatBuffers(filename);
+                auto restoredGraph = importFromFlatPointer(reinterpret_cast<Nd4jPointer>(data));
+                delete[] data;
+                return restoredGraph;
+            }
+
+            auto fg = GetFlatGraph(reinterpret_cast<uint8_t *>(ptr));
+            auto restoredGraph = new Graph(fg, nullptr, true);
+            restoredGraph->attachMappedFile(ptr, fileLen);
+
             return restoredGraph;
         }
 
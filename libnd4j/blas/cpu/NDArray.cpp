@@ -42,6 +42,7 @@
 #include <helpers/threshold.h>
 #include <graph/exceptions/datatype_exception.h>
 #include <helpers/ConstantTadHelper.h>
+#include <helpers/ConstantShapeHelper.h>
 
 namespace nd4j {
 
@@ -1048,8 +1049,14 @@ void NDArray::replacePointers(void *buffer, Nd4jLong *shapeInfo, const bool rele
                     BUILD_DOUBLE_SELECTOR(_dataType, other._dataType, templatedDoubleAssign, (_buffer, 0, other._buffer, 0), LIBND4J_TYPES, LIBND4J_TYPES);
                 }
                 else if (this->isEmpty() != other.isEmpty()) { // need assign non-empty scalar to empty
-                    if (other.isEmpty())
+                    if (other.isEmpty()) {
+                        if (!_isShapeAlloc) {
+                            setShapeInfo(ShapeBuilders::copyShapeInfo(_shapeInfo, true, _workspace));
+                            _isShapeAlloc = true;
+                        }
+
                         ArrayOptions::setPropertyBit(this->_shapeInfo, ARRAY_EMPTY);
+                    }
                     else
                         *this = other;
                 }
@@ -1993,17 +2000,10 @@ void NDArray::applyPairwiseTransform(nd4j::pairwise::BoolOps op, const NDArray *
 
         auto tadPack = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(_shapeInfo, copy);
 
-        Nd4jLong* shapeInfo;
-        if (_workspace == nullptr) {
-            shapeInfo = new Nd4jLong[shape::shapeInfoLength(tadPack.primaryShapeInfo())];
-        } else {
-            shapeInfo = reinterpret_cast<Nd4jLong *>(_workspace->allocateBytes(shape::shapeInfoByteLength(tadPack.primaryShapeInfo())));
-        }
-        std::memcpy(shapeInfo, tadPack.primaryShapeInfo(), shape::shapeInfoByteLength(tadPack.primaryShapeInfo()));
-
-        auto array = new NDArray(bufferWithOffset(tadPack.primaryOffsets()[index]), shapeInfo, _workspace);
+        // TAD shapeInfo is constant, so it's referenced instead of copying
+        auto array = new NDArray(bufferWithOffset(tadPack.primaryOffsets()[index]), tadPack.primaryShapeInfo(), _workspace);
         array->_isBuffAlloc = false;
-        array->_isShapeAlloc = true;
+        array->_isShapeAlloc = false;
         array->_isView = true;
 
         return array;
@@ -2327,6 +2327,12 @@ template void NDArray::applyScalar(nd4j::scalar::Ops op, const bool scalar, NDAr
 //////////////////////////////////////////////////////////////////////////
     // calculate strides
     void NDArray::updateStrides(const char order) {
+        // shapeInfo we don't own might be shared with other arrays, so we modify own copy
+        if (!_isShapeAlloc) {
+            setShapeInfo(ShapeBuilders::copyShapeInfo(_shapeInfo, true, _workspace));
+            _isShapeAlloc = true;
+        }
+
     	shape::updateStrides(_shapeInfo, order);
     }
 
@@ -3922,8 +3928,7 @@ template void NDArray::pIdx(const Nd4jLong* indices, const bool value);
     NDArray NDArray::operator()(const std::vector<Nd4jLong>& idx, const bool keepUnitiesInShape, const bool isStrided)  const {
 
         const int rank = rankOf();
-        Nd4jLong *newShape;
-        ALLOCATE(newShape, _workspace, shape::shapeInfoLength(rank), Nd4jLong);
+        Nd4jLong newShape[MAX_SHAPEINFOLENGTH];
         memcpy(newShape, _shapeInfo, shape::shapeInfoByteLength(rank));
 
         auto shapeOf = shape::shapeOf(newShape);
@@ -3953,8 +3958,10 @@ template void NDArray::pIdx(const Nd4jLong* indices, const bool value);
         // check if there is possibility to set ews = 1
         shape::setEws(newShape, subArrLen);
 
-        // create resulting sub-array
-        NDArray result(bufferWithOffset(offset), newShape, _workspace, false, true);
+        // create resulting sub-array, its shapeInfo is shared with all other sub-arrays of the same shape, unless shape cache is full
+        auto interned = ConstantShapeHelper::getInstance()->tryCreateFromExisting(newShape);
+        auto subShape = interned != nullptr ? interned : ShapeBuilders::copyShapeInfo(newShape, true, _workspace);
+        NDArray result(bufferWithOffset(offset), subShape, _workspace, false, interned == nullptr);
 
         if(!keepUnitiesInShape) {
             const int coeff = isStrided ? 3 : 2;
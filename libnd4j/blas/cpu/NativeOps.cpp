@@ -71,6 +71,7 @@ bool experimentalSupport = false;
 #include <graph/ResultWrapper.h>
 #include <helpers/DebugHelper.h>
 #include <helpers/ConstantTadHelper.h>
+#include <helpers/ThreadPool.h>
 
 using namespace nd4j;
 
@@ -1128,7 +1129,7 @@ int NativeOps::ompGetNumThreads() {
  */
 void NativeOps::setOmpNumThreads(int threads) {
     omp_set_num_threads(threads);
-
+    ThreadPool::getInstance()->setMaxThreads(threads);
 }
 
 Nd4jPointer NativeOps::createContext() {
@@ -1388,23 +1389,24 @@ void NativeOps::enableP2P(bool enable) {
 
 
 void NativeOps::encodeThresholdP1(Nd4jPointer *extraPointers, void *hX, Nd4jLong *hXShapeInfo, Nd4jLong N, int *dz, float threshold) {
-    // TODO: to be implemented
+    auto xType = ArrayOptions::dataType(hXShapeInfo);
+    BUILD_SINGLE_SELECTOR(xType, TypeCast::encodeThresholdP1, (hX, N, dz, threshold), FLOAT_TYPES);
 }
 
 
 void NativeOps::encodeThresholdP2Int(Nd4jPointer *extraPointers, int *hX, Nd4jLong N, int *dz) {
-    // TODO: to be implemented
+    TypeCast::encodeThresholdP2(hX, N, dz);
 }
 
 
 void NativeOps::encodeThresholdP3(Nd4jPointer *extraPointers, void *hX, Nd4jLong *hXShapeInfo, int *offsets, Nd4jLong N, int *dz){
-    // offsets won't be used here
-
-    // TODO: to be implemented
+    auto xType = ArrayOptions::dataType(hXShapeInfo);
+    BUILD_SINGLE_SELECTOR(xType, TypeCast::encodeThresholdP3, (hX, offsets, N, dz), FLOAT_TYPES);
 }
 
 void NativeOps::decodeThreshold(Nd4jPointer *extraPointers, void *hX, Nd4jLong N, void *dz, Nd4jLong *hZShapeInfo){
-    // TODO: to be implemented
+    auto zType = ArrayOptions::dataType(hZShapeInfo);
+    BUILD_SINGLE_SELECTOR(zType, TypeCast::convertFromThreshold, (extraPointers, hX, N, dz), FLOAT_TYPES);
 }
 
 bool NativeOps::isP2PAvailable() {
@@ -1505,7 +1507,7 @@ bool NativeOps::isExperimentalEnabled() {
 
 
 void NativeOps::setOmpMinThreads(int threads) {
-    // TODO: to be implemented
+    ThreadPool::getInstance()->setMinThreads(threads);
 }
 
 /*
@@ -32,6 +32,10 @@ namespace nd4j {
 
         bool _unitiesInShape;
 
+        // precomputed hash, used by ConstantTadHelper to pick cache bucket
+        Nd4jLong _hash = 0;
+
+        void evalHash();
     public:
         explicit TadDescriptor(const Nd4jLong *originalShape, const int *dimensions, const int length, const bool keepUnitiesInShape = false);
         explicit TadDescriptor(const ShapeDescriptor &descriptor, const std::vector<int> &dimensions, const bool keepUnitiesInShape = false);
@@ -53,6 +57,7 @@ namespace nd4j {
         std::vector<int>& axis();
         ShapeDescriptor& originalShape();
         bool areUnitiesinShape() const;
+        Nd4jLong hash() const;
     };
 }
 
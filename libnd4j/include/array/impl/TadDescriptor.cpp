@@ -27,6 +27,7 @@ namespace nd4j {
         _originalShape = other._originalShape;
         _axis = other._axis;
         _unitiesInShape = other._unitiesInShape;
+        _hash = other._hash;
     }
 
     TadDescriptor::TadDescriptor(const Nd4jLong *originalShape, const int *dimensions, const int length, const bool keepUnitiesInShape) {
@@ -41,6 +42,8 @@ namespace nd4j {
 
         _originalShape = descriptor;
         _unitiesInShape = keepUnitiesInShape;
+
+        evalHash();
     }
 
     TadDescriptor::TadDescriptor(const ShapeDescriptor &descriptor, const std::vector<int> &dimensions, const bool keepUnitiesInShape) {
@@ -50,6 +53,33 @@ namespace nd4j {
 
         if (_axis.size() > 1)
             std::sort(_axis.begin(), _axis.end());
+
+        evalHash();
+    }
+
+    void TadDescriptor::evalHash() {
+        // FNV-1a over everything operator== takes into account
+        auto mix = [](Nd4jLong h, Nd4jLong v) -> Nd4jLong {
+            return (Nd4jLong) (((unsigned long long) h ^ (unsigned long long) v) * 1099511628211ULL);
+        };
+
+        Nd4jLong h = (Nd4jLong) 14695981039346656037ULL;
+        h = mix(h, _originalShape.rank());
+        h = mix(h, _originalShape.order());
+        h = mix(h, _originalShape.ews());
+        h = mix(h, (Nd4jLong) _originalShape.dataType());
+        h = mix(h, _originalShape.isEmpty() ? 1 : 0);
+
+        for (auto v: _originalShape.shape())
+            h = mix(h, v);
+
+        for (auto v: _originalShape.strides())
+            h = mix(h, v);
+
+        for (auto v: _axis)
+            h = mix(h, v);
+
+        _hash = mix(h, _unitiesInShape ? 1 : 0);
     }
 
     bool TadDescriptor::operator==(const TadDescriptor &other) const {
@@ -72,4 +102,8 @@ namespace nd4j {
     bool TadDescriptor::areUnitiesinShape() const {
         return _unitiesInShape;   
     }
+
+    Nd4jLong TadDescriptor::hash() const {
+        return _hash;
+    }
 }
\ No newline at end of file
@@ -35,7 +35,11 @@ namespace nd4j {
 
             static std::pair<Nd4jLong, Nd4jLong> fromLongPair(LongPair* pair);
 
-            static NDArray* fromFlatArray(const nd4j::graph::FlatArray* flatArray);
+            /**
+             * Restores NDArray from FlatArray. With zeroCopy, a suitably aligned native-endian buffer
+             * is referenced in place, so the FlatBuffer memory must outlive the returned array
+             */
+            static NDArray* fromFlatArray(const nd4j::graph::FlatArray* flatArray, bool zeroCopy = false);
         };
     }
 }
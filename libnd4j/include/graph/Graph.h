@@ -34,6 +34,7 @@
 #include <graph/generated/graph_generated.h>
 #include <graph/generated/config_generated.h>
 #include <graph/ExecutorConfiguration.h>
+#include <graph/MemoryPlan.h>
 #include <ops/declarable/OpDescriptor.h>
 
 namespace nd4j {
@@ -66,6 +67,14 @@ namespace nd4j {
             std::map<int, Scope*> _mappedScopes;
             std::vector<Scope*> _scopes;
 
+            // static memory plans, one per signature of input shapes
+            std::map<Nd4jLong, MemoryPlan*> _plans;
+            std::mutex _mutexPlans;
+
+            // memory-mapped FlatBuffers file, referenced in place by constants
+            void *_mappedFile = nullptr;
+            Nd4jLong _mappedFileLength = 0L;
+
 ////////////////////////////////////////
             Nd4jStatus validateNode(nd4j::graph::Node *node);
 
@@ -80,7 +89,7 @@ namespace nd4j {
             void prepareOutputs();
 
         public:
-            Graph(const FlatGraph *flatGraph = nullptr, VariableSpace *variableSpace = nullptr);
+            Graph(const FlatGraph *flatGraph = nullptr, VariableSpace *variableSpace = nullptr, bool zeroCopy = false);
 
             ~Graph();
 
@@ -96,6 +105,24 @@ namespace nd4j {
             // this method will return estimated memory size (in bytes) required for 1 full graph execution round
             Nd4jLong estimateRequiredMemory();
 
+            /**
+             * This method returns MemoryPlan built for given signature of input shapes, or nullptr if there's no such plan yet
+             */
+            MemoryPlan* memoryPlan(Nd4jLong signature);
+
+            /**
+             * This method stores MemoryPlan for given signature of input shapes. Graph takes ownership of the plan.
+             * PLEASE NOTE: number of stored plans is limited, extra plans are just discarded
+             */
+            void registerMemoryPlan(Nd4jLong signature, MemoryPlan *plan);
+
+            /**
+             * This method passes ownership of memory-mapped FlatBuffers file to this Graph, it'll be unmapped in destructor
+             */
+            void attachMappedFile(void *ptr, Nd4jLong length);
+
+            bool isMapped();
+
             // this method returns number of root nodes in this graph
             int rootNodes();
 
@@ -138,6 +165,12 @@ namespace nd4j {
              */
             std::vector<nd4j::graph::Variable*> *fetchOutputs();
 
+            /**
+             * This method returns outputs of this graph, as stored in given VariableSpace
+             * @return
+             */
+            std::vector<nd4j::graph::Variable*> *fetchOutputs(VariableSpace *variableSpace);
+
             /**
              * This method returns pointer to ExecutorConfiguration
              *
@@ -192,6 +225,13 @@ namespace nd4j {
              */
             Graph* cloneWithProxy();
 
+            /**
+             * This method returns TRUE if this graph can be executed concurrently against separate VariableProxy instances,
+             * without cloning. That's possible only if execution never modifies nodes or backing VariableSpace, so graphs
+             * with logic ops, embedded graphs or external outputs aren't shareable.
+             */
+            bool isShareable();
+
             /**
              * This method removes reference to VariableSpace from this Graph
              */
@@ -219,6 +259,26 @@ namespace nd4j {
              */
             void tagInplaceNodes();
 
+            /**
+             * This method replaces chains of elementwise legacy ops (transform, scalar, pairwise, broadcast) with single
+             * LegacyFusedOp Node, so intermediate arrays aren't allocated. Last Node of each chain keeps its id.
+             * Applied only if intermediate results aren't going to be used, same as in-place optimization
+             */
+            void fuseElementwiseNodes();
+
+            /**
+             * This method executes Nodes that depend on constants only, and stores their results in VariableSpace as constants.
+             * Folded Nodes are removed from the Graph, their outputs remain available under the same ids
+             * @return ids of folded Nodes
+             */
+            std::vector<int> foldConstants();
+
+            /**
+             * This method removes Nodes that don't contribute to explicitly defined outputs of this Graph
+             * @return ids of removed Nodes
+             */
+            std::vector<int> pruneDeadNodes();
+
             void replaceState(VariableSpace *state, ExecutorConfiguration *configuration);
 
             FORCEINLINE std::vector<int>* nodes() {
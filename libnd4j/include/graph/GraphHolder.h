@@ -21,21 +21,73 @@
 #include <helpers/logger.h>
 #include <pointercast.h>
 #include <map>
+#include <mutex>
+#include <atomic>
+#include <vector>
 #include <graph/Graph.h>
-#include <helpers/SimpleReadWriteLock.h>
+#include <graph/RegisteredGraph.h>
 #include <graph/exceptions/unknown_graph_exception.h>
 
+// number of reader slots used for snapshot reclamation. each slot occupies its own cache line, and holds one counter per epoch
+#define GRAPH_HOLDER_SLOTS 64
+#define GRAPH_HOLDER_STRIDE 8
+
 namespace nd4j {
     namespace graph {
+        /**
+         * This class is registry of graphs used for inference.
+         *
+         * Registry is stored as immutable snapshot, so lookups never take locks: reader announces itself in one of
+         * reader slots, picks entry from current snapshot, and increments its reference counter.
+         * Writers build new snapshot, publish it atomically, and flip reader epoch before reclaiming previous snapshot:
+         * each slot only has to drain readers of retired epoch, so busy slots can't delay writer indefinitely. Entries removed from registry are released once the last in-flight
+         * request using them is finished, so graphs can be replaced without blocking inference.
+         */
         class ND4J_EXPORT GraphHolder {
         private:
+            typedef std::map<Nd4jLong, RegisteredGraph*> GraphsMap;
+
             static GraphHolder *_INSTANCE;
-            std::map<Nd4jLong, Graph *> _graphF;
 
-            std::map<Nd4jLong, SimpleReadWriteLock> _locks;
+            // current snapshot of registered graphs
+            std::atomic<GraphsMap*> _graphs;
+
+            // counters of readers currently accessing snapshot, indexed by slot and epoch
+            std::atomic<Nd4jLong> _readers[GRAPH_HOLDER_SLOTS * GRAPH_HOLDER_STRIDE];
+
+            // epoch new readers are counted in, either 0 or 1
+            std::atomic<int> _epoch;
 
-            GraphHolder() = default;
+            // writers are serialized
+            std::mutex _mutexWrite;
+
+            GraphHolder();
             ~GraphHolder() = default;
+
+            std::atomic<Nd4jLong>& readerSlot();
+
+            /**
+             * This method waits until readers that could've seen previous snapshot are gone.
+             * Must be called with _mutexWrite held.
+             */
+            void waitForReaders();
+
+            /**
+             * This method returns referenced entry for given graphId, or nullptr if there's no such graph.
+             * Entry must be released after use.
+             */
+            RegisteredGraph* acquireGraph(Nd4jLong graphId);
+
+            /**
+             * This method publishes new snapshot, and releases entries removed from registry once it's safe.
+             * Must be called with _mutexWrite held.
+             */
+            void publish(GraphsMap *graphs, RegisteredGraph *removed);
+
+            /**
+             * This method removes entry from registry, optionally detaching Graph from it
+             */
+            void removeGraph(Nd4jLong graphId, bool forget);
         public:
             static GraphHolder* getInstance();
 
@@ -57,37 +109,11 @@ namespace nd4j {
 
             flatbuffers::Offset<FlatResult> execute(Nd4jLong graphId, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request);
 
+            /**
+             * This method atomically replaces graph with given id. Requests already in flight will finish with
+             * previous graph, which is released afterwards.
+             */
             void replaceGraph(Nd4jLong graphId, Graph *graph);
-
-            /////////////////////////////
-
-            FORCEINLINE void lockWrite(Nd4jLong graphId) {
-                if (_locks.count(graphId) == 0)
-                    return;
-
-                _locks[graphId].lockWrite();
-            }
-
-            FORCEINLINE void unlockWrite(Nd4jLong graphId) {
-                if (_locks.count(graphId) == 0)
-                    return;
-
-                _locks[graphId].unlockWrite();
-            }
-
-            FORCEINLINE void lockRead(Nd4jLong graphId) {
-                if (_locks.count(graphId) == 0)
-                    return;
-
-                _locks[graphId].lockRead();
-            }
-
-            FORCEINLINE void unlockRead(Nd4jLong graphId) {
-                if (_locks.count(graphId) == 0)
-                    return;
-
-                _locks[graphId].unlockRead();
-            }
         };
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_MEMORYPLAN_H
+#define LIBND4J_MEMORYPLAN_H
+
+#include <map>
+#include <utility>
+#include <pointercast.h>
+#include <dll.h>
+
+namespace nd4j {
+    namespace graph {
+        class Graph;
+        class VariableSpace;
+
+        /**
+         * This class describes static layout of intermediate graph arrays within single arena.
+         *
+         * Each intermediate variable is alive from the layer it's produced at, till the last layer it's consumed at.
+         * Variables with disjoint lifetimes share the same memory, so arena size is close to peak of simultaneously alive arrays,
+         * instead of sum of all arrays.
+         */
+        class ND4J_EXPORT MemoryPlan {
+        protected:
+            // offset and size (in bytes) for each planned variable
+            std::map<std::pair<int, int>, std::pair<Nd4jLong, Nd4jLong>> _buffers;
+
+            Nd4jLong _arenaSize = 0L;
+            Nd4jLong _totalSize = 0L;
+        public:
+            // all offsets within arena are aligned to this number of bytes
+            static const Nd4jLong ALIGNMENT = 64;
+
+            MemoryPlan() = default;
+            ~MemoryPlan() = default;
+
+            /**
+             * This method builds plan for given Graph, using sizes (in bytes) of node outputs
+             *
+             * @param graph
+             * @param sizes - sizes of variables produced by nodes, i.e. obtained via footprint() after execution
+             */
+            void build(Graph *graph, const std::map<std::pair<int, int>, Nd4jLong> &sizes);
+
+            bool hasBuffer(const std::pair<int, int> &pair) const;
+            Nd4jLong offset(const std::pair<int, int> &pair) const;
+            Nd4jLong size(const std::pair<int, int> &pair) const;
+
+            int numberOfBuffers() const;
+
+            /**
+             * This method returns number of bytes required for arena
+             */
+            Nd4jLong arenaSize() const;
+
+            /**
+             * This method returns number of bytes planned variables would take without memory reuse
+             */
+            Nd4jLong totalSize() const;
+
+            /**
+             * This method tells if given Graph can be planned statically: graphs with loops, conditions or embedded graphs can't
+             */
+            static bool isPlannable(Graph *graph);
+
+            /**
+             * This method returns hash of shapes for all external variables used by given Graph, or 0 if some of them aren't available
+             */
+            static Nd4jLong signature(Graph *graph, VariableSpace *variableSpace);
+
+            /**
+             * This method returns sizes (in bytes) of all arrays produced by Graph nodes within given VariableSpace
+             */
+            static std::map<std::pair<int, int>, Nd4jLong> footprint(Graph *graph, VariableSpace *variableSpace);
+        };
+    }
+}
+
+
+#endif //LIBND4J_MEMORYPLAN_H
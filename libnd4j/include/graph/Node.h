@@ -137,6 +137,7 @@ namespace nd4j {
             bool hasInternalInputs();
 
             double scalar();
+            bool hasScalar();
 
             std::vector<int> * getDimensions();
             int * getDimensionsPtr();
@@ -166,6 +167,9 @@ namespace nd4j {
             bool hasBlockAttached();
 
             void setCustomOp(nd4j::ops::DeclarableOp *customOp = nullptr);
+
+            // this method replaces op and inputs of this Node, i.e. when chain of Nodes is fused into this one
+            void replaceOp(nd4j::ops::DeclarableOp *customOp, const std::vector<std::pair<int,int>> &inputs);
             nd4j::ops::DeclarableOp* getCustomOp();
             bool hasCustomOp();
 
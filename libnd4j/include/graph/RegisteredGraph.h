@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#ifndef LIBND4J_REGISTEREDGRAPH_H
+#define LIBND4J_REGISTEREDGRAPH_H
+
+#include <atomic>
+#include <graph/Graph.h>
+#include <graph/VariableProxyPool.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class represents single GraphHolder entry: Graph itself, plus optional pool of VariableProxy instances.
+         * Entry is reference counted: GraphHolder holds one reference, and each in-flight request holds another one,
+         * so replaced or dropped graph is released only after last request using it is finished.
+         */
+        class ND4J_EXPORT RegisteredGraph {
+        protected:
+            Graph* _graph;
+            VariableProxyPool* _pool = nullptr;
+
+            std::atomic<int> _references;
+
+            // if FALSE - graph won't be deleted together with this entry
+            std::atomic<bool> _owner;
+        public:
+            explicit RegisteredGraph(Graph *graph);
+            ~RegisteredGraph();
+
+            Graph* graph();
+
+            /**
+             * This method returns VariableProxyPool for shareable graphs, or nullptr otherwise
+             */
+            VariableProxyPool* pool();
+
+            /**
+             * This method increments number of references to this entry
+             */
+            void retain();
+
+            /**
+             * This method decrements number of references to this entry, and deletes it once nobody references it
+             */
+            void release();
+
+            /**
+             * This method detaches Graph from this entry, so it'll survive entry release
+             */
+            void forget();
+        };
+    }
+}
+
+
+#endif //LIBND4J_REGISTEREDGRAPH_H
@@ -44,6 +44,7 @@ namespace nd4j {
             bool _readOnly = false;
             bool _placeholder = false;
             bool _removable = true;
+            bool _constant = false;
 
             // for now we're setting default to numeric
             // in future we'll be fetching it right from the array, 
@@ -58,7 +59,7 @@ namespace nd4j {
             Variable(bool placeHolder);
             Variable(nd4j::NDArray *arrayw, const char *name, int id, int idx = 0);
             Variable(nd4j::NDArray *array = nullptr, const char *name = nullptr);
-            Variable(const nd4j::graph::FlatVariable *flatVariable);
+            Variable(const nd4j::graph::FlatVariable *flatVariable, bool zeroCopy = false);
             ~Variable();
 
             Variable* clone();
@@ -81,6 +82,11 @@ namespace nd4j {
 
             bool isPlaceholder();
 
+            /**
+             * This method returns TRUE if this Variable holds value that never changes between executions
+             */
+            bool isConstant();
+
             VariableType variableType();
             void setVariableType(VariableType variableType);
 
@@ -94,6 +100,7 @@ namespace nd4j {
             void markExternal(bool reallyExternal);
             void markReadOnly(bool reallyReadOnly);
             void markRemovable(bool reallyRemovable);
+            void markConstant(bool reallyConstant);
 
             int id();
             int index();
@@ -26,6 +26,12 @@ namespace nd4j {
         protected:
             VariableSpace* _backed = nullptr;
             VariableSpace* _current = nullptr;
+
+            /**
+             * This method returns proxy-local copy of given backed Variable, if it has no value attached yet.
+             * This way results of ops executed against proxy never land in backing VariableSpace
+             */
+            Variable* shadowVariable(Variable *variable);
         public:
             explicit VariableProxy(VariableSpace* reference);
             ~VariableProxy();
@@ -85,6 +91,11 @@ namespace nd4j {
             virtual nd4j::graph::Stash* getStash();
             virtual void setFlowPath(FlowPath* timers);
             virtual FlowPath* flowPath();
+
+            /**
+             * This method releases all proxy-local variables, so this proxy can be reused for next execution round
+             */
+            void reset();
         };
     }
 }
\ No newline at end of file
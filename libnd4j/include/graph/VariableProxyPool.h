@@ -0,0 +1,75 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#ifndef LIBND4J_VARIABLEPROXYPOOL_H
+#define LIBND4J_VARIABLEPROXYPOOL_H
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <graph/Graph.h>
+#include <graph/VariableProxy.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class holds reusable VariableProxy instances for shared (read-only) execution of a single Graph.
+         * Each execution round acquires its own proxy, so Graph itself is never cloned,
+         * and proxy workspace is kept warm between rounds.
+         */
+        class ND4J_EXPORT VariableProxyPool {
+        protected:
+            Graph* _graph;
+            std::vector<VariableProxy*> _pool;
+            std::mutex _mutex;
+
+            // maximal number of idle proxies kept in this pool
+            int _limit;
+
+            // number of proxies handed out and not released yet
+            std::atomic<int> _active;
+        public:
+            explicit VariableProxyPool(Graph *graph, int limit = 16);
+            ~VariableProxyPool();
+
+            /**
+             * This method returns VariableProxy ready for execution, backed by VariableSpace of the Graph
+             */
+            VariableProxy* acquire();
+
+            /**
+             * This method returns given VariableProxy back to the pool
+             */
+            void release(VariableProxy *proxy);
+
+            /**
+             * This method returns number of idle proxies stored in this pool
+             */
+            int size();
+
+            /**
+             * This method returns number of proxies currently in use
+             */
+            int active();
+
+            Graph* graph();
+        };
+    }
+}
+
+
+#endif //LIBND4J_VARIABLEPROXYPOOL_H
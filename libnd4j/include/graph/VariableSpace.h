@@ -34,6 +34,7 @@
 #include <memory/Workspace.h>
 #include <graph/Stash.h>
 #include <graph/FlowPath.h>
+#include <graph/MemoryPlan.h>
 
 
 namespace nd4j {
@@ -61,7 +62,8 @@ namespace nd4j {
 
             int _auto_counter = -1;
 
-            std::mutex _varmap;
+            // guards maps below, so nodes within the same layer can be executed concurrently
+            std::recursive_mutex _varmap;
 
             std::map<int, nd4j::graph::Variable*> _temporary;
 
@@ -69,6 +71,12 @@ namespace nd4j {
 
             FlowPath* _flow = nullptr;
 
+            // arena for intermediate arrays, laid out according to MemoryPlan
+            bool _planning = false;
+            MemoryPlan* _plan = nullptr;
+            int8_t* _arena = nullptr;
+            Nd4jLong _arenaSize = 0L;
+
         public:
             VariableSpace();
             virtual ~VariableSpace();
@@ -138,6 +146,24 @@ namespace nd4j {
 
             virtual void setFlowPath(FlowPath* timers);
             virtual FlowPath* flowPath();
+
+            /**
+             * These methods control static memory planning. If enabled, intermediate arrays are placed into single arena,
+             * so their values are available only until the end of execution.
+             */
+            void enableMemoryPlanning(bool reallyEnable);
+            bool isMemoryPlanningEnabled();
+
+            /**
+             * This method attaches MemoryPlan to this VariableSpace, expanding arena if required. nullptr detaches current plan.
+             */
+            void setMemoryPlan(MemoryPlan *plan);
+            MemoryPlan* memoryPlan();
+
+            /**
+             * This method returns arena memory planned for given variable, or nullptr if there's no suitable plan
+             */
+            void* plannedBuffer(std::pair<int,int> &pair, Nd4jLong numBytes);
         };
     }
 }
@@ -36,7 +36,7 @@ namespace nd4j {
             return std::pair<Nd4jLong, Nd4jLong>(pair->first(), pair->second());
         }
 
-        NDArray* FlatUtils::fromFlatArray(const nd4j::graph::FlatArray *flatArray) {
+        NDArray* FlatUtils::fromFlatArray(const nd4j::graph::FlatArray *flatArray, bool zeroCopy) {
             auto rank = static_cast<int>(flatArray->shape()->Get(0));
             auto newShape = new Nd4jLong[shape::shapeInfoLength(rank)];
             memcpy(newShape, flatArray->shape()->data(), shape::shapeInfoByteLength(rank));
@@ -94,6 +94,17 @@ namespace nd4j {
             }
 
 
+            if (zeroCopy) {
+                auto rawPtr = (void *)flatArray->buffer()->data();
+                bool isBe = BitwiseUtils::isBE();
+                bool sameOrder = (isBe && flatArray->byteOrder() == nd4j::graph::ByteOrder_BE) || (!isBe && flatArray->byteOrder() == nd4j::graph::ByteOrder_LE);
+                bool aligned = reinterpret_cast<uintptr_t>(rawPtr) % DataTypeUtils::sizeOf(dtype) == 0;
+
+                // buffer isn't owned by array, only shape is
+                if (sameOrder && aligned && flatArray->buffer()->size() >= length * DataTypeUtils::sizeOf(dtype))
+                    return new NDArray(rawPtr, newShape, nullptr, false, true);
+            }
+
             auto newBuffer = new int8_t[length * DataTypeUtils::sizeOf(dtype)];
 
             BUILD_SINGLE_SELECTOR(dtype, DataTypeConversions, ::convertType(newBuffer, (void *)flatArray->buffer()->data(), dtype, ByteOrderUtils::fromFlatByteOrder(flatArray->byteOrder()),  length), LIBND4J_TYPES);
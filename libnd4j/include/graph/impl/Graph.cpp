@@ -23,12 +23,20 @@
 #include <graph/FlatUtils.h>
 #include <NativeOps.h>
 #include <vector>
+#include <set>
+#include <algorithm>
 #include <helpers/ShapeUtils.h>
 #include <ops/declarable/OpRegistrator.h>
+#include <ops/declarable/LegacyFusedOp.h>
 #include <graph/VariableProxy.h>
 #include <graph/exceptions/graph_exception.h>
 #include <graph/exceptions/unresolved_input_exception.h>
 #include <graph/exceptions/unresolved_output_exception.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#else
+#include <helpers/mman.h>
+#endif
 
 namespace nd4j {
     namespace graph {
@@ -211,6 +219,24 @@ namespace nd4j {
             return result;
         }
 
+        MemoryPlan* Graph::memoryPlan(Nd4jLong signature) {
+            std::lock_guard<std::mutex> lock(_mutexPlans);
+
+            return _plans.count(signature) > 0 ? _plans.at(signature) : nullptr;
+        }
+
+        void Graph::registerMemoryPlan(Nd4jLong signature, MemoryPlan *plan) {
+            std::lock_guard<std::mutex> lock(_mutexPlans);
+
+            // plan for the same signature might be built concurrently, or we might be out of space
+            if (_plans.count(signature) > 0 || _plans.size() >= 16) {
+                delete plan;
+                return;
+            }
+
+            _plans[signature] = plan;
+        }
+
         void Graph::pushToOutputOnce(int id) {
             if (std::find(_output.begin(), _output.end(), id) == _output.end())
                 _output.emplace_back(id);
@@ -226,6 +252,10 @@ namespace nd4j {
         }
 
         std::vector<Variable *> * Graph::fetchOutputs() {
+            return fetchOutputs(_variableSpace);
+        }
+
+        std::vector<Variable *> * Graph::fetchOutputs(VariableSpace *variableSpace) {
             auto res = new std::vector<Variable *>();
 
             nd4j_debug("Graph output size: %i\n", _output.size());
@@ -234,8 +264,8 @@ namespace nd4j {
                 nd4j_debug("Output node: %i\n", nodeId);
 
                 for (int e = 0; e < DataTypeUtils::max<int>(); e++) {
-                    if (_variableSpace->hasVariable(nodeId, e)) {
-                        res->push_back(_variableSpace->getVariable(nodeId, e));
+                    if (variableSpace->hasVariable(nodeId, e)) {
+                        res->push_back(variableSpace->getVariable(nodeId, e));
                     } else {
                         if (e == 0) {
                             throw unresolved_output_exception::build("Can't find output variable", nodeId, e);
@@ -298,11 +328,27 @@ namespace nd4j {
             for (auto v: _scopes)
                 delete v;
 
+            for (auto &v: _plans)
+                delete v.second;
+
             delete _mapped;
             delete _nodes;
             delete _variableSpace;
             delete _onion;
             delete _configuration;
+
+            // variables might reference this memory, so it goes last
+            if (_mappedFile != nullptr)
+                munmap(_mappedFile, _mappedFileLength);
+        }
+
+        void Graph::attachMappedFile(void *ptr, Nd4jLong length) {
+            _mappedFile = ptr;
+            _mappedFileLength = length;
+        }
+
+        bool Graph::isMapped() {
+            return _mappedFile != nullptr;
         }
 
         void Graph::addNode(Node *node) {
@@ -762,8 +808,15 @@ namespace nd4j {
                         bool singleInput = true;
                         auto inputs = node->input();
                         for (auto &t: *inputs) {
-                            if (_mapped->count(t.first) == 0)
+                            if (_mapped->count(t.first) == 0) {
+                                // constants (including folded ones) are reused by subsequent runs, so they can't be overwritten
+                                if (_variableSpace->hasVariable(t) && _variableSpace->getVariable(t)->isConstant()) {
+                                    singleInput = false;
+                                    break;
+                                }
+
                                 continue;
+                            }
 
                             Node* inode = _mapped->at(t.first);
 
@@ -781,6 +834,311 @@ namespace nd4j {
             }
         }
 
+        /**
+         * This method removes given Nodes from onion layers and handles, and releases them. Nodes must be already unmapped
+         */
+        static void purgeOnion(std::map<int, std::vector<Node*>*> *onion, std::map<int, Node*> *mapped, std::vector<Node*> *handles, std::vector<int> &removed) {
+            if (removed.empty())
+                return;
+
+            for (auto &v: *onion) {
+                auto layer = v.second;
+                for (int e = (int) layer->size() - 1; e >= 0; e--) {
+                    auto node = layer->at(e);
+                    if (mapped->count(node->id()) > 0 || std::find(removed.begin(), removed.end(), node->id()) == removed.end())
+                        continue;
+
+                    layer->erase(layer->begin() + e);
+
+                    // getAllNodes() exposes handles, so released Node must not stay there
+                    handles->erase(std::remove(handles->begin(), handles->end(), node), handles->end());
+                    delete node;
+                }
+            }
+        }
+
+        /**
+         * This method tells if given Node is plain elementwise legacy op, which can become part of fused chain
+         */
+        static bool isFusableNode(Node *node) {
+            if (!node->hasCustomOp() || !node->isDeductable() || node->isScoped() || node->hasExternalOutputs() || !node->isActive())
+                return false;
+
+            if (!nd4j::ops::FusedStep::isFusable(node->opType()) || dynamic_cast<nd4j::ops::LegacyFusedOp*>(node->getCustomOp()) != nullptr)
+                return false;
+
+            auto block = node->getContextPrototype();
+            auto numInputs = node->input()->size();
+            switch (node->opType()) {
+                case OpType_SCALAR:
+                    return numInputs == 2 || (numInputs == 1 && (block->getTArguments()->size() > 0 || node->hasScalar()));
+                case OpType_PAIRWISE:
+                    return numInputs == 2;
+                case OpType_BROADCAST:
+                    return numInputs == 2 && block->getAxis()->size() > 0;
+                default:
+                    return numInputs == 1;
+            }
+        }
+
+        /**
+         * This method converts given Node into FusedStep, Y operand (if any) is appended to the inputs of fused op
+         */
+        static nd4j::ops::FusedStep fusedStep(Node *node, std::vector<std::pair<int, int>> &inputs) {
+            nd4j::ops::FusedStep step(node->opType(), (int) node->opNum());
+            auto block = node->getContextPrototype();
+            auto tArgs = block->getTArguments();
+
+            if (node->input()->size() > 1) {
+                step._operand = (int) inputs.size();
+                inputs.emplace_back(node->input()->at(1));
+            }
+
+            // scalar ops without Y operand take scalar from the first T argument, same as LegacyScalarOp
+            if (node->opType() == OpType_SCALAR && step._operand < 0) {
+                if (tArgs->size() > 0) {
+                    step._scalar = tArgs->at(0);
+                    step._extras.assign(tArgs->begin() + 1, tArgs->end());
+                } else
+                    step._scalar = node->scalar();
+            } else
+                step._extras = *tArgs;
+
+            if (node->opType() == OpType_BROADCAST)
+                step._dimensions = *block->getAxis();
+
+            return step;
+        }
+
+        void Graph::fuseElementwiseNodes() {
+            // just calling, in case it wasn't built before
+            if (!_built.load())
+                this->buildGraph();
+
+            // control flow relies on node positions within layers, so such graphs are left as is
+            if (!_scopes.empty())
+                return;
+
+            for (auto &v: *_mapped)
+                if (v.second->opType() == OpType_LOGIC || v.second->hasGraphEmbedded())
+                    return;
+
+            // number of uses of each node as input, and consumer of nodes that are used exactly once
+            std::map<int, int> references;
+            std::map<int, Node*> consumers;
+            for (auto &v: *_mapped)
+                for (auto &t: *v.second->input()) {
+                    references[t.first]++;
+                    consumers[t.first] = v.second;
+                }
+
+            std::vector<int> fused;
+            for (int l = 0; l < (int) _onion->size(); l++) {
+                if (_onion->count(l) == 0)
+                    continue;
+
+                for (auto node: *_onion->at(l)) {
+                    if (std::find(fused.begin(), fused.end(), node->id()) != fused.end() || !isFusableNode(node))
+                        continue;
+
+                    /**
+                     * Chain continues while current Node:
+                     * 1) isn't graph output
+                     * 2) has exactly one consumer, which is fusable, and uses current Node as its X operand
+                     */
+                    std::vector<Node*> chain({node});
+                    while (true) {
+                        auto last = chain.back();
+                        if (references[last->id()] != 1 || std::find(_output.begin(), _output.end(), last->id()) != _output.end())
+                            break;
+
+                        auto next = consumers[last->id()];
+                        if (!isFusableNode(next) || next->input()->at(0) != std::pair<int, int>(last->id(), 0))
+                            break;
+
+                        chain.emplace_back(next);
+                    }
+
+                    if (chain.size() < 2)
+                        continue;
+
+                    std::vector<std::pair<int, int>> inputs({chain.front()->input()->at(0)});
+                    std::vector<nd4j::ops::FusedStep> steps;
+                    for (auto n: chain)
+                        steps.emplace_back(fusedStep(n, inputs));
+
+                    // last Node of the chain keeps its id, so consumers and outputs remain intact
+                    auto tail = chain.back();
+                    tail->replaceOp(new nd4j::ops::LegacyFusedOp(steps, (int) inputs.size()), inputs);
+
+                    for (auto n: chain) {
+                        fused.emplace_back(n->id());
+                        if (n == tail)
+                            continue;
+
+                        nd4j_debug("Node_%i fused into Node_%i\n", n->id(), tail->id());
+                        _mapped->erase(n->id());
+                    }
+                }
+            }
+
+            // tails stay in their layers, since Y operands of the chain might be produced right before them
+            purgeOnion(_onion, _mapped, &_handles, fused);
+        }
+
+        /**
+         * This method tells if given Node has side effects or produces different results on each run, so it can't be folded
+         */
+        static bool isStatefulNode(Node *node) {
+            if (node->opType() == OpType_LOGIC || node->opType() == OpType_RANDOM || node->hasGraphEmbedded())
+                return true;
+
+            if (!node->hasCustomOp())
+                return false;
+
+            // declarable ops that consume or change RNG state, or update their inputs in place
+            static const std::set<Nd4jLong> stateful = [] {
+                std::vector<std::string> names({"set_seed", "get_seed", "randomuniform", "random_normal", "random_bernoulli",
+                                                "random_exponential", "random_crop", "random_shuffle", "dropout", "dropout_bp",
+                                                "alpha_dropout_bp", "skipgram", "cbow"});
+                std::set<Nd4jLong> hashes;
+                for (auto &name: names)
+                    hashes.insert(nd4j::ops::HashHelper::getInstance()->getLongHash(name));
+
+                return hashes;
+            }();
+
+            return stateful.count(node->getCustomOp()->getOpHash()) > 0;
+        }
+
+        std::vector<int> Graph::foldConstants() {
+            // just calling, in case it wasn't built before
+            if (!_built.load())
+                this->buildGraph();
+
+            std::vector<int> folded;
+
+            // control flow relies on node positions within layers, so such graphs are left as is
+            if (!_scopes.empty())
+                return folded;
+
+            for (auto &v: *_mapped)
+                if (v.second->opType() == OpType_LOGIC || v.second->hasGraphEmbedded())
+                    return folded;
+
+            for (int l = 0; l < (int) _onion->size(); l++) {
+                if (_onion->count(l) == 0)
+                    continue;
+
+                for (auto node: *_onion->at(l)) {
+                    if (!node->hasCustomOp() || node->isScoped() || node->hasExternalOutputs() || !node->isActive() || isStatefulNode(node))
+                        continue;
+
+                    auto inputs = node->input();
+                    bool constant = !inputs->empty();
+                    for (auto &in: *inputs) {
+                        // results of already folded Nodes are constants as well
+                        if (_mapped->count(in.first) > 0 || !_variableSpace->hasVariable(in)) {
+                            constant = false;
+                            break;
+                        }
+
+                        auto var = _variableSpace->getVariable(in);
+                        if (!var->isConstant() || var->isPlaceholder() || !var->hasNDArray()) {
+                            constant = false;
+                            break;
+                        }
+                    }
+
+                    if (!constant)
+                        continue;
+
+                    // constants must stay intact, so in-place execution isn't allowed here
+                    node->markInplace(false);
+
+                    Nd4jStatus status;
+                    try {
+                        Context context(node->getContextPrototype(), _variableSpace);
+                        status = node->getCustomOp()->execute(&context);
+                    } catch (std::exception &e) {
+                        status = ND4J_STATUS_BAD_INPUT;
+                    }
+
+                    // failed Node stays in Graph, so error will be reported during execution
+                    if (status != ND4J_STATUS_OK) {
+                        nd4j_debug("Node_%i can't be folded: status %i\n", node->id(), status);
+                        continue;
+                    }
+
+                    for (int e = 0; _variableSpace->hasVariable(node->id(), e); e++)
+                        _variableSpace->getVariable(node->id(), e)->markConstant(true);
+
+                    nd4j_debug("Node_%i folded into constant\n", node->id());
+                    folded.emplace_back(node->id());
+                    _mapped->erase(node->id());
+                }
+            }
+
+            purgeOnion(_onion, _mapped, &_handles, folded);
+
+            if (!folded.empty())
+                nd4j_verbose("Constant folding: %i node(s) folded\n", (int) folded.size());
+
+            return folded;
+        }
+
+        std::vector<int> Graph::pruneDeadNodes() {
+            // just calling, in case it wasn't built before
+            if (!_built.load())
+                this->buildGraph();
+
+            std::vector<int> pruned;
+
+            // without known outputs every Node is considered useful
+            if (_output.empty() || !_scopes.empty())
+                return pruned;
+
+            for (auto &v: *_mapped)
+                if (v.second->opType() == OpType_LOGIC)
+                    return pruned;
+
+            // Nodes writing into external variables are kept, since those variables are visible outside of Graph
+            std::vector<int> queue;
+            for (auto &v: *_mapped)
+                if (v.second->hasExternalOutputs() || std::find(_output.begin(), _output.end(), v.first) != _output.end())
+                    queue.emplace_back(v.first);
+
+            std::set<int> live(queue.begin(), queue.end());
+            while (!queue.empty()) {
+                auto id = queue.back();
+                queue.pop_back();
+
+                for (auto &in: *_mapped->at(id)->input()) {
+                    if (_mapped->count(in.first) == 0 || live.count(in.first) > 0)
+                        continue;
+
+                    live.insert(in.first);
+                    queue.emplace_back(in.first);
+                }
+            }
+
+            for (auto v: *_nodes) {
+                if (_mapped->count(v) == 0 || live.count(v) > 0)
+                    continue;
+
+                nd4j_debug("Node_%i doesn't contribute to outputs, removing\n", v);
+                pruned.emplace_back(v);
+                _mapped->erase(v);
+            }
+
+            purgeOnion(_onion, _mapped, &_handles, pruned);
+
+            if (!pruned.empty())
+                nd4j_verbose("Dead nodes elimination: %i node(s) removed\n", (int) pruned.size());
+
+            return pruned;
+        }
+
         void Graph::prepareOutputs() {
             // if we're dumping everything out there - we'll add external variables as well
             if (_configuration->_outputMode == OutputMode_VARIABLE_SPACE) {
@@ -864,7 +1222,7 @@ namespace nd4j {
             }
         }
 
-        Graph::Graph(const FlatGraph *flatGraph, VariableSpace *variableSpace) {
+        Graph::Graph(const FlatGraph *flatGraph, VariableSpace *variableSpace, bool zeroCopy) {
             this->_onion = new std::map<int, std::vector<Node *> *>();
             this->_mapped = new std::map<int, Node *> ();
             this->_nodes = new std::vector<int>();
@@ -891,7 +1249,7 @@ namespace nd4j {
                 for (unsigned int e = 0; e < flatGraph->variables()->size(); e++) {
                     auto flatVar = flatGraph->variables()->Get(e);
 
-                    auto var = new Variable(flatVar);
+                    auto var = new Variable(flatVar, zeroCopy);
                     std::pair<int, int> pair(flatVar->id()->first(), flatVar->id()->second());
                     _variableSpace->putVariable(pair, var);
 
@@ -953,8 +1311,15 @@ namespace nd4j {
              *  1) this is FeedForward pass ONLY
              *  2) OPTIMIZED mode is set, so no intermediate results are going to be used
              */
-            if (_configuration->_direction == Direction_FORWARD_ONLY && _configuration->_outputMode == OutputMode_OPTIMIZED)
+            if (_configuration->_direction == Direction_FORWARD_ONLY && _configuration->_outputMode == OutputMode_OPTIMIZED) {
+                this->foldConstants();
+                this->fuseElementwiseNodes();
                 this->tagInplaceNodes();
+            }
+
+            // only explicitly requested outputs are going to be fetched, so everything else can be dropped
+            if (_configuration->_direction == Direction_FORWARD_ONLY && _configuration->_outputMode == OutputMode_EXPLICIT)
+                this->pruneDeadNodes();
         }
 
 
@@ -1310,7 +1675,7 @@ namespace nd4j {
                 for (auto x: *(ovec)) {
                     auto n = x->clone();
                     vec->emplace_back(n);
-                    _handles.emplace_back(n);
+                    clone->_handles.emplace_back(n);
                     (*clone->_mapped)[n->id()] = n;
                 }
 
@@ -1327,6 +1692,36 @@ namespace nd4j {
             return clone;
         }
 
+        bool Graph::isShareable() {
+            if (!_built.load()) {
+                _mutexPreprocessing.lock();
+                if (!_built.load())
+                    this->buildGraph();
+                _mutexPreprocessing.unlock();
+            }
+
+            if (!_scopes.empty())
+                return false;
+
+            for (auto &v: *_mapped) {
+                auto node = v.second;
+
+                // logic ops are updating nodes state (frames, rewind positions) during execution
+                if (node->opType() == OpType_LOGIC || node->hasGraphEmbedded())
+                    return false;
+
+                // these nodes are writing directly to external variables
+                if (node->hasExternalOutputs())
+                    return false;
+
+                // inplace ops would overwrite shared arrays
+                if (node->isInplace() && node->hasExternalInputs())
+                    return false;
+            }
+
+            return true;
+        }
+
         Graph* Graph::clone() {
             auto clone = new Graph();
 
@@ -1361,7 +1756,7 @@ namespace nd4j {
                 for (auto x: *(ovec)) {
                     auto n = x->clone();
                     vec->emplace_back(n);
-                    _handles.emplace_back(n);
+                    clone->_handles.emplace_back(n);
                     (*clone->_mapped)[n->id()] = n;
                 }
 
@@ -22,9 +22,18 @@
 #include <GraphExecutioner.h>
 #include <graph/exceptions/graph_exists_exception.h>
 #include <graph/exceptions/graph_execution_exception.h>
+#include <thread>
 
 namespace nd4j {
     namespace graph {
+        GraphHolder::GraphHolder() {
+            _graphs = new GraphsMap();
+            _epoch = 0;
+
+            for (int e = 0; e < GRAPH_HOLDER_SLOTS * GRAPH_HOLDER_STRIDE; e++)
+                _readers[e] = 0;
+        }
+
         GraphHolder* GraphHolder::getInstance() {
             if (_INSTANCE == 0)
                 _INSTANCE = new GraphHolder();
@@ -32,60 +41,130 @@ namespace nd4j {
             return _INSTANCE;
         };
 
+        std::atomic<Nd4jLong>& GraphHolder::readerSlot() {
+            auto slot = std::hash<std::thread::id>()(std::this_thread::get_id()) % GRAPH_HOLDER_SLOTS;
+            return _readers[slot * GRAPH_HOLDER_STRIDE + _epoch.load()];
+        }
+
+        RegisteredGraph* GraphHolder::acquireGraph(Nd4jLong graphId) {
+            auto &slot = readerSlot();
+            slot++;
+
+            // snapshot can't be reclaimed while our counter is non-zero
+            RegisteredGraph* result = nullptr;
+            auto graphs = _graphs.load();
+            auto it = graphs->find(graphId);
+            if (it != graphs->end()) {
+                result = it->second;
+                result->retain();
+            }
+
+            slot--;
+
+            return result;
+        }
+
+        void GraphHolder::waitForReaders() {
+            // new readers go to the other counter after flip, so each counter of retired epoch only drains.
+            // reader which fetched epoch right before flip may still land into retired counter, so flip is done twice:
+            // such reader is caught by next grace period instead of outliving snapshot it was looking at
+            for (int p = 0; p < 2; p++) {
+                auto epoch = _epoch.load();
+                _epoch.store(epoch ^ 1);
+
+                for (int e = 0; e < GRAPH_HOLDER_SLOTS; e++)
+                    while (_readers[e * GRAPH_HOLDER_STRIDE + epoch].load() != 0)
+                        std::this_thread::yield();
+            }
+        }
+
+        void GraphHolder::publish(GraphsMap *graphs, RegisteredGraph *removed) {
+            auto old = _graphs.exchange(graphs);
+
+            // waiting for readers which could see previous snapshot. that's only lookup time, not execution time
+            waitForReaders();
+
+            delete old;
+
+            // in-flight requests still hold their references, so entry will die together with the last one of them
+            if (removed != nullptr)
+                removed->release();
+        }
+
         void GraphHolder::registerGraph(Nd4jLong graphId, Graph* graph) {
-            if (hasGraphAny(graphId))
-                throw graph_exists_exception(graphId);
+            auto entry = new RegisteredGraph(graph);
 
-            _graphF[graphId] = graph;
+            _mutexWrite.lock();
+            auto current = _graphs.load();
+            if (current->count(graphId) > 0) {
+                _mutexWrite.unlock();
+
+                // graph still belongs to caller
+                entry->forget();
+                entry->release();
+                throw graph_exists_exception(graphId);
+            }
 
-            nd4j::SimpleReadWriteLock lock;
-            _locks[graphId] = lock;
+            auto graphs = new GraphsMap(*current);
+            (*graphs)[graphId] = entry;
+            publish(graphs, nullptr);
+            _mutexWrite.unlock();
         }
 
         Graph* GraphHolder::cloneGraph(Nd4jLong graphId) {
-            if (!this->hasGraph(graphId)) {
+            auto entry = acquireGraph(graphId);
+            if (entry == nullptr) {
                 nd4j_printf("GraphHolder doesn't have graph stored for [%lld]\n", graphId);
                 throw std::runtime_error("Bad argument");
             }
 
-            auto graph = _graphF[graphId]->cloneWithProxy();
+            auto graph = entry->graph()->cloneWithProxy();
+            entry->release();
 
             return graph;
         }
 
         Graph* GraphHolder::pullGraph(Nd4jLong graphId) {
-            if (!this->hasGraph(graphId)) {
+            auto entry = acquireGraph(graphId);
+            if (entry == nullptr) {
                 nd4j_printf("GraphHolder doesn't have graph stored for [%lld]\n", graphId);
                 throw std::runtime_error("Bad argument");
             }
 
-            auto graph = _graphF[graphId];
+            auto graph = entry->graph();
+            entry->release();
 
             return graph;
         }
 
+        void GraphHolder::removeGraph(Nd4jLong graphId, bool forget) {
+            _mutexWrite.lock();
+            auto current = _graphs.load();
+            if (current->count(graphId) == 0) {
+                _mutexWrite.unlock();
+                return;
+            }
+
+            auto entry = current->at(graphId);
+            if (forget)
+                entry->forget();
+
+            auto graphs = new GraphsMap(*current);
+            graphs->erase(graphId);
+            publish(graphs, entry);
+            _mutexWrite.unlock();
+        }
+
         void GraphHolder::forgetGraph(Nd4jLong graphId) {
-            if (this->hasGraph(graphId))
-                _graphF.erase(graphId);
+            removeGraph(graphId, true);
         }
 
         void GraphHolder::dropGraph(Nd4jLong graphId) {
-            if (this->hasGraph(graphId)) {
-                auto g = _graphF[graphId];
-                forgetGraph(graphId);
-                delete g;
-            }
+            removeGraph(graphId, false);
         }
 
         void GraphHolder::dropGraphAny(Nd4jLong graphId) {
-            if (!hasGraphAny(graphId))
-                return;
-
-            this->lockWrite(graphId);
-
             this->dropGraph(graphId);
-
-            this->unlockWrite(graphId);
         }
 
         bool GraphHolder::hasGraphAny(Nd4jLong graphId) {
@@ -93,36 +172,65 @@ namespace nd4j {
         }
 
         bool GraphHolder::hasGraph(Nd4jLong graphId) {
-                return _graphF.count(graphId) > 0;
-        }
-
-        void GraphHolder::replaceGraph(Nd4jLong graphId, Graph* graph) {
-            if (!hasGraph(graphId)) {
-                registerGraph(graphId, graph);
-                return;
-            }
+            auto &slot = readerSlot();
+            slot++;
 
-            this->lockWrite(graphId);
+            bool result = _graphs.load()->count(graphId) > 0;
 
-            _graphF[graphId] = graph;
+            slot--;
 
-            this->unlockWrite(graphId);
+            return result;
         }
 
+        void GraphHolder::replaceGraph(Nd4jLong graphId, Graph* graph) {
+            auto entry = new RegisteredGraph(graph);
 
+            _mutexWrite.lock();
+            auto current = _graphs.load();
+            RegisteredGraph* removed = current->count(graphId) > 0 ? current->at(graphId) : nullptr;
 
+            auto graphs = new GraphsMap(*current);
+            (*graphs)[graphId] = entry;
+            publish(graphs, removed);
+            _mutexWrite.unlock();
+        }
 
         flatbuffers::Offset<FlatResult> GraphHolder::execute(Nd4jLong graphId, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request) {
-            if (!hasGraph(graphId))
+            // this reference keeps graph alive, even if it gets replaced or dropped in the middle of execution
+            auto entry = acquireGraph(graphId);
+            if (entry == nullptr)
                 throw unknown_graph_exception(graphId);
 
-            lockRead(graphId);
-
-            auto graph = cloneGraph(graphId);
-            auto res = GraphExecutioner::execute(graph, builder, request);
-            delete graph;
+            flatbuffers::Offset<FlatResult> res;
+            auto pool = entry->pool();
+            if (pool != nullptr) {
+                // graph is shared between requests, only VariableProxy is request-local
+                auto proxy = pool->acquire();
+
+                try {
+                    res = GraphExecutioner::execute(entry->graph(), builder, request, proxy);
+                } catch (...) {
+                    pool->release(proxy);
+                    entry->release();
+                    throw;
+                }
+
+                pool->release(proxy);
+            } else {
+                auto graph = entry->graph()->cloneWithProxy();
+
+                try {
+                    res = GraphExecutioner::execute(graph, builder, request);
+                } catch (...) {
+                    delete graph;
+                    entry->release();
+                    throw;
+                }
+
+                delete graph;
+            }
 
-            unlockRead(graphId);
+            entry->release();
 
             return res;
         }
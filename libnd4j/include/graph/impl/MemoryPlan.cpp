@@ -0,0 +1,215 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/MemoryPlan.h>
+#include <graph/Graph.h>
+#include <algorithm>
+#include <set>
+#include <vector>
+
+namespace nd4j {
+    namespace graph {
+        // single planned variable: lifetime is measured in layers, both bounds are inclusive
+        struct PlannedBuffer {
+            std::pair<int, int> pair;
+            Nd4jLong size;
+            Nd4jLong offset;
+            int first;
+            int last;
+        };
+
+        static FORCEINLINE Nd4jLong alignedSize(Nd4jLong size) {
+            return (size + MemoryPlan::ALIGNMENT - 1) / MemoryPlan::ALIGNMENT * MemoryPlan::ALIGNMENT;
+        }
+
+        void MemoryPlan::build(Graph *graph, const std::map<std::pair<int, int>, Nd4jLong> &sizes) {
+            _buffers.clear();
+            _arenaSize = 0L;
+            _totalSize = 0L;
+
+            if (!isPlannable(graph))
+                return;
+
+            // last layer each variable is consumed at
+            std::map<std::pair<int, int>, int> lastUse;
+
+            // variables that must keep their own memory
+            std::set<std::pair<int, int>> pinned;
+
+            for (auto &v: *graph->getOnion()) {
+                for (auto node: *v.second) {
+                    for (auto in: *node->input()) {
+                        if (in.first < 0)
+                            continue;
+
+                        // inplace node returns its input as output, so this memory can't be reused
+                        if (node->isInplace())
+                            pinned.insert(in);
+
+                        if (lastUse.count(in) == 0 || lastUse[in] < v.first)
+                            lastUse[in] = v.first;
+                    }
+                }
+            }
+
+            std::vector<PlannedBuffer> buffers;
+            for (auto &v: sizes) {
+                auto pair = v.first;
+                if (v.second <= 0 || graph->getMapped()->count(pair.first) == 0)
+                    continue;
+
+                auto node = graph->getMapped()->at(pair.first);
+
+                // graph outputs outlive execution, and leaves without consumers are implicit outputs
+                if (node->isInplace() || node->hasExternalOutputs() || pinned.count(pair) > 0 || lastUse.count(pair) == 0)
+                    continue;
+
+                if (std::find(graph->output()->begin(), graph->output()->end(), pair.first) != graph->output()->end())
+                    continue;
+
+                PlannedBuffer buffer;
+                buffer.pair = pair;
+                buffer.size = alignedSize(v.second);
+                buffer.offset = 0L;
+                buffer.first = node->getLayer();
+                buffer.last = lastUse[pair];
+
+                buffers.emplace_back(buffer);
+            }
+
+            // greedy by size: largest buffers are placed first, each one at lowest offset not clashing with buffers alive at the same time
+            std::sort(buffers.begin(), buffers.end(), [](const PlannedBuffer &a, const PlannedBuffer &b) {
+                if (a.size != b.size)
+                    return a.size > b.size;
+
+                return a.first < b.first;
+            });
+
+            std::vector<PlannedBuffer*> placed;
+            for (auto &buffer: buffers) {
+                std::vector<PlannedBuffer*> clashing;
+                for (auto p: placed)
+                    if (p->first <= buffer.last && buffer.first <= p->last)
+                        clashing.emplace_back(p);
+
+                std::sort(clashing.begin(), clashing.end(), [](const PlannedBuffer *a, const PlannedBuffer *b) {
+                    return a->offset < b->offset;
+                });
+
+                Nd4jLong offset = 0L;
+                for (auto p: clashing) {
+                    if (offset + buffer.size <= p->offset)
+                        break;
+
+                    offset = nd4j::math::nd4j_max<Nd4jLong>(offset, p->offset + p->size);
+                }
+
+                buffer.offset = offset;
+                placed.emplace_back(&buffer);
+
+                _buffers[buffer.pair] = std::pair<Nd4jLong, Nd4jLong>(offset, buffer.size);
+                _arenaSize = nd4j::math::nd4j_max<Nd4jLong>(_arenaSize, offset + buffer.size);
+                _totalSize += buffer.size;
+            }
+
+            nd4j_debug("Memory plan: %i variables, %lld bytes arena vs %lld bytes total\n", (int) _buffers.size(), _arenaSize, _totalSize);
+        }
+
+        bool MemoryPlan::hasBuffer(const std::pair<int, int> &pair) const {
+            return _buffers.count(pair) > 0;
+        }
+
+        Nd4jLong MemoryPlan::offset(const std::pair<int, int> &pair) const {
+            return _buffers.at(pair).first;
+        }
+
+        Nd4jLong MemoryPlan::size(const std::pair<int, int> &pair) const {
+            return _buffers.at(pair).second;
+        }
+
+        int MemoryPlan::numberOfBuffers() const {
+            return (int) _buffers.size();
+        }
+
+        Nd4jLong MemoryPlan::arenaSize() const {
+            return _arenaSize;
+        }
+
+        Nd4jLong MemoryPlan::totalSize() const {
+            return _totalSize;
+        }
+
+        bool MemoryPlan::isPlannable(Graph *graph) {
+            // all variables are considered outputs in this mode
+            if (graph->getExecutorConfiguration()->_outputMode == OutputMode_VARIABLE_SPACE)
+                return false;
+
+            // loops rewind execution, so lifetimes can't be derived from layers
+            if (!graph->scopes()->empty())
+                return false;
+
+            for (auto &v: *graph->getMapped()) {
+                auto node = v.second;
+                if (node->opType() == OpType_LOGIC || node->hasGraphEmbedded())
+                    return false;
+            }
+
+            return true;
+        }
+
+        Nd4jLong MemoryPlan::signature(Graph *graph, VariableSpace *variableSpace) {
+            Nd4jLong hash = 17L;
+
+            for (auto &v: *graph->getMapped()) {
+                for (auto in: *v.second->input()) {
+                    if (in.first >= 0)
+                        continue;
+
+                    if (!variableSpace->hasVariable(in))
+                        return 0L;
+
+                    auto var = variableSpace->getVariable(in);
+                    if (!var->hasNDArray())
+                        return 0L;
+
+                    auto shapeInfo = var->getNDArray()->getShapeInfo();
+                    hash = hash * 31 + in.first;
+                    for (int e = 0; e < shape::shapeInfoLength(shapeInfo); e++)
+                        hash = hash * 31 + shapeInfo[e];
+                }
+            }
+
+            return hash == 0L ? 1L : hash;
+        }
+
+        std::map<std::pair<int, int>, Nd4jLong> MemoryPlan::footprint(Graph *graph, VariableSpace *variableSpace) {
+            std::map<std::pair<int, int>, Nd4jLong> result;
+
+            for (auto &v: *graph->getMapped()) {
+                for (int e = 0; variableSpace->hasVariable(v.first, e); e++) {
+                    auto var = variableSpace->getVariable(v.first, e);
+                    if (!var->hasNDArray() || var->getNDArray()->isEmpty())
+                        continue;
+
+                    auto array = var->getNDArray();
+                    result[std::pair<int, int>(v.first, e)] = array->lengthOf() * array->sizeOfT();
+                }
+            }
+
+            return result;
+        }
+    }
+}
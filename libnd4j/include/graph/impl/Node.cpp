@@ -143,6 +143,36 @@ namespace nd4j {
                 _isInplace = true;
         }
 
+        void nd4j::graph::Node::replaceOp(nd4j::ops::DeclarableOp *customOp, const std::vector<std::pair<int,int>> &inputs) {
+            if (_isDeductable && _customOp != nullptr && _customOp != customOp)
+                delete _customOp;
+
+            _customOp = customOp;
+            _isDeductable = true;
+
+            _input.clear();
+            _hasExternalInputs = false;
+            _hasInternalInputs = false;
+            for (auto &p: inputs) {
+                _input.emplace_back(p);
+
+                if (p.first < 0)
+                    _hasExternalInputs = true;
+                else
+                    _hasInternalInputs = true;
+            }
+
+            if (_protoContext != nullptr) {
+                _protoContext->inputs()->clear();
+                for (auto &p: _input)
+                    _protoContext->inputs()->emplace_back(p);
+
+                _protoContext->setOpDescriptor(customOp->getOpDescriptor());
+            }
+
+            markInplace(false);
+        }
+
         bool nd4j::graph::Node::hasCustomOp() {
             return _customOp != nullptr;
         }
@@ -167,6 +197,10 @@ namespace nd4j {
             return  _scalar.e<double>(0);
         };
 
+        bool nd4j::graph::Node::hasScalar() {
+            return _scalar.nonNull() && _scalar.lengthOf() == 1;
+        }
+
         void nd4j::graph::Node::pickInput(std::pair<int,int>& pair) {
             _input.push_back(pair);
         }
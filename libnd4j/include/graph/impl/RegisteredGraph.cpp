@@ -0,0 +1,60 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include <graph/RegisteredGraph.h>
+
+namespace nd4j {
+    namespace graph {
+        RegisteredGraph::RegisteredGraph(Graph *graph) {
+            _graph = graph;
+            _references = 1;
+            _owner = true;
+
+            // graphs that can't be shared will be cloned for each request
+            if (graph->isShareable())
+                _pool = new VariableProxyPool(graph);
+        }
+
+        RegisteredGraph::~RegisteredGraph() {
+            delete _pool;
+
+            if (_owner.load())
+                delete _graph;
+        }
+
+        Graph* RegisteredGraph::graph() {
+            return _graph;
+        }
+
+        VariableProxyPool* RegisteredGraph::pool() {
+            return _pool;
+        }
+
+        void RegisteredGraph::retain() {
+            _references++;
+        }
+
+        void RegisteredGraph::release() {
+            if (--_references == 0)
+                delete this;
+        }
+
+        void RegisteredGraph::forget() {
+            _owner = false;
+        }
+    }
+}
@@ -36,6 +36,7 @@ namespace nd4j {
             result->markExternal(this->_external);
             result->setId(this->_id);
             result->markReadOnly(this->_readOnly);
+            result->markConstant(this->_constant);
             result->setName(&this->_name);
             result->setIndex(this->_index);
 
@@ -57,6 +58,7 @@ namespace nd4j {
             result->_external = this->_external;
             result->_id = this->_id;
             result->_readOnly = this->_readOnly;
+            result->_constant = this->_constant;
             result->_name = this->_name;
             result->_index = this->_index;
 
@@ -89,6 +91,10 @@ namespace nd4j {
             return _placeholder;
         }
 
+        bool nd4j::graph::Variable::isConstant() {
+            return _constant;
+        }
+
         std::string * nd4j::graph::Variable::getName() {
             return &_name;
         }
@@ -136,6 +142,10 @@ namespace nd4j {
             this->_removable = reallyRemovable;
         }
 
+        void nd4j::graph::Variable::markConstant(bool reallyConstant) {
+            this->_constant = reallyConstant;
+        }
+
         void nd4j::graph::Variable::markReadOnly(bool reallyReadOnly) {
             this->_readOnly = reallyReadOnly;
         }
@@ -189,7 +199,7 @@ namespace nd4j {
         }
 
         
-        nd4j::graph::Variable::Variable(const nd4j::graph::FlatVariable *flatVariable) {
+        nd4j::graph::Variable::Variable(const nd4j::graph::FlatVariable *flatVariable, bool zeroCopy) {
             auto vid = flatVariable->id();
             this->_id = vid->first();
             this->_index = vid->second();
@@ -208,8 +218,9 @@ namespace nd4j {
                         // ?????
                         if (flatVariable->ndarray() != nullptr) {
                             auto ar = flatVariable->ndarray();
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
-                            _ndarray->triggerAllocationFlag(true, true);
+                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar, zeroCopy);
+                            if (!zeroCopy)
+                                _ndarray->triggerAllocationFlag(true, true);
                         }
 
                         _variableType = VariableType::NDARRAY;
@@ -222,12 +233,16 @@ namespace nd4j {
                         auto ar = flatVariable->ndarray();
                         if (ar->dtype() == DataType_UTF8) {
                             _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
+                            _ndarray->triggerAllocationFlag(true, true);
                         } else {
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
+                            // with zeroCopy fromFlatArray sets allocation flags itself
+                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar, zeroCopy);
+                            if (!zeroCopy)
+                                _ndarray->triggerAllocationFlag(true, true);
                         }
-                        _ndarray->triggerAllocationFlag(true, true);
 
                         _variableType = VariableType::NDARRAY;
+                        _constant = true;
                     }
                     break;
                 case VarType_ARRAY: {
@@ -37,6 +37,42 @@ namespace nd4j {
             delete _current;
         }
 
+
+        Variable* VariableProxy::shadowVariable(Variable *variable) {
+            // variables holding actual values are shared as is
+            if (variable->hasNDArray() || variable->hasNDArrayList())
+                return variable;
+
+            // empty variable will receive op results, so we keep proxy-local copy of it
+            std::pair<int, int> pair(variable->id(), variable->index());
+
+            // nodes might be executed concurrently, so only one shadow is created per variable
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
+            if (_current->hasVariable(pair))
+                return _current->getVariable(pair);
+
+            auto shadow = new Variable(nullptr, nullptr, variable->id(), variable->index());
+            shadow->setName(variable->getName());
+            shadow->setVariableType(variable->variableType());
+            shadow->markExternal(variable->isExternal());
+            shadow->markReadOnly(variable->isReadOnly());
+            shadow->markRemovable(variable->isRemovable());
+
+            _current->putVariable(pair, shadow);
+
+            return shadow;
+        }
+
+
+        void VariableProxy::reset() {
+            delete _current;
+            _current = new VariableSpace();
+
+            // all arrays allocated within previous round are gone now, so workspace can be reused
+            _workspace.scopeOut();
+            _workspace.scopeIn();
+        }
+
         
         int VariableProxy::numberOfPlaceholders() {
             return _backed->numberOfPlaceholders();
@@ -126,7 +162,7 @@ namespace nd4j {
                 return _current->getVariable(id);
             
             if (_backed->hasVariable(id))
-                return _backed->getVariable(id);
+                return shadowVariable(_backed->getVariable(id));
 
             nd4j_printf("Unable to get Variable to proxy: [%i]\n", id);
             throw std::runtime_error("Bad arguments");
@@ -138,7 +174,7 @@ namespace nd4j {
                 return _current->getVariable(id, idx);
             
             if (_backed->hasVariable(id, idx))
-                return _backed->getVariable(id, idx);
+                return shadowVariable(_backed->getVariable(id, idx));
 
             nd4j_printf("Unable to get Variable to proxy: [%i:%i]\n", id, idx);
             throw std::runtime_error("Bad arguments");
@@ -150,7 +186,7 @@ namespace nd4j {
                 return _current->getVariable(pair);
             
             if (_backed->hasVariable(pair))
-                return _backed->getVariable(pair);
+                return shadowVariable(_backed->getVariable(pair));
 
             nd4j_printf("Unable to get Variable to proxy: [%i:%i]\n", pair.first, pair.second);
             throw std::runtime_error("Bad arguments");
@@ -162,7 +198,7 @@ namespace nd4j {
                 return _current->getVariable(symbol);
             
             if (_backed->hasVariable(symbol))
-                return _backed->getVariable(symbol);
+                return shadowVariable(_backed->getVariable(symbol));
 
             nd4j_printf("Unable to get Variable to proxy: [%s]\n", symbol->c_str());
             throw std::runtime_error("Bad arguments");
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include <graph/VariableProxyPool.h>
+
+namespace nd4j {
+    namespace graph {
+        VariableProxyPool::VariableProxyPool(Graph *graph, int limit) {
+            _graph = graph;
+            _limit = limit;
+            _active = 0;
+        }
+
+        VariableProxyPool::~VariableProxyPool() {
+            for (auto v: _pool)
+                delete v;
+        }
+
+        VariableProxy* VariableProxyPool::acquire() {
+            VariableProxy* proxy = nullptr;
+
+            _mutex.lock();
+            if (!_pool.empty()) {
+                proxy = _pool.back();
+                _pool.pop_back();
+            }
+            _mutex.unlock();
+
+            // intermediate arrays aren't visible outside of pooled execution, so they can share memory
+            if (proxy == nullptr) {
+                proxy = new VariableProxy(_graph->getVariableSpace());
+                proxy->enableMemoryPlanning(true);
+            }
+
+            _active++;
+
+            return proxy;
+        }
+
+        void VariableProxyPool::release(VariableProxy *proxy) {
+            _active--;
+
+            // dropping everything produced during last round
+            proxy->reset();
+
+            _mutex.lock();
+            if ((int) _pool.size() < _limit) {
+                _pool.emplace_back(proxy);
+                proxy = nullptr;
+            }
+            _mutex.unlock();
+
+            // pool is full already
+            delete proxy;
+        }
+
+        int VariableProxyPool::size() {
+            _mutex.lock();
+            int size = (int) _pool.size();
+            _mutex.unlock();
+
+            return size;
+        }
+
+        int VariableProxyPool::active() {
+            return _active.load();
+        }
+
+        Graph* VariableProxyPool::graph() {
+            return _graph;
+        }
+    }
+}
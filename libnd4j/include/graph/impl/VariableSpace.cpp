@@ -90,10 +90,12 @@ namespace nd4j {
         }
 
         bool nd4j::graph::VariableSpace::hasVariable(std::string *symbol) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
             return _symbolic.count(*symbol) == 1;
         }
 
         nd4j::graph::Variable * nd4j::graph::VariableSpace::getVariable(std::string *symbol) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
             return _symbolic.at(*symbol);
         }
 
@@ -132,6 +134,7 @@ namespace nd4j {
         }
 
         nd4j::graph::Variable * nd4j::graph::VariableSpace::getVariable(std::pair<int, int>& pair) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
 //            if (pair.first == 0)
 //                throw "0 requested";
 
@@ -152,10 +155,12 @@ namespace nd4j {
         }
 
         bool nd4j::graph::VariableSpace::hasVariable(int id) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
             return _variables.count(id) == 1 || _temporary.count(id) == 1;
         }
 
         bool nd4j::graph::VariableSpace::hasVariable(std::pair<int,int>& id) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
             return _paired.count(id) > 0;
         }
 
@@ -235,6 +240,7 @@ namespace nd4j {
         }
 
         void nd4j::graph::VariableSpace::putVariable(std::pair<int,int>& pair, Variable *variable) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
             silentPutVariable(pair, variable);
 
             if (variable->isPlaceholder())
@@ -261,6 +267,7 @@ namespace nd4j {
         }
 
         void nd4j::graph::VariableSpace::putVariable(int id, Variable *variable) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
             // we don't want to add variables more then once
             if (_variables.count(id) > 0 || _temporary.count(id) > 0) {
                 // nd4j_verbose("Trying to update variable for node_%i\n", id);
@@ -320,6 +327,7 @@ namespace nd4j {
         }
 
         nd4j::graph::Variable * nd4j::graph::VariableSpace::getVariable(int id) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
 //            _varmap.lock();
 
             if (id < 0) {
@@ -369,6 +377,8 @@ namespace nd4j {
                 NativeOps nativeOps;
                 nativeOps.destroyRandom(_rng);
             }
+
+            delete[] _arena;
         }
 
         VariableSpace& VariableSpace::operator=(const VariableSpace& other) {
@@ -452,6 +462,41 @@ namespace nd4j {
             return _flow;
         }
 
+        void VariableSpace::enableMemoryPlanning(bool reallyEnable) {
+            _planning = reallyEnable;
+        }
+
+        bool VariableSpace::isMemoryPlanningEnabled() {
+            return _planning;
+        }
+
+        void VariableSpace::setMemoryPlan(MemoryPlan *plan) {
+            _plan = plan;
+
+            if (plan == nullptr || plan->arenaSize() <= _arenaSize)
+                return;
+
+            // all arrays from previous rounds are released by now, so arena can be replaced
+            delete[] _arena;
+            _arenaSize = plan->arenaSize();
+            _arena = new int8_t[_arenaSize + MemoryPlan::ALIGNMENT];
+        }
+
+        MemoryPlan* VariableSpace::memoryPlan() {
+            return _plan;
+        }
+
+        void* VariableSpace::plannedBuffer(std::pair<int,int> &pair, Nd4jLong numBytes) {
+            if (_plan == nullptr || numBytes <= 0 || !_plan->hasBuffer(pair) || _plan->size(pair) < numBytes)
+                return nullptr;
+
+            // offsets are aligned within arena, so arena base has to be aligned as well
+            auto base = reinterpret_cast<Nd4jLong>(_arena);
+            base = (base + MemoryPlan::ALIGNMENT - 1) / MemoryPlan::ALIGNMENT * MemoryPlan::ALIGNMENT;
+
+            return reinterpret_cast<int8_t *>(base) + _plan->offset(pair);
+        }
+
         VariableSpace::VariableSpace() {
             _handles = new std::vector<Variable *>;
         }
@@ -29,6 +29,15 @@ namespace nd4j {
     public:
         static nd4j::NDArray* multiHeadProject(const nd4j::NDArray* input, const nd4j::NDArray* projectionMatrix, nd4j::memory::Workspace* workspace = nullptr);
         static void multiHeadProjectBp(const nd4j::NDArray* input, const nd4j::NDArray* projectionMatrix, const nd4j::NDArray* eps, nd4j::NDArray* dLdInput, nd4j::NDArray* dLdProjectionMatrix, nd4j::memory::Workspace* workspace = nullptr);
+
+        /**
+        *  fused scaled dot-product attention for queries [bS, (nH,) dK, Tq], keys [bS, (nH,) dK, Tk], values [bS, (nH,) dV, Tk]
+        *  softmax over keys is evaluated online in blocks, so the [Tk x Tq] attention weights are never materialized
+        */
+        static bool canFuseAttention(const std::vector<const nd4j::NDArray*>& arrays);
+        static void dotProductAttention(const nd4j::NDArray* queries, const nd4j::NDArray* keys, const nd4j::NDArray* values, const nd4j::NDArray* mask, const bool normalization, nd4j::NDArray* output);
+        static void dotProductAttentionBp(const nd4j::NDArray* queries, const nd4j::NDArray* keys, const nd4j::NDArray* values, const nd4j::NDArray* eps, const nd4j::NDArray* mask, const bool normalization,
+                                          nd4j::NDArray* dLdq, nd4j::NDArray* dLdk, nd4j::NDArray* dLdv);
     };
 }
 
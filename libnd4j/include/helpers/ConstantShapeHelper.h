@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef DEV_TESTS_CONSTANTSHAPEHELPER_H
+#define DEV_TESTS_CONSTANTSHAPEHELPER_H
+
+#include <dll.h>
+#include <pointercast.h>
+#include <mutex>
+#include <atomic>
+
+#ifndef SHAPE_CACHE_BUCKETS
+#define SHAPE_CACHE_BUCKETS 1024
+#endif
+
+// max number of shapes interned via tryCreateFromExisting()
+#ifndef SHAPE_CACHE_LIMIT
+#define SHAPE_CACHE_LIMIT 65536
+#endif
+
+namespace nd4j {
+    /**
+     * This class holds interned shapeInfo buffers: identical shapes share single immutable buffer,
+     * so such buffers can be compared by pointer. Returned buffers are never released, and must never be modified.
+     * Arbitrary shapes (i.e. sub-arrays) are interned only until cache reaches its limit (SHAPE_CACHE_LIMIT entries by default).
+     *
+     * PLEASE NOTE: entries can't be evicted, since arrays reference interned buffers without owning them. So once process
+     * has seen that many distinct shapes, new sub-array shapes aren't interned anymore for the rest of its life: such views
+     * get own copy of shapeInfo, same as they did before interning existed.
+     */
+    class ND4J_EXPORT ConstantShapeHelper {
+    private:
+        struct CacheEntry {
+            Nd4jLong hash;
+            Nd4jLong *shapeInfo;
+            CacheEntry *next;
+
+            CacheEntry(Nd4jLong h, Nd4jLong *s, CacheEntry *n) : hash(h), shapeInfo(s), next(n) { };
+        };
+
+        struct CacheBucket {
+            std::atomic<CacheEntry*> head;
+            std::mutex mutex;
+
+            CacheBucket() : head(nullptr) { };
+        };
+
+        static ConstantShapeHelper *_INSTANCE;
+
+        CacheBucket _buckets[SHAPE_CACHE_BUCKETS];
+
+        std::atomic<Nd4jLong> _hits;
+        std::atomic<Nd4jLong> _misses;
+        std::atomic<Nd4jLong> _size;
+        const Nd4jLong _limit;
+
+        static Nd4jLong hashOf(const Nd4jLong *shapeInfo);
+        static CacheEntry* lookup(CacheEntry *head, Nd4jLong hash, const Nd4jLong *shapeInfo);
+
+        Nd4jLong* intern(const Nd4jLong *shapeInfo, bool bounded);
+    public:
+        /**
+         * Separate instances are meant for tests only, everything else must use getInstance().
+         * Buffers interned by such instance are released together with it
+         */
+        explicit ConstantShapeHelper(Nd4jLong limit = SHAPE_CACHE_LIMIT);
+        ~ConstantShapeHelper();
+
+        static ConstantShapeHelper* getInstance();
+
+        /**
+         * This method returns interned copy of given shapeInfo. Given buffer isn't referenced after this call.
+         * Meant for shapes which are kept forever anyway, i.e. TAD shapes
+         */
+        Nd4jLong* createFromExisting(const Nd4jLong *shapeInfo);
+
+        /**
+         * This method returns interned copy of given shapeInfo, or nullptr if it's not cached yet and cache is already full
+         */
+        Nd4jLong* tryCreateFromExisting(const Nd4jLong *shapeInfo);
+
+        Nd4jLong cacheHits();
+        Nd4jLong cacheMisses();
+        Nd4jLong cacheSize();
+        Nd4jLong cacheLimit();
+    };
+}
+
+#endif //DEV_TESTS_CONSTANTSHAPEHELPER_H
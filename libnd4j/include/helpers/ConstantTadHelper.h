@@ -27,20 +27,51 @@
 #include <map>
 #include <vector>
 #include <mutex>
+#include <atomic>
 #include <array/ShapeDescriptor.h>
 #include <array/TadDescriptor.h>
 #include <array/DataBuffer.h>
 #include <array/TadPack.h>
 
+#ifndef TAD_CACHE_BUCKETS
+#define TAD_CACHE_BUCKETS 256
+#endif
+
 namespace nd4j {
     class ND4J_EXPORT ConstantTadHelper {
     private:
+        /**
+         * Cache entries are immutable and never released, so TadPack references stay valid forever
+         */
+        struct CacheEntry {
+            Nd4jLong hash;
+            TadDescriptor descriptor;
+            TadPack pack;
+            CacheEntry *next;
+
+            CacheEntry(Nd4jLong h, TadDescriptor &d, TadPack &p, CacheEntry *n) : hash(h), descriptor(d), pack(p), next(n) { };
+        };
+
+        /**
+         * Lookups walk the chain without locking, mutex serializes insertions into this bucket only
+         */
+        struct CacheBucket {
+            std::atomic<CacheEntry*> head;
+            std::mutex mutex;
+
+            CacheBucket() : head(nullptr) { };
+        };
+
         static ConstantTadHelper *_INSTANCE;
 
-        std::mutex _mutex;
-        std::vector<std::map<TadDescriptor, TadPack>> _cache;
+        CacheBucket _buckets[TAD_CACHE_BUCKETS];
+
+        std::atomic<Nd4jLong> _hits;
+        std::atomic<Nd4jLong> _misses;
 
         ConstantTadHelper();
+
+        static CacheEntry* lookup(CacheEntry *head, Nd4jLong hash, TadDescriptor &descriptor);
     public:
         ~ConstantTadHelper() = default;
 
@@ -51,6 +82,12 @@ namespace nd4j {
         TadPack& tadForDimensions(Nd4jLong *originalShape, int dimensions, const bool keepUnitiesInShape = false);
         TadPack& tadForDimensions(ShapeDescriptor &descriptor, std::vector<int> &dimensions, const bool keepUnitiesInShape = false);
         TadPack& tadForDimensions(TadDescriptor &descriptor);
+
+        /**
+         * These methods return cache statistics: number of lookups served from cache, and number of TadPacks built (i.e. cache size)
+         */
+        Nd4jLong cacheHits();
+        Nd4jLong cacheMisses();
     };
 }
 
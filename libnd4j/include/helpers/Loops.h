@@ -30,7 +30,16 @@
 #include <ops.h>
 #include <indexreduce.h>
 #include <helpers/ConstantTadHelper.h>
+#include <helpers/ThreadPool.h>
 #include <openmp_pragmas.h>
+#include <Environment.h>
+#include <memory>
+
+// minimal number of elements reduced by one thread when TAD is split into blocks, also block length in deterministic mode
+#define REDUCE_BLOCK_LENGTH 8192
+
+// number of independent accumulators used by inner reduction loops, power of 2
+#define REDUCE_ACCUMULATORS 4
 
 namespace nd4j {
 
@@ -41,6 +50,30 @@ namespace nd4j {
 
         template <typename OpType>
         static FORCEINLINE void loopReduce(X* x, Nd4jLong* xShapeInfo, Z* z, Nd4jLong* zShapeInfo, Nd4jLong* tadShapeInfo, Nd4jLong* tadOffsets, E* extraParams);
+
+        /**
+         * reduces whole array, same as single TAD spanning all of it. Result isn't post-processed
+         */
+        template <typename OpType>
+        static FORCEINLINE E loopReduceWhole(X* x, Nd4jLong* xShapeInfo, E* extraParams);
+
+        /**
+         * returns number of blocks each TAD should be split into, 1 means TADs are reduced by one thread each
+         */
+        static FORCEINLINE Nd4jLong splitBlocks(Nd4jLong tadLen, Nd4jLong numTads);
+
+        /**
+         * reduces numTads TADs, each split into numBlocks blocks reduced in parallel.
+         * Partials of every TAD are combined by pairwise tree in fixed order, results go to acc before postProcess
+         */
+        template <typename OpType>
+        static FORCEINLINE void splitReduce(X* x, Nd4jLong* tadShapeInfo, Nd4jLong* tadOffsets, Nd4jLong numTads, Nd4jLong numBlocks, E* acc, E* extraParams);
+
+        /**
+         * reduces elements [start, stop) of TAD, addressed either with ews or with offsets if they're not nullptr
+         */
+        template <typename OpType>
+        static FORCEINLINE E blockReduce(X* tad, Nd4jLong start, Nd4jLong stop, Nd4jLong ews, Nd4jLong* offsets, E* extraParams);
     };
 
     template <typename X, typename Z>
@@ -259,6 +292,114 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
 
 
 
+//////////////////////////////////////////////////////////////////////////////
+    template<typename X, typename Z, typename E>
+    template <typename OpType>
+    E nd4j::ReductionLoops<X, Z, E>::blockReduce(X* tad, Nd4jLong start, Nd4jLong stop, Nd4jLong ews, Nd4jLong* offsets, E* extraParams) {
+
+        // independent accumulators break dependency chain of update(), so iterations can be vectorized
+        E acc[REDUCE_ACCUMULATORS];
+        for (int e = 0; e < REDUCE_ACCUMULATORS; e++)
+            acc[e] = static_cast<E>(OpType::startingValue(tad));
+
+        auto j = start;
+        if (offsets == nullptr) {
+            for (; j + REDUCE_ACCUMULATORS <= stop; j += REDUCE_ACCUMULATORS)
+                for (int e = 0; e < REDUCE_ACCUMULATORS; e++)
+                    acc[e] = OpType::update(acc[e], OpType::op(tad[(j + e) * ews], extraParams), extraParams);
+
+            for (; j < stop; j++)
+                acc[0] = OpType::update(acc[0], OpType::op(tad[j * ews], extraParams), extraParams);
+        }
+        else {
+            for (; j + REDUCE_ACCUMULATORS <= stop; j += REDUCE_ACCUMULATORS)
+                for (int e = 0; e < REDUCE_ACCUMULATORS; e++)
+                    acc[e] = OpType::update(acc[e], OpType::op(tad[offsets[j + e]], extraParams), extraParams);
+
+            for (; j < stop; j++)
+                acc[0] = OpType::update(acc[0], OpType::op(tad[offsets[j]], extraParams), extraParams);
+        }
+
+        for (int e = REDUCE_ACCUMULATORS / 2; e > 0; e /= 2)
+            for (int k = 0; k < e; k++)
+                acc[k] = OpType::update(acc[k], acc[k + e], extraParams);
+
+        return acc[0];
+    }
+
+//////////////////////////////////////////////////////////////////////////////
+    template<typename X, typename Z, typename E>
+    Nd4jLong nd4j::ReductionLoops<X, Z, E>::splitBlocks(Nd4jLong tadLen, Nd4jLong numTads) {
+
+        // blocks depend on TAD length only, so results are the same for any number of threads
+        if (Environment::getInstance()->isDeterministic())
+            return tadLen >= 2 * REDUCE_BLOCK_LENGTH ? (tadLen + REDUCE_BLOCK_LENGTH - 1) / REDUCE_BLOCK_LENGTH : 1;
+
+        // there're enough TADs to keep all threads busy
+        const int numThreads = ThreadPool::getInstance()->effectiveThreads(tadLen * numTads, REDUCE_BLOCK_LENGTH);
+        if (numTads < 1 || numTads >= numThreads)
+            return 1;
+
+        auto numBlocks = (numThreads + numTads - 1) / numTads;
+        if (numBlocks > tadLen / REDUCE_BLOCK_LENGTH)
+            numBlocks = tadLen / REDUCE_BLOCK_LENGTH;
+
+        return numBlocks > 1 ? numBlocks : 1;
+    }
+
+//////////////////////////////////////////////////////////////////////////////
+    template<typename X, typename Z, typename E>
+    template <typename OpType>
+    void nd4j::ReductionLoops<X, Z, E>::splitReduce(X* x, Nd4jLong* tadShapeInfo, Nd4jLong* tadOffsets, Nd4jLong numTads, Nd4jLong numBlocks, E* acc, E* extraParams) {
+
+        const Nd4jLong tadLen   = shape::length(tadShapeInfo);
+        const Nd4jLong tadEws   = shape::elementWiseStride(tadShapeInfo);
+        const Nd4jLong blockLen = tadLen > numBlocks ? (tadLen + numBlocks - 1) / numBlocks : 1;
+        numBlocks = tadLen > 0 ? (tadLen + blockLen - 1) / blockLen : 1;
+
+        // all TADs share the same inner offsets
+        std::unique_ptr<Nd4jLong[]> innerOffsets;
+        if (tadEws < 1) {
+            innerOffsets.reset(new Nd4jLong[tadLen]);
+            shape::calcOffsets(tadShapeInfo, innerOffsets.get());
+        }
+
+        std::unique_ptr<E[]> partials(new E[numTads * numBlocks]);
+
+        ThreadPool::getInstance()->parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+            for (auto b = start; b < stop; b++) {
+                const auto blockStart = (b % numBlocks) * blockLen;
+                const auto blockStop  = blockStart + blockLen < tadLen ? blockStart + blockLen : tadLen;
+
+                partials[b] = blockReduce<OpType>(x + tadOffsets[b / numBlocks], blockStart, blockStop, tadEws, innerOffsets.get(), extraParams);
+            }
+        }, 0, numTads * numBlocks);
+
+        // shape of the tree depends on numBlocks only
+        for (Nd4jLong i = 0; i < numTads; i++) {
+            auto p = partials.get() + i * numBlocks;
+
+            for (Nd4jLong step = 1; step < numBlocks; step *= 2)
+                for (Nd4jLong k = 0; k + step < numBlocks; k += 2 * step)
+                    p[k] = OpType::update(p[k], p[k + step], extraParams);
+
+            acc[i] = p[0];
+        }
+    }
+
+//////////////////////////////////////////////////////////////////////////////
+    template<typename X, typename Z, typename E>
+    template <typename OpType>
+    E nd4j::ReductionLoops<X, Z, E>::loopReduceWhole(X* x, Nd4jLong* xShapeInfo, E* extraParams) {
+
+        Nd4jLong offset = 0;
+        E acc;
+
+        splitReduce<OpType>(x, xShapeInfo, &offset, 1, splitBlocks(shape::length(xShapeInfo), 1), &acc, extraParams);
+
+        return acc;
+    }
+
 //////////////////////////////////////////////////////////////////////////////
     template<typename X, typename Z, typename E>
     template <typename OpType>
@@ -280,6 +421,24 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
 
         int numThreads = OmpLaunchHelper::tadThreads(tadLen, zLen);
 
+        // few long TADs: each of them is split between threads
+        if (kindOfLoop != LoopKind::SMALLARR2DX) {
+            const auto numBlocks = splitBlocks(tadLen, zLen);
+
+            if (numBlocks > 1) {
+                std::unique_ptr<E[]> acc(new E[zLen]);
+                splitReduce<OpType>(x, tadShapeInfo, tadOffsets, zLen, numBlocks, acc.get(), extraParams);
+
+                uint castZShapeInfo[MAX_RANK];
+                const bool canCastZ = nd4j::DataTypeUtils::castShapeInfo<uint>(zShapeInfo, castZShapeInfo);
+
+                for (Nd4jLong i = 0; i < zLen; i++)
+                    z[shape::indexOffset(i, zShapeInfo, castZShapeInfo, zLen, canCastZ)] = OpType::postProcess(acc[i], tadLen, extraParams);
+
+                return;
+            }
+        }
+
         switch (kindOfLoop) {
 
             //*********************************************//
@@ -322,11 +481,7 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
 
                 PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
                 for (uint i = 0; i < zLen; i++) {
-                    auto tad = x + tadOffsets[i];
-                    auto start = OpType::startingValue(tad);
-
-                    for (uint j = 0; j < tadLen; j++)
-                        start = OpType::update(start, OpType::op(tad[j], extraParams), extraParams);
+                    auto start = blockReduce<OpType>(x + tadOffsets[i], 0, tadLen, 1, nullptr, extraParams);
 
                     z[i] = OpType::postProcess(start, tadLen, extraParams);
                 }
@@ -338,11 +493,7 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
 
                 PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
                 for (uint i = 0; i < zLen; i++) {
-                    auto tad = x + tadOffsets[i];
-                    auto start = OpType::startingValue(tad);
-
-                    for (uint j = 0; j < tadLen; j++)
-                        start = OpType::update(start, OpType::op(tad[j * tadEws], extraParams), extraParams);
+                    auto start = blockReduce<OpType>(x + tadOffsets[i], 0, tadLen, tadEws, nullptr, extraParams);
 
                     z[i * zEws] = OpType::postProcess(start, tadLen, extraParams);
                 }
@@ -60,6 +60,17 @@ namespace nd4j {
 #endif
 
         static void matmul(const nd4j::NDArray* x, const nd4j::NDArray* y, nd4j::NDArray* z, const bool transX, const bool transY);
+
+        /**
+        *  gemm over raw buffers of given data types, without BLAS; half-precision types are accumulated in fp32
+        *  cOrder - ordering of C, transA/transB - true if ordering of A/B differs from cOrder
+        */
+        static void gemm(const nd4j::DataType aType, const nd4j::DataType bType, const nd4j::DataType cType, const char cOrder, const bool transA, const bool transB, const int M, const int N, const int K, const double alpha, const void* A, const int lda, const void* B, const int ldb, const double beta, void* C, const int ldc);
+
+        /**
+        *  gemm over raw buffers of one data type, float and double go to BLAS when it is available
+        */
+        static void blasGemm(const nd4j::DataType type, const char cOrder, const bool transA, const bool transB, const int M, const int N, const int K, const double alpha, const void* A, const int lda, const void* B, const int ldb, const double beta, void* C, const int ldc);
     };
 }
 
@@ -0,0 +1,184 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_THREADPOOL_H
+#define LIBND4J_THREADPOOL_H
+
+#include <dll.h>
+#include <pointercast.h>
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <exception>
+
+#ifndef POOL_MAX_THREADS
+#define POOL_MAX_THREADS 256
+#endif
+
+// number of chunks each participating thread gets on average, so idle threads have something to steal
+#ifndef POOL_CHUNKS_PER_THREAD
+#define POOL_CHUNKS_PER_THREAD 4
+#endif
+
+namespace nd4j {
+    /**
+     * This class provides work-stealing thread pool, shared by all sessions within process.
+     *
+     * Every parallel_for call splits range into chunks, and posts "tickets" to worker queues. Caller thread
+     * takes part in execution, and idle workers steal tickets from each other. Nested calls made from pool tasks
+     * get fair share of thread budget, and OpenMP regions within tasks are limited the same way, so concurrent
+     * graphs don't oversubscribe cores.
+     */
+    class ND4J_EXPORT ThreadPool {
+    public:
+        typedef std::function<void(Nd4jLong start, Nd4jLong stop)> RangeFunction;
+
+        /**
+         * This class limits number of threads used by parallel calls made from current thread, until it goes out of scope
+         */
+        class ND4J_EXPORT Session {
+        private:
+            int _previous;
+        public:
+            explicit Session(int maxThreads);
+            ~Session();
+        };
+
+    private:
+        struct Job {
+            const RangeFunction *func;
+            Nd4jLong start;
+            Nd4jLong stop;
+            Nd4jLong chunk;
+            Nd4jLong numChunks;
+
+            // thread limit for nested calls and OpenMP regions within this job
+            int share;
+
+            std::atomic<Nd4jLong> next;
+            std::atomic<Nd4jLong> done;
+
+            std::mutex mutex;
+            std::condition_variable finished;
+            std::exception_ptr error;
+
+            Job() : next(0), done(0) { };
+        };
+
+        struct Worker {
+            std::mutex mutex;
+            std::deque<std::shared_ptr<Job>> queue;
+        };
+
+        static ThreadPool *_INSTANCE;
+
+        Worker _workers[POOL_MAX_THREADS];
+        std::vector<std::thread> _threads;
+        std::mutex _spawnLock;
+
+        std::atomic<int> _numWorkers;
+        std::atomic<int> _maxThreads;
+        std::atomic<int> _minThreads;
+
+        // number of tickets waiting in all queues
+        std::atomic<Nd4jLong> _pending;
+        std::atomic<unsigned int> _roundRobin;
+
+        std::mutex _mutex;
+        std::condition_variable _available;
+
+        ThreadPool();
+
+        void spawnWorkers(int numWorkers);
+        void workerLoop(int workerId);
+
+        void post(std::shared_ptr<Job> &job, int tickets);
+        bool takeTicket(std::shared_ptr<Job> &job);
+
+        static void runChunks(Job &job);
+    public:
+        ~ThreadPool() = default;
+
+        static ThreadPool* getInstance();
+
+        /**
+         * Global thread budget: maximal number of threads (including caller) any parallel call can use
+         */
+        int maxThreads();
+        void setMaxThreads(int maxThreads);
+
+        /**
+         * Minimal number of threads parallel call uses, if range is long enough: grain doesn't reduce parallelism below this number.
+         * Budget, session and per-call limits still apply
+         */
+        int minThreads();
+        void setMinThreads(int minThreads);
+
+        /**
+         * This method returns number of threads parallel call over given range would use within current session
+         */
+        int effectiveThreads(Nd4jLong length, Nd4jLong grain = 1, int maxThreads = 0);
+
+        /**
+         * This method calls func(start, stop) for disjoint sub-ranges covering [start, stop), in parallel.
+         * Returns once all sub-ranges are processed. First exception thrown by func is rethrown in caller.
+         *
+         * @param grain - minimal number of iterations per sub-range
+         * @param maxThreads - optional limit for this call, 0 means session limit
+         */
+        void parallel_for(const RangeFunction &func, Nd4jLong start, Nd4jLong stop, Nd4jLong grain = 1, int maxThreads = 0);
+
+        /**
+         * This method calls func(start, stop) for disjoint sub-ranges covering [start, stop) in parallel, and combines
+         * partial results with reducer. Partial results are combined in order of sub-ranges, so result doesn't depend on scheduling
+         */
+        template <typename T>
+        T parallel_reduce(const std::function<T(Nd4jLong, Nd4jLong)> &func, const std::function<T(T, T)> &reducer, Nd4jLong start, Nd4jLong stop, T identity, Nd4jLong grain = 1, int maxThreads = 0) {
+            if (stop <= start)
+                return identity;
+
+            auto threads = effectiveThreads(stop - start, grain, maxThreads);
+            if (threads <= 1)
+                return reducer(identity, func(start, stop));
+
+            Nd4jLong numChunks = threads;
+            Nd4jLong chunk = (stop - start + numChunks - 1) / numChunks;
+            numChunks = (stop - start + chunk - 1) / chunk;
+
+            std::unique_ptr<T[]> partials(new T[numChunks]);
+            parallel_for([&](Nd4jLong cStart, Nd4jLong cStop) {
+                for (auto c = cStart; c < cStop; c++) {
+                    auto s = start + c * chunk;
+                    auto e = s + chunk < stop ? s + chunk : stop;
+                    partials[c] = func(s, e);
+                }
+            }, 0, numChunks, 1, threads);
+
+            T result = identity;
+            for (Nd4jLong c = 0; c < numChunks; c++)
+                result = reducer(result, partials[c]);
+
+            return result;
+        }
+    };
+}
+
+#endif //LIBND4J_THREADPOOL_H
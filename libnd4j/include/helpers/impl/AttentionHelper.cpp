@@ -25,6 +25,10 @@
 
 #include "../AttentionHelper.h"
 #include <ops/declarable/CustomOperations.h>
+#include <helpers/ConstantTadHelper.h>
+#include <helpers/MmulHelper.h>
+#include <templatemath.h>
+#include <limits>
 
 namespace nd4j {
 
@@ -87,6 +91,261 @@ namespace nd4j {
         delete epsReshaped;
         delete projectionPrep;
     }
+
+    // number of queries and keys processed together by the fused attention kernels
+    static const int ATTENTION_QUERY_BLOCK = 64;
+    static const int ATTENTION_KEY_BLOCK = 128;
+
+    // per (batch, head) matrices of an attention operand: rows are features, columns are time steps with unit stride
+    template <typename T>
+    struct AttentionOperand {
+        T* buffer;
+        Nd4jLong* offsets;
+        int ld;
+
+        explicit AttentionOperand(const nd4j::NDArray* arr) {
+            const int rank = arr->rankOf();
+            auto pack = ConstantTadHelper::getInstance()->tadForDimensions(arr->getShapeInfo(), {rank - 2, rank - 1});
+            buffer = reinterpret_cast<T*>(const_cast<nd4j::NDArray*>(arr)->getBuffer());
+            offsets = pack.primaryOffsets();
+            ld = arr->sizeAt(-2) == 1 ? arr->sizeAt(-1) : shape::stride(arr->getShapeInfo())[rank - 2];
+        }
+
+        FORCEINLINE T* at(const Nd4jLong e) const {
+            return buffer + offsets[e];
+        }
+    };
+
+    // additive mask term per [batch, key]: 0 for kept positions, -1e9 for skipped ones, same as the unfused path
+    template <typename T>
+    static std::vector<T> attentionMaskBias(const nd4j::NDArray* mask) {
+        std::vector<T> bias;
+        if (mask != nullptr) {
+            bias.resize(mask->lengthOf());
+            for (Nd4jLong i = 0; i < mask->lengthOf(); ++i)
+                bias[i] = static_cast<T>((mask->e<double>(i) - 1.) * 1e9);
+        }
+        return bias;
+    }
+
+    // scores [kb x qb] = scale * K[:, k0:k0+kb]^T * Q[:, q0:q0+qb] + mask, row stride of scores is ATTENTION_QUERY_BLOCK
+    template <typename T>
+    static FORCEINLINE void attentionScores(const nd4j::DataType type, const T* k, const int kLd, const T* q, const int qLd, const int dK, const int kb, const int qb, const T scale, const T* bias, T* scores) {
+        MmulHelper::blasGemm(type, 'c', true, false, kb, qb, dK, scale, k, kLd, q, qLd, 0.0, scores, ATTENTION_QUERY_BLOCK);
+
+        if (bias != nullptr)
+            for (int r = 0; r < kb; ++r) {
+                PRAGMA_OMP_SIMD
+                for (int j = 0; j < qb; ++j)
+                    scores[r * ATTENTION_QUERY_BLOCK + j] += bias[r];
+            }
+    }
+
+    // forward pass, every task owns one block of queries and streams over key blocks keeping running max and sum of exponents
+    template <typename T>
+    static void dotProductAttention_(const nd4j::NDArray* queries, const nd4j::NDArray* keys, const nd4j::NDArray* values, const nd4j::NDArray* mask, const bool normalization, nd4j::NDArray* output, T* logSumExp) {
+        const auto type = queries->dataType();
+        const int heads = queries->rankOf() == 4 ? queries->sizeAt(1) : 1;
+        const int dK = queries->sizeAt(-2);
+        const int dV = values->sizeAt(-2);
+        const int Tq = queries->sizeAt(-1);
+        const int Tk = keys->sizeAt(-1);
+        const Nd4jLong numMatrices = queries->lengthOf() / ((Nd4jLong) dK * Tq);
+        const T scale = normalization ? static_cast<T>(1. / nd4j::math::nd4j_sqrt<double, double>(dK)) : static_cast<T>(1.);
+
+        AttentionOperand<T> q(queries), k(keys), v(values), out(output);
+        const auto maskBias = attentionMaskBias<T>(mask);
+
+        const int qBlocks = (Tq + ATTENTION_QUERY_BLOCK - 1) / ATTENTION_QUERY_BLOCK;
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(numMatrices * qBlocks > 1) schedule(dynamic, 1))
+        for (Nd4jLong task = 0; task < numMatrices * qBlocks; ++task) {
+            const Nd4jLong e = task / qBlocks;
+            const int q0 = (task % qBlocks) * ATTENTION_QUERY_BLOCK;
+            const int qb = nd4j::math::nd4j_min<int>(ATTENTION_QUERY_BLOCK, Tq - q0);
+            const T* bias = maskBias.empty() ? nullptr : maskBias.data() + (e / heads) * Tk;
+
+            std::vector<T> scores(ATTENTION_KEY_BLOCK * ATTENTION_QUERY_BLOCK);
+            std::vector<T> acc(dV * ATTENTION_QUERY_BLOCK, static_cast<T>(0.));
+            std::vector<T> runMax(ATTENTION_QUERY_BLOCK, -std::numeric_limits<T>::infinity());
+            std::vector<T> runSum(ATTENTION_QUERY_BLOCK, static_cast<T>(0.));
+            std::vector<T> factor(ATTENTION_QUERY_BLOCK);
+
+            for (int k0 = 0; k0 < Tk; k0 += ATTENTION_KEY_BLOCK) {
+                const int kb = nd4j::math::nd4j_min<int>(ATTENTION_KEY_BLOCK, Tk - k0);
+                attentionScores<T>(type, k.at(e) + k0, k.ld, q.at(e) + q0, q.ld, dK, kb, qb, scale, bias == nullptr ? nullptr : bias + k0, scores.data());
+
+                // new running max, previously accumulated terms are rescaled to it
+                for (int j = 0; j < qb; ++j)
+                    factor[j] = runMax[j];
+                for (int r = 0; r < kb; ++r)
+                    for (int j = 0; j < qb; ++j)
+                        factor[j] = nd4j::math::nd4j_max<T>(factor[j], scores[r * ATTENTION_QUERY_BLOCK + j]);
+
+                for (int j = 0; j < qb; ++j) {
+                    const T newMax = factor[j];
+                    factor[j] = nd4j::math::nd4j_exp<T, T>(runMax[j] - newMax);
+                    runMax[j] = newMax;
+                    runSum[j] *= factor[j];
+                }
+
+                for (int f = 0; f < dV; ++f) {
+                    PRAGMA_OMP_SIMD
+                    for (int j = 0; j < qb; ++j)
+                        acc[f * ATTENTION_QUERY_BLOCK + j] *= factor[j];
+                }
+
+                for (int r = 0; r < kb; ++r) {
+                    T* s = scores.data() + r * ATTENTION_QUERY_BLOCK;
+                    for (int j = 0; j < qb; ++j) {
+                        s[j] = nd4j::math::nd4j_exp<T, T>(s[j] - runMax[j]);
+                        runSum[j] += s[j];
+                    }
+                }
+
+                // acc += V[:, k0:k0+kb] * exp(scores)
+                MmulHelper::blasGemm(type, 'c', false, false, dV, qb, kb, 1.0, v.at(e) + k0, v.ld, scores.data(), ATTENTION_QUERY_BLOCK, 1.0, acc.data(), ATTENTION_QUERY_BLOCK);
+            }
+
+            T* z = out.at(e) + q0;
+            for (int f = 0; f < dV; ++f)
+                for (int j = 0; j < qb; ++j)
+                    z[f * out.ld + j] = acc[f * ATTENTION_QUERY_BLOCK + j] / runSum[j];
+
+            if (logSumExp != nullptr)
+                for (int j = 0; j < qb; ++j)
+                    logSumExp[e * Tq + q0 + j] = runMax[j] + nd4j::math::nd4j_log<T, T>(runSum[j]);
+        }
+    }
+
+    // softmax probabilities of a block recomputed from saved log-sum-exp, and dS = P * (dP - delta) * scale stored in dp
+    template <typename T>
+    static FORCEINLINE void attentionGradScores(const int kb, const int qb, const T* lse, const T* delta, const T scale, T* p, T* dp) {
+        for (int r = 0; r < kb; ++r) {
+            T* pr = p + r * ATTENTION_QUERY_BLOCK;
+            T* dpr = dp + r * ATTENTION_QUERY_BLOCK;
+            for (int j = 0; j < qb; ++j) {
+                pr[j] = nd4j::math::nd4j_exp<T, T>(pr[j] - lse[j]);
+                dpr[j] = pr[j] * (dpr[j] - delta[j]) * scale;
+            }
+        }
+    }
+
+    // backward pass: dK and dV are accumulated by tasks owning key blocks, dQ by tasks owning query blocks, so no task writes shared memory
+    template <typename T>
+    static void dotProductAttentionBp_(const nd4j::NDArray* queries, const nd4j::NDArray* keys, const nd4j::NDArray* values, const nd4j::NDArray* eps, const nd4j::NDArray* mask, const bool normalization,
+                                       nd4j::NDArray* dLdq, nd4j::NDArray* dLdk, nd4j::NDArray* dLdv) {
+        const auto type = queries->dataType();
+        const int heads = queries->rankOf() == 4 ? queries->sizeAt(1) : 1;
+        const int dK = queries->sizeAt(-2);
+        const int dV = values->sizeAt(-2);
+        const int Tq = queries->sizeAt(-1);
+        const int Tk = keys->sizeAt(-1);
+        const Nd4jLong numMatrices = queries->lengthOf() / ((Nd4jLong) dK * Tq);
+        const T scale = normalization ? static_cast<T>(1. / nd4j::math::nd4j_sqrt<double, double>(dK)) : static_cast<T>(1.);
+
+        // forward results, per query log-sum-exp and delta = sum over features of eps * attention
+        nd4j::NDArray attention('c', eps->getShapeAsVector(), type, queries->getWorkspace());
+        std::vector<T> lse(numMatrices * Tq);
+        std::vector<T> delta(numMatrices * Tq, static_cast<T>(0.));
+        dotProductAttention_<T>(queries, keys, values, mask, normalization, &attention, lse.data());
+
+        AttentionOperand<T> q(queries), k(keys), v(values), dO(eps), o(&attention), dq(dLdq), dk(dLdk), dv(dLdv);
+        const auto maskBias = attentionMaskBias<T>(mask);
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(numMatrices > 1)
+        for (Nd4jLong e = 0; e < numMatrices; ++e)
+            for (int f = 0; f < dV; ++f)
+                for (int j = 0; j < Tq; ++j)
+                    delta[e * Tq + j] += dO.at(e)[f * dO.ld + j] * o.at(e)[f * o.ld + j];
+
+        dLdq->nullify();
+        dLdk->nullify();
+        dLdv->nullify();
+
+        const int qBlocks = (Tq + ATTENTION_QUERY_BLOCK - 1) / ATTENTION_QUERY_BLOCK;
+        const int kBlocks = (Tk + ATTENTION_KEY_BLOCK - 1) / ATTENTION_KEY_BLOCK;
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(numMatrices * kBlocks > 1) schedule(dynamic, 1))
+        for (Nd4jLong task = 0; task < numMatrices * kBlocks; ++task) {
+            const Nd4jLong e = task / kBlocks;
+            const int k0 = (task % kBlocks) * ATTENTION_KEY_BLOCK;
+            const int kb = nd4j::math::nd4j_min<int>(ATTENTION_KEY_BLOCK, Tk - k0);
+            const T* bias = maskBias.empty() ? nullptr : maskBias.data() + (e / heads) * Tk + k0;
+
+            std::vector<T> p(ATTENTION_KEY_BLOCK * ATTENTION_QUERY_BLOCK);
+            std::vector<T> dp(ATTENTION_KEY_BLOCK * ATTENTION_QUERY_BLOCK);
+
+            for (int q0 = 0; q0 < Tq; q0 += ATTENTION_QUERY_BLOCK) {
+                const int qb = nd4j::math::nd4j_min<int>(ATTENTION_QUERY_BLOCK, Tq - q0);
+                attentionScores<T>(type, k.at(e) + k0, k.ld, q.at(e) + q0, q.ld, dK, kb, qb, scale, bias, p.data());
+
+                // dP = V[:, k]^T * dO[:, q]
+                MmulHelper::blasGemm(type, 'c', true, false, kb, qb, dV, 1.0, v.at(e) + k0, v.ld, dO.at(e) + q0, dO.ld, 0.0, dp.data(), ATTENTION_QUERY_BLOCK);
+                attentionGradScores<T>(kb, qb, lse.data() + e * Tq + q0, delta.data() + e * Tq + q0, scale, p.data(), dp.data());
+
+                // dV[:, k] += dO[:, q] * P^T,  dK[:, k] += Q[:, q] * dS^T
+                MmulHelper::blasGemm(type, 'c', false, true, dV, kb, qb, 1.0, dO.at(e) + q0, dO.ld, p.data(), ATTENTION_QUERY_BLOCK, 1.0, dv.at(e) + k0, dv.ld);
+                MmulHelper::blasGemm(type, 'c', false, true, dK, kb, qb, 1.0, q.at(e) + q0, q.ld, dp.data(), ATTENTION_QUERY_BLOCK, 1.0, dk.at(e) + k0, dk.ld);
+            }
+        }
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(numMatrices * qBlocks > 1) schedule(dynamic, 1))
+        for (Nd4jLong task = 0; task < numMatrices * qBlocks; ++task) {
+            const Nd4jLong e = task / qBlocks;
+            const int q0 = (task % qBlocks) * ATTENTION_QUERY_BLOCK;
+            const int qb = nd4j::math::nd4j_min<int>(ATTENTION_QUERY_BLOCK, Tq - q0);
+            const T* bias = maskBias.empty() ? nullptr : maskBias.data() + (e / heads) * Tk;
+
+            std::vector<T> p(ATTENTION_KEY_BLOCK * ATTENTION_QUERY_BLOCK);
+            std::vector<T> dp(ATTENTION_KEY_BLOCK * ATTENTION_QUERY_BLOCK);
+
+            for (int k0 = 0; k0 < Tk; k0 += ATTENTION_KEY_BLOCK) {
+                const int kb = nd4j::math::nd4j_min<int>(ATTENTION_KEY_BLOCK, Tk - k0);
+                attentionScores<T>(type, k.at(e) + k0, k.ld, q.at(e) + q0, q.ld, dK, kb, qb, scale, bias == nullptr ? nullptr : bias + k0, p.data());
+
+                MmulHelper::blasGemm(type, 'c', true, false, kb, qb, dV, 1.0, v.at(e) + k0, v.ld, dO.at(e) + q0, dO.ld, 0.0, dp.data(), ATTENTION_QUERY_BLOCK);
+                attentionGradScores<T>(kb, qb, lse.data() + e * Tq + q0, delta.data() + e * Tq + q0, scale, p.data(), dp.data());
+
+                // dQ[:, q] += K[:, k] * dS
+                MmulHelper::blasGemm(type, 'c', false, false, dK, qb, kb, 1.0, k.at(e) + k0, k.ld, dp.data(), ATTENTION_QUERY_BLOCK, 1.0, dq.at(e) + q0, dq.ld);
+            }
+        }
+    }
+
+    bool AttentionHelper::canFuseAttention(const std::vector<const nd4j::NDArray*>& arrays) {
+        const auto type = arrays[0]->dataType();
+        if (type != nd4j::DataType::FLOAT32 && type != nd4j::DataType::DOUBLE)
+            return false;
+
+        for (auto arr : arrays) {
+            const int rank = arr->rankOf();
+            const Nd4jLong* strides = shape::stride(arr->getShapeInfo());
+            if (arr->dataType() != type || arr->lengthOf() == 0)
+                return false;
+            // time steps have to be contiguous and feature rows must not overlap
+            if (arr->sizeAt(-1) > 1 && strides[rank - 1] != 1)
+                return false;
+            if (arr->sizeAt(-2) > 1 && strides[rank - 2] < arr->sizeAt(-1))
+                return false;
+        }
+        return true;
+    }
+
+    void AttentionHelper::dotProductAttention(const nd4j::NDArray* queries, const nd4j::NDArray* keys, const nd4j::NDArray* values, const nd4j::NDArray* mask, const bool normalization, nd4j::NDArray* output) {
+        if (queries->dataType() == nd4j::DataType::FLOAT32)
+            dotProductAttention_<float>(queries, keys, values, mask, normalization, output, nullptr);
+        else
+            dotProductAttention_<double>(queries, keys, values, mask, normalization, output, nullptr);
+    }
+
+    void AttentionHelper::dotProductAttentionBp(const nd4j::NDArray* queries, const nd4j::NDArray* keys, const nd4j::NDArray* values, const nd4j::NDArray* eps, const nd4j::NDArray* mask, const bool normalization,
+                                                nd4j::NDArray* dLdq, nd4j::NDArray* dLdk, nd4j::NDArray* dLdv) {
+        if (queries->dataType() == nd4j::DataType::FLOAT32)
+            dotProductAttentionBp_<float>(queries, keys, values, eps, mask, normalization, dLdq, dLdk, dLdv);
+        else
+            dotProductAttentionBp_<double>(queries, keys, values, eps, mask, normalization, dLdq, dLdk, dLdv);
+    }
 }
 
 
@@ -0,0 +1,128 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include "../ConstantShapeHelper.h"
+#include <helpers/shape.h>
+#include <cstring>
+
+namespace nd4j {
+
+    ConstantShapeHelper::ConstantShapeHelper(Nd4jLong limit) : _hits(0), _misses(0), _size(0), _limit(limit) {
+        //
+    }
+
+    ConstantShapeHelper::~ConstantShapeHelper() {
+        for (auto &bucket: _buckets) {
+            auto e = bucket.head.load();
+            while (e != nullptr) {
+                auto next = e->next;
+                delete[] e->shapeInfo;
+                delete e;
+                e = next;
+            }
+        }
+    }
+
+    ConstantShapeHelper* ConstantShapeHelper::getInstance() {
+        if (!_INSTANCE)
+            _INSTANCE = new ConstantShapeHelper();
+
+        return _INSTANCE;
+    }
+
+    Nd4jLong ConstantShapeHelper::hashOf(const Nd4jLong *shapeInfo) {
+        // FNV-1a over the whole shapeInfo, including strides, ews, order and data type
+        auto h = 14695981039346656037ULL;
+        auto length = shape::shapeInfoLength(const_cast<Nd4jLong*>(shapeInfo));
+        for (int e = 0; e < length; e++)
+            h = (h ^ (unsigned long long) shapeInfo[e]) * 1099511628211ULL;
+
+        return (Nd4jLong) h;
+    }
+
+    ConstantShapeHelper::CacheEntry* ConstantShapeHelper::lookup(CacheEntry *head, Nd4jLong hash, const Nd4jLong *shapeInfo) {
+        auto bytes = shape::shapeInfoByteLength(const_cast<Nd4jLong*>(shapeInfo));
+        for (auto e = head; e != nullptr; e = e->next)
+            if (e->hash == hash && e->shapeInfo[0] == shapeInfo[0] && std::memcmp(e->shapeInfo, shapeInfo, bytes) == 0)
+                return e;
+
+        return nullptr;
+    }
+
+    Nd4jLong* ConstantShapeHelper::createFromExisting(const Nd4jLong *shapeInfo) {
+        return intern(shapeInfo, false);
+    }
+
+    Nd4jLong* ConstantShapeHelper::tryCreateFromExisting(const Nd4jLong *shapeInfo) {
+        return intern(shapeInfo, true);
+    }
+
+    Nd4jLong* ConstantShapeHelper::intern(const Nd4jLong *shapeInfo, bool bounded) {
+        const auto hash = hashOf(shapeInfo);
+        auto &bucket = _buckets[(unsigned long long) hash % SHAPE_CACHE_BUCKETS];
+
+        // fast path: entries are published with release semantics, so no lock needed here
+        auto entry = lookup(bucket.head.load(std::memory_order_acquire), hash, shapeInfo);
+        if (entry != nullptr) {
+            _hits.fetch_add(1, std::memory_order_relaxed);
+            return entry->shapeInfo;
+        }
+
+        // entries can't be evicted while arrays reference them, so cache just stops growing
+        if (bounded && _size.load(std::memory_order_relaxed) >= _limit)
+            return nullptr;
+
+        std::lock_guard<std::mutex> lock(bucket.mutex);
+
+        // other thread might have added this shape while we were waiting
+        auto head = bucket.head.load(std::memory_order_acquire);
+        entry = lookup(head, hash, shapeInfo);
+        if (entry != nullptr) {
+            _hits.fetch_add(1, std::memory_order_relaxed);
+            return entry->shapeInfo;
+        }
+
+        auto length = shape::shapeInfoLength(const_cast<Nd4jLong*>(shapeInfo));
+        auto copy = new Nd4jLong[length];
+        std::memcpy(copy, shapeInfo, length * sizeof(Nd4jLong));
+
+        entry = new CacheEntry(hash, copy, head);
+        bucket.head.store(entry, std::memory_order_release);
+
+        _misses.fetch_add(1, std::memory_order_relaxed);
+        _size.fetch_add(1, std::memory_order_relaxed);
+
+        return copy;
+    }
+
+    Nd4jLong ConstantShapeHelper::cacheHits() {
+        return _hits.load();
+    }
+
+    Nd4jLong ConstantShapeHelper::cacheMisses() {
+        return _misses.load();
+    }
+
+    Nd4jLong ConstantShapeHelper::cacheSize() {
+        return _size.load();
+    }
+
+    Nd4jLong ConstantShapeHelper::cacheLimit() {
+        return _limit;
+    }
+
+    nd4j::ConstantShapeHelper* nd4j::ConstantShapeHelper::_INSTANCE = 0;
+}
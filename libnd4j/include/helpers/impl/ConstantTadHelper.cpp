@@ -19,15 +19,15 @@
 //
 
 #include "../ConstantTadHelper.h"
+#include "../ConstantShapeHelper.h"
 #include <TAD.h>
 #include <ShapeUtils.h>
 
 
 namespace nd4j {
   
-    ConstantTadHelper::ConstantTadHelper() {
-        std::map<TadDescriptor, TadPack> pack;
-        _cache.emplace_back(pack);
+    ConstantTadHelper::ConstantTadHelper() : _hits(0), _misses(0) {
+        //
     }
 
     ConstantTadHelper* ConstantTadHelper::getInstance() {
@@ -55,60 +55,70 @@ namespace nd4j {
         return tadForDimensions(tadDescriptor);
     }
 
-    TadPack& ConstantTadHelper::tadForDimensions(TadDescriptor &descriptor) {
-        const int deviceId = 0;
-
-        _mutex.lock();
-        if (_cache[deviceId].count(descriptor) == 0) {
-            
-            const auto shapeInfo = descriptor.originalShape().toShapeInfo();
-            const int rank = shape::rank(shapeInfo);
-            const std::vector<int> dimsToExclude = ShapeUtils::evalDimsToExclude(rank, descriptor.axis());
-            const Nd4jLong numOfSubArrs = ShapeUtils::getNumOfSubArrs(shapeInfo, dimsToExclude);
-            const int subArrRank = (rank == dimsToExclude.size() || descriptor.areUnitiesinShape()) ? rank : rank - dimsToExclude.size();
+    ConstantTadHelper::CacheEntry* ConstantTadHelper::lookup(CacheEntry *head, Nd4jLong hash, TadDescriptor &descriptor) {
+        for (auto e = head; e != nullptr; e = e->next)
+            if (e->hash == hash && e->descriptor == descriptor)
+                return e;
 
-            auto sPtr = new Nd4jLong[shape::shapeInfoLength(subArrRank)];
-            auto oPtr = new Nd4jLong[numOfSubArrs];
+        return nullptr;
+    }
 
-            shape::calcSubArrShapeAndOffsets(shapeInfo, numOfSubArrs, dimsToExclude.size(), dimsToExclude.data(), sPtr, oPtr, descriptor.areUnitiesinShape());
+    TadPack& ConstantTadHelper::tadForDimensions(TadDescriptor &descriptor) {
+        const auto hash = descriptor.hash();
+        auto &bucket = _buckets[(unsigned long long) hash % TAD_CACHE_BUCKETS];
+
+        // fast path: entries are published with release semantics, so no lock needed here
+        auto entry = lookup(bucket.head.load(std::memory_order_acquire), hash, descriptor);
+        if (entry != nullptr) {
+            _hits.fetch_add(1, std::memory_order_relaxed);
+            return entry->pack;
+        }
 
-            DataBuffer shapesBuffer(sPtr, nullptr);
-            DataBuffer offsetsBuffer(oPtr, nullptr);
-            TadPack t(shapesBuffer, offsetsBuffer, numOfSubArrs);
+        std::lock_guard<std::mutex> lock(bucket.mutex);
 
+        // other thread might have built this pack while we were waiting
+        auto head = bucket.head.load(std::memory_order_acquire);
+        entry = lookup(head, hash, descriptor);
+        if (entry != nullptr) {
+            _hits.fetch_add(1, std::memory_order_relaxed);
+            return entry->pack;
+        }
 
+        const auto shapeInfo = descriptor.originalShape().toShapeInfo();
+        const int rank = shape::rank(shapeInfo);
+        const std::vector<int> dimsToExclude = ShapeUtils::evalDimsToExclude(rank, descriptor.axis());
+        const Nd4jLong numOfSubArrs = ShapeUtils::getNumOfSubArrs(shapeInfo, dimsToExclude);
+        const int subArrRank = (rank == dimsToExclude.size() || descriptor.areUnitiesinShape()) ? rank : rank - dimsToExclude.size();
 
-            // auto shapeInfo = descriptor.originalShape().toShapeInfo();
-            // shape::TAD tad;
-            // tad.init(shapeInfo, descriptor.axis().data(), descriptor.axis().size());
-            // tad.createTadOnlyShapeInfo();
-            // tad.createOffsets();       
+        auto sPtr = new Nd4jLong[shape::shapeInfoLength(subArrRank)];
+        auto oPtr = new Nd4jLong[numOfSubArrs];
 
-            // auto sPtr = new Nd4jLong[shape::shapeInfoLength(tad.tadOnlyShapeInfo)];
-            // auto oPtr = new Nd4jLong[tad.numTads];
+        shape::calcSubArrShapeAndOffsets(shapeInfo, numOfSubArrs, dimsToExclude.size(), dimsToExclude.data(), sPtr, oPtr, descriptor.areUnitiesinShape());
 
-            // memcpy(sPtr, tad.tadOnlyShapeInfo, shape::shapeInfoByteLength(tad.tadOnlyShapeInfo));
-            // memcpy(oPtr, tad.tadOffsets, tad.numTads * sizeof(Nd4jLong));
+        // TAD shapeInfo is interned, so views built from it share it with any other array of the same shape
+        auto iPtr = ConstantShapeHelper::getInstance()->createFromExisting(sPtr);
+        delete[] sPtr;
 
-            // DataBuffer shapesBuffer(sPtr, nullptr);
-            // DataBuffer offsetsBuffer(oPtr, nullptr);
-            // TadPack t(shapesBuffer, offsetsBuffer, tad.numTads);
+        DataBuffer shapesBuffer(iPtr, nullptr);
+        DataBuffer offsetsBuffer(oPtr, nullptr);
+        TadPack t(shapesBuffer, offsetsBuffer, numOfSubArrs);
 
+        delete[] shapeInfo;
 
-            _cache[deviceId][descriptor] = t;
+        entry = new CacheEntry(hash, descriptor, t, head);
+        bucket.head.store(entry, std::memory_order_release);
 
-            TadPack &r = _cache[deviceId][descriptor];
-            _mutex.unlock();
+        _misses.fetch_add(1, std::memory_order_relaxed);
 
-            delete[] shapeInfo;
+        return entry->pack;
+    }
 
-            return r;
-        } else {
-            TadPack &r = _cache[deviceId][descriptor];
-            _mutex.unlock();
+    Nd4jLong ConstantTadHelper::cacheHits() {
+        return _hits.load();
+    }
 
-            return r;
-        }
+    Nd4jLong ConstantTadHelper::cacheMisses() {
+        return _misses.load();
     }
 
     nd4j::ConstantTadHelper* nd4j::ConstantTadHelper::_INSTANCE = 0;
@@ -29,39 +29,154 @@
 namespace nd4j { 
 
 
+//////////////////////////////////////////////////////////////////////////////
+// type used for accumulation: half-precision types are accumulated in fp32, to get both speed and accuracy
+template <typename T>
+struct GemmAccumulator {
+    typedef T type;
+};
+
+template <>
+struct GemmAccumulator<float16> {
+    typedef float type;
+};
+
+template <>
+struct GemmAccumulator<bfloat16> {
+    typedef float type;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// blocking parameters for fallback gemm: MR x NR is register block of micro-kernel, MC x KC and KC x NC are packed panels of A and B
+#define GEMM_MR 4
+#define GEMM_NR 8
+#define GEMM_MC 64
+#define GEMM_NC 128
+#define GEMM_KC 256
+
+//////////////////////////////////////////////////////////////////////////////
+// packs mc x kc block of A into row panels of GEMM_MR rows, k-major within panel, padded with zeros
+template <typename T1, typename TA>
+static void packGemmA(const T1* A, const bool flagA, const int lda, const int rowStart, const int mc, const int kStart, const int kc, TA* packed) {
+
+    for(int p = 0; p < mc; p += GEMM_MR) {
+        TA* panel = packed + p * kc;
+        for(int i = 0; i < kc; ++i) {
+            for(int r = 0; r < GEMM_MR; ++r) {
+                const int row = rowStart + p + r;
+                const int k   = kStart + i;
+                panel[i * GEMM_MR + r] = p + r < mc ? static_cast<TA>(flagA ? A[row * lda + k] : A[row + k * lda]) : static_cast<TA>(0);
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// packs kc x nc block of B into column panels of GEMM_NR columns, k-major within panel, padded with zeros
+template <typename T2, typename TA>
+static void packGemmB(const T2* B, const bool flagB, const int ldb, const int colStart, const int nc, const int kStart, const int kc, TA* packed) {
+
+    for(int p = 0; p < nc; p += GEMM_NR) {
+        TA* panel = packed + p * kc;
+        for(int i = 0; i < kc; ++i) {
+            for(int c = 0; c < GEMM_NR; ++c) {
+                const int col = colStart + p + c;
+                const int k   = kStart + i;
+                panel[i * GEMM_NR + c] = p + c < nc ? static_cast<TA>(flagB ? B[col + k * ldb] : B[col * ldb + k]) : static_cast<TA>(0);
+            }
+        }
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // MXK x KxN = MxN
+// cache-blocked gemm: each thread takes MC x NC tile of C, and multiplies packed panels of A and B with register-blocked micro-kernel
+// panels are converted to accumulation type once, and tile of C is written back once, after all K blocks are done
 template <typename T1, typename T2, typename T3>
 static void usualGemm(const char cOrder, const bool transA, const bool transB, const int M, const int N, const int K, const double alpha, const void* vA, const int lda, const void* vB, const int ldb, const double beta, void* vC, const int ldc) {
 
+    typedef typename GemmAccumulator<T3>::type TA;
+
     T1* A = reinterpret_cast<T1*>(const_cast<void*>(vA));
     T2* B = reinterpret_cast<T2*>(const_cast<void*>(vB));
     T3* C = reinterpret_cast<T3*>(vC);
-    T3 alphaZ(alpha), betaZ(beta);
+    TA alphaZ(alpha), betaZ(beta);
     
     const bool flagC = cOrder == 'f';
     const bool flagA = (flagC && transA) || (!flagC && !transA);
     const bool flagB = (flagC && transB) || (!flagC && !transB);   
 
-    PRAGMA_OMP_PARALLEL_FOR_COLLAPSE(2)
-    for(uint row = 0; row < M; ++row) {
-       for(uint col = 0; col < N; ++col) {
-            
-            T3* c = flagC ? (C + row + col * ldc) : (C + row * ldc + col);
-            T3 val = 0;
-
-           PRAGMA_OMP_SIMD
-            for(uint i = 0; i < K; ++i) {
-                T3 a = flagA ? *(A + row * lda + i) : *(A + row + i * lda);
-                T3 b = flagB ? *(B + col + i * ldb) : *(B + col * ldb + i);             
-                val += alphaZ * a * b;
+    const int mTiles = (M + GEMM_MC - 1) / GEMM_MC;
+    const int nTiles = (N + GEMM_NC - 1) / GEMM_NC;
+    const int kc0 = nd4j::math::nd4j_max<int>(1, nd4j::math::nd4j_min<int>(K, GEMM_KC));
+
+    PRAGMA_OMP_PARALLEL_FOR_ARGS(if(mTiles * nTiles > 1) collapse(2) schedule(dynamic, 1))
+    for(int mt = 0; mt < mTiles; ++mt) {
+        for(int nt = 0; nt < nTiles; ++nt) {
+
+            const int rowStart = mt * GEMM_MC;
+            const int colStart = nt * GEMM_NC;
+            const int mc = nd4j::math::nd4j_min<int>(GEMM_MC, M - rowStart);
+            const int nc = nd4j::math::nd4j_min<int>(GEMM_NC, N - colStart);
+
+            // panels are padded up to full register blocks
+            std::vector<TA> packedA(((mc + GEMM_MR - 1) / GEMM_MR) * GEMM_MR * kc0);
+            std::vector<TA> packedB(((nc + GEMM_NR - 1) / GEMM_NR) * GEMM_NR * kc0);
+            std::vector<TA> tile(mc * nc, static_cast<TA>(0));
+
+            for(int kStart = 0; kStart < K; kStart += kc0) {
+
+                const int kc = nd4j::math::nd4j_min<int>(kc0, K - kStart);
+
+                packGemmA<T1, TA>(A, flagA, lda, rowStart, mc, kStart, kc, packedA.data());
+                packGemmB<T2, TA>(B, flagB, ldb, colStart, nc, kStart, kc, packedB.data());
+
+                for(int jr = 0; jr < nc; jr += GEMM_NR) {
+                    const TA* panelB = packedB.data() + jr * kc;
+
+                    for(int ir = 0; ir < mc; ir += GEMM_MR) {
+                        const TA* panelA = packedA.data() + ir * kc;
+
+                        // micro-kernel: GEMM_MR x GEMM_NR block of C is accumulated in registers
+                        TA acc[GEMM_MR][GEMM_NR];
+                        for(int r = 0; r < GEMM_MR; ++r)
+                            for(int c = 0; c < GEMM_NR; ++c)
+                                acc[r][c] = static_cast<TA>(0);
+
+                        for(int i = 0; i < kc; ++i) {
+                            const TA* a = panelA + i * GEMM_MR;
+                            const TA* b = panelB + i * GEMM_NR;
+
+                            for(int r = 0; r < GEMM_MR; ++r) {
+                                PRAGMA_OMP_SIMD
+                                for(int c = 0; c < GEMM_NR; ++c)
+                                    acc[r][c] += a[r] * b[c];
+                            }
+                        }
+
+                        const int mr = nd4j::math::nd4j_min<int>(GEMM_MR, mc - ir);
+                        const int nr = nd4j::math::nd4j_min<int>(GEMM_NR, nc - jr);
+
+                        for(int r = 0; r < mr; ++r)
+                            for(int c = 0; c < nr; ++c)
+                                tile[(ir + r) * nc + jr + c] += acc[r][c];
+                    }
+                }
             }
-            
-            if(betaZ)
-                *c = val + betaZ * *c;
-            else
-                *c = val;
-       }
+
+            for(int r = 0; r < mc; ++r) {
+                for(int c = 0; c < nc; ++c) {
+                    const int row = rowStart + r;
+                    const int col = colStart + c;
+                    T3* z = flagC ? (C + row + col * ldc) : (C + row * ldc + col);
+
+                    if(beta != 0.)
+                        *z = static_cast<T3>(alphaZ * tile[r * nc + c] + betaZ * static_cast<TA>(*z));
+                    else
+                        *z = static_cast<T3>(alphaZ * tile[r * nc + c]);
+                }
+            }
+        }
     }
 }
 
@@ -70,10 +185,12 @@ static void usualGemm(const char cOrder, const bool transA, const bool transB, c
 template <typename T1, typename T2, typename T3>
 static void usualGemv(const char aOrder, const int M, const int N, const double alpha, const void* vA, const int lda, const void* vX, const int incx, const double beta, void* vY, const int incy) {
 
+    typedef typename GemmAccumulator<T3>::type TA;
+
     T1* A = reinterpret_cast<T1*>(const_cast<void*>(vA));
     T2* X = reinterpret_cast<T2*>(const_cast<void*>(vX));
     T3* Y = reinterpret_cast<T3*>(vY);
-    T3 alphaZ(alpha), betaZ(beta);
+    TA alphaZ(alpha), betaZ(beta);
     
     const bool flagA = aOrder == 'f';
 
@@ -81,19 +198,19 @@ static void usualGemv(const char aOrder, const int M, const int N, const double
     for(int row = 0; row < M; ++row) {
                         
         T3* y = Y + row * incy;
-        T3 val = 0;
+        TA val = 0;
 
         PRAGMA_OMP_SIMD
         for(int i = 0; i < N; ++i) {
-            T3 a = flagA ? *(A + row + i * lda) : *(A + row * lda + i);
-            T3 x = *(X + i * incx);
+            TA a = static_cast<TA>(flagA ? *(A + row + i * lda) : *(A + row * lda + i));
+            TA x = static_cast<TA>(*(X + i * incx));
             val += alphaZ * a * x;
         }
         
-        if(betaZ)
-            *y = val + betaZ * *y;
+        if(beta != 0.)
+            *y = static_cast<T3>(val + betaZ * static_cast<TA>(*y));
         else
-            *y = val;
+            *y = static_cast<T3>(val);
     }
 }
 
@@ -102,17 +219,19 @@ static void usualGemv(const char aOrder, const int M, const int N, const double
 template <typename T1, typename T2, typename T3>
 static void usualDot(const Nd4jLong length, const double alpha, const void* vX, const Nd4jLong incx, const void* vY, const Nd4jLong incy, const double beta, void* vZ) {
 
+    typedef typename GemmAccumulator<T3>::type TA;
+
     T1* X = reinterpret_cast<T1*>(const_cast<void*>(vX));
     T2* Y = reinterpret_cast<T2*>(const_cast<void*>(vY));
     T3* Z = reinterpret_cast<T3*>(vZ);
-    T3 alphaZ(alpha), betaZ(beta);
+    TA alphaZ(alpha), betaZ(beta);
 
-    T3 sum = 0;
+    TA sum = 0;
     PRAGMA_OMP_PARALLEL_FOR_SIMD_REDUCTION(sumT:sum)
     for(unsigned int i = 0; i < length; ++i)
-        sum = sum + X[i * incx] * Y[i * incy];        
+        sum = sum + static_cast<TA>(X[i * incx]) * static_cast<TA>(Y[i * incy]);
     
-    *Z = alphaZ * sum + betaZ * *Z;
+    *Z = static_cast<T3>(alphaZ * sum + betaZ * static_cast<TA>(*Z));
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -183,9 +302,23 @@ NDArray* MmulHelper::mmulMxM(const NDArray* A, const NDArray* B, NDArray* C, con
         nd4j_debug("MMUL: Using provided BLAS impl\n","");
         BlasHelper::getInstance()->dgemm()(blasOrder, transAblas, transBblas, M, N, K, (double) alpha, reinterpret_cast<double *>(pA->getBuffer()), lda, reinterpret_cast<double *>(pB->getBuffer()), ldb, (double) beta, reinterpret_cast<double *>(pC->getBuffer()), ldc);
     }
+    else if (ABC && (aType == DataType::HALF || aType == DataType::BFLOAT16) && BlasHelper::getInstance()->hasGEMM(DataType::FLOAT32)) {
+        // half-precision arrays are converted to fp32 once, multiplied by BLAS with fp32 accumulation, and converted back
+        nd4j_debug("MMUL: Using provided BLAS impl with fp32 accumulation\n","");
+        auto fA = pA->cast(DataType::FLOAT32);
+        auto fB = pB->cast(DataType::FLOAT32);
+        auto fC = pC->cast(DataType::FLOAT32);
+
+        BlasHelper::getInstance()->sgemm()(blasOrder, transAblas, transBblas, M, N, K, (float) alpha, reinterpret_cast<float *>(fA->getBuffer()), lda, reinterpret_cast<float *>(fB->getBuffer()), ldb, (float) beta, reinterpret_cast<float *>(fC->getBuffer()), ldc);
+        pC->assign(fC);
+
+        delete fA;
+        delete fB;
+        delete fC;
+    }
     else {
         nd4j_debug("MMUL: Using fallback BLAS impl\n","");
-        BUILD_TRIPLE_SELECTOR(aType, bType, cType, usualGemm, (cOrder, transA, transB, M, N, K, alpha, pA->getBuffer(), lda, pB->getBuffer(), ldb, beta, pC->getBuffer(), ldc), LIBND4J_TYPES, FLOAT_TYPES, FLOAT_TYPES);
+        gemm(aType, bType, cType, cOrder, transA, transB, M, N, K, alpha, pA->getBuffer(), lda, pB->getBuffer(), ldb, beta, pC->getBuffer(), ldc);
     }    
 
     if(pC != C) {
@@ -200,6 +333,26 @@ NDArray* MmulHelper::mmulMxM(const NDArray* A, const NDArray* B, NDArray* C, con
     return C;
 }
 
+////////////////////////////////////////////////////////////////////////////
+void MmulHelper::gemm(const nd4j::DataType aType, const nd4j::DataType bType, const nd4j::DataType cType, const char cOrder, const bool transA, const bool transB, const int M, const int N, const int K, const double alpha, const void* A, const int lda, const void* B, const int ldb, const double beta, void* C, const int ldc) {
+    BUILD_TRIPLE_SELECTOR(aType, bType, cType, usualGemm, (cOrder, transA, transB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc), LIBND4J_TYPES, FLOAT_TYPES, FLOAT_TYPES);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+void MmulHelper::blasGemm(const nd4j::DataType type, const char cOrder, const bool transA, const bool transB, const int M, const int N, const int K, const double alpha, const void* A, const int lda, const void* B, const int ldb, const double beta, void* C, const int ldc) {
+
+    const CBLAS_ORDER blasOrder      = cOrder == 'f' ? CblasColMajor : CblasRowMajor;
+    const CBLAS_TRANSPOSE transAblas = transA ? CblasTrans : CblasNoTrans;
+    const CBLAS_TRANSPOSE transBblas = transB ? CblasTrans : CblasNoTrans;
+
+    if (type == DataType::FLOAT32 && BlasHelper::getInstance()->hasGEMM(type))
+        BlasHelper::getInstance()->sgemm()(blasOrder, transAblas, transBblas, M, N, K, (float) alpha, reinterpret_cast<float *>(const_cast<void*>(A)), lda, reinterpret_cast<float *>(const_cast<void*>(B)), ldb, (float) beta, reinterpret_cast<float *>(C), ldc);
+    else if (type == DataType::DOUBLE && BlasHelper::getInstance()->hasGEMM(type))
+        BlasHelper::getInstance()->dgemm()(blasOrder, transAblas, transBblas, M, N, K, alpha, reinterpret_cast<double *>(const_cast<void*>(A)), lda, reinterpret_cast<double *>(const_cast<void*>(B)), ldb, beta, reinterpret_cast<double *>(C), ldc);
+    else
+        gemm(type, type, type, cOrder, transA, transB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
 ////////////////////////////////////////////////////////////////////////////
 // MXN x N = M
 NDArray* MmulHelper::mmulMxV(const NDArray* A, const NDArray* X, nd4j::NDArray* Y, const double alpha, const double beta, const char outOrder) {
@@ -0,0 +1,298 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <helpers/ThreadPool.h>
+#include <Environment.h>
+#include <chrono>
+#include <omp.h>
+
+namespace nd4j {
+
+    // id of pool worker running on current thread, -1 for external threads
+    static thread_local int _workerId = -1;
+
+    // thread limit set by Session, or inherited from job we're executing. 0 means no limit
+    static thread_local int _sessionLimit = 0;
+
+    /**
+     * This class applies job's share to nested parallel calls and OpenMP regions, and restores previous state
+     */
+    class ShareGuard {
+    private:
+        int _session;
+        int _omp;
+    public:
+        explicit ShareGuard(int share) {
+            _session = _sessionLimit;
+            _omp = omp_get_max_threads();
+
+            _sessionLimit = share;
+            omp_set_num_threads(share);
+        }
+
+        ~ShareGuard() {
+            _sessionLimit = _session;
+            omp_set_num_threads(_omp);
+        }
+    };
+
+    ThreadPool::Session::Session(int maxThreads) {
+        _previous = _sessionLimit;
+
+        // session can only narrow limit it was started within
+        _sessionLimit = _previous > 0 && (maxThreads <= 0 || maxThreads > _previous) ? _previous : maxThreads;
+    }
+
+    ThreadPool::Session::~Session() {
+        _sessionLimit = _previous;
+    }
+
+    ThreadPool::ThreadPool() : _numWorkers(0), _minThreads(1), _pending(0), _roundRobin(0) {
+        int budget = Environment::getInstance()->maxThreads();
+        if (budget <= 0)
+            budget = (int) std::thread::hardware_concurrency();
+
+        if (budget <= 0)
+            budget = 1;
+
+        _maxThreads.store(budget > POOL_MAX_THREADS ? POOL_MAX_THREADS : budget);
+    }
+
+    ThreadPool* ThreadPool::getInstance() {
+        if (!_INSTANCE)
+            _INSTANCE = new ThreadPool();
+
+        return _INSTANCE;
+    }
+
+    int ThreadPool::maxThreads() {
+        return _maxThreads.load();
+    }
+
+    void ThreadPool::setMaxThreads(int maxThreads) {
+        if (maxThreads < 1)
+            maxThreads = 1;
+
+        // workers are never destroyed, lower budget just means fewer tickets per job
+        _maxThreads.store(maxThreads > POOL_MAX_THREADS ? POOL_MAX_THREADS : maxThreads);
+    }
+
+    int ThreadPool::minThreads() {
+        return _minThreads.load();
+    }
+
+    void ThreadPool::setMinThreads(int minThreads) {
+        if (minThreads < 1)
+            minThreads = 1;
+
+        _minThreads.store(minThreads > POOL_MAX_THREADS ? POOL_MAX_THREADS : minThreads);
+    }
+
+    void ThreadPool::spawnWorkers(int numWorkers) {
+        if (_numWorkers.load() >= numWorkers)
+            return;
+
+        std::lock_guard<std::mutex> lock(_spawnLock);
+        for (int e = _numWorkers.load(); e < numWorkers; e++) {
+            _threads.emplace_back(&ThreadPool::workerLoop, this, e);
+            _threads.back().detach();
+            _numWorkers++;
+        }
+    }
+
+    void ThreadPool::workerLoop(int workerId) {
+        _workerId = workerId;
+
+        // OpenMP regions in pool threads are sized by job shares only
+        omp_set_num_threads(1);
+
+        while (true) {
+            std::shared_ptr<Job> job;
+            if (takeTicket(job)) {
+                runChunks(*job);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            _available.wait(lock, [&] { return _pending.load() > 0; });
+        }
+    }
+
+    bool ThreadPool::takeTicket(std::shared_ptr<Job> &job) {
+        if (_pending.load() <= 0)
+            return false;
+
+        const int numWorkers = _numWorkers.load();
+
+        // own queue goes first, newest tickets first, since their data is most likely still in cache
+        if (_workerId >= 0) {
+            auto &own = _workers[_workerId];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.queue.empty()) {
+                job = own.queue.back();
+                own.queue.pop_back();
+                _pending--;
+                return true;
+            }
+        }
+
+        // stealing oldest tickets from other queues
+        const int first = _workerId >= 0 ? _workerId + 1 : 0;
+        for (int e = 0; e < numWorkers; e++) {
+            auto &victim = _workers[(first + e) % numWorkers];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.queue.empty()) {
+                job = victim.queue.front();
+                victim.queue.pop_front();
+                _pending--;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void ThreadPool::post(std::shared_ptr<Job> &job, int tickets) {
+        spawnWorkers(tickets > _maxThreads.load() - 1 ? tickets : _maxThreads.load() - 1);
+
+        const int numWorkers = _numWorkers.load();
+        for (int e = 0; e < tickets; e++) {
+            // workers keep tickets in own queue, so nested jobs stay local unless somebody is idle
+            const int target = _workerId >= 0 ? _workerId : (int) (_roundRobin++ % numWorkers);
+
+            auto &worker = _workers[target];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.queue.emplace_back(job);
+            _pending++;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+        }
+        _available.notify_all();
+    }
+
+    void ThreadPool::runChunks(Job &job) {
+        ShareGuard guard(job.share);
+
+        while (true) {
+            auto c = job.next.fetch_add(1);
+            if (c >= job.numChunks)
+                return;
+
+            auto start = job.start + c * job.chunk;
+            auto stop = start + job.chunk < job.stop ? start + job.chunk : job.stop;
+
+            try {
+                (*job.func)(start, stop);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(job.mutex);
+                if (!job.error)
+                    job.error = std::current_exception();
+            }
+
+            if (job.done.fetch_add(1) + 1 == job.numChunks) {
+                std::lock_guard<std::mutex> lock(job.mutex);
+                job.finished.notify_all();
+            }
+        }
+    }
+
+    int ThreadPool::effectiveThreads(Nd4jLong length, Nd4jLong grain, int maxThreads) {
+        int threads = _maxThreads.load();
+
+        if (_sessionLimit > 0 && _sessionLimit < threads)
+            threads = _sessionLimit;
+
+        if (maxThreads > 0 && maxThreads < threads)
+            threads = maxThreads;
+
+        if (grain < 1)
+            grain = 1;
+
+        // grain can't take parallelism below minimal number of threads, as long as every thread gets at least one iteration
+        auto chunks = (length + grain - 1) / grain;
+        if (chunks < threads) {
+            Nd4jLong lower = _minThreads.load();
+            if (lower > threads)
+                lower = threads;
+
+            if (lower > length)
+                lower = length;
+
+            threads = (int) (chunks > lower ? chunks : lower);
+        }
+
+        return threads < 1 ? 1 : threads;
+    }
+
+    void ThreadPool::parallel_for(const RangeFunction &func, Nd4jLong start, Nd4jLong stop, Nd4jLong grain, int maxThreads) {
+        if (stop <= start)
+            return;
+
+        if (grain < 1)
+            grain = 1;
+
+        const auto length = stop - start;
+        const int threads = effectiveThreads(length, grain, maxThreads);
+        if (threads <= 1) {
+            func(start, stop);
+            return;
+        }
+
+        auto job = std::make_shared<Job>();
+        job->func = &func;
+        job->start = start;
+        job->stop = stop;
+
+        // minimal number of threads might require chunks smaller than grain
+        const Nd4jLong perThread = (length + threads - 1) / threads;
+        if (grain > perThread)
+            grain = perThread;
+
+        Nd4jLong numChunks = (Nd4jLong) threads * POOL_CHUNKS_PER_THREAD;
+        job->chunk = (length + numChunks - 1) / numChunks;
+        if (job->chunk < grain)
+            job->chunk = grain;
+
+        job->numChunks = (length + job->chunk - 1) / job->chunk;
+
+        const int budget = _sessionLimit > 0 && _sessionLimit < _maxThreads.load() ? _sessionLimit : _maxThreads.load();
+        job->share = budget / threads > 1 ? budget / threads : 1;
+
+        post(job, threads - 1);
+
+        // caller takes part in execution
+        runChunks(*job);
+
+        // while other chunks are in progress we help with other tickets, that's what keeps nested calls deadlock-free
+        while (job->done.load() < job->numChunks) {
+            std::shared_ptr<Job> other;
+            if (takeTicket(other)) {
+                runChunks(*other);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(job->mutex);
+            job->finished.wait_for(lock, std::chrono::microseconds(100), [&] { return job->done.load() >= job->numChunks; });
+        }
+
+        if (job->error)
+            std::rethrow_exception(job->error);
+    }
+
+    nd4j::ThreadPool* nd4j::ThreadPool::_INSTANCE = 0;
+}
@@ -1104,6 +1104,9 @@ __device__ INLINEDEF Nd4jLong *cuMalloc(Nd4jLong *buffer, long size) {
     }
 
     INLINEDEF _CUDA_HD bool shapeEquals(const Nd4jLong *shapeInfo1, const Nd4jLong *shapeInfo2) {
+        if (shapeInfo1 == shapeInfo2)
+            return true;
+
         return shape::shapeEquals(shape::rank(shapeInfo1), shape::shapeOf(const_cast<Nd4jLong*>(shapeInfo1)), shape::rank(shapeInfo2), shape::shapeOf(const_cast<Nd4jLong*>(shapeInfo2)));
     }
 
@@ -2823,6 +2826,10 @@ template <typename T>
      * @return
      */
     INLINEDEF _CUDA_HD bool equalsStrict(const Nd4jLong *shapeA, const Nd4jLong *shapeB) {
+        // interned shapeInfo buffers are shared, so same pointer means same shape
+        if (shapeA == shapeB)
+            return true;
+
         if (shapeA[0] != shapeB[0])
             return false;
 
@@ -2841,7 +2848,10 @@ template <typename T>
 
 //////////////////////////////////////////////////////////////////////
 INLINEDEF _CUDA_HD bool haveSameShapeAndStrides(const Nd4jLong *shapeInfo1, const Nd4jLong *shapeInfo2) {
-        
+
+    if (shapeInfo1 == shapeInfo2)
+        return true;
+
     if (shapeInfo1[0] != shapeInfo2[0])
         return false;
 
@@ -2878,6 +2888,10 @@ INLINEDEF _CUDA_HD bool haveSameShapeAndStrides(const Nd4jLong *shapeInfo1, cons
      * @return
      */
     INLINEDEF _CUDA_HD bool equalsSoft(const Nd4jLong *shapeA, const Nd4jLong *shapeB) {
+        // interned shapeInfo buffers are shared, so same pointer means same shape
+        if (shapeA == shapeB)
+            return true;
+
         if (shapeA[0] != shapeB[0])
             return false;
 
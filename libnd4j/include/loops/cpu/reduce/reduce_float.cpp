@@ -46,7 +46,10 @@ namespace functions {
             const Nd4jLong length = shape::length(xShapeInfo);
             auto xEws = shape::elementWiseStride(xShapeInfo);
             
-            if (xEws > 0) {
+            if (nd4j::Environment::getInstance()->isDeterministic()) {
+                z[0] = OpType::postProcess(nd4j::ReductionFloatLoops<X,Z>::template loopReduceWhole<OpType>(x, xShapeInfo, extraParams), length, extraParams);
+            }
+            else if (xEws > 0) {
                 z[0] = execScalar<OpType>(x, xEws, length, extraParams);
             }
             else {
@@ -82,7 +85,10 @@ namespace functions {
                 const Nd4jLong length = shape::length(xShapeInfo);
                 int xEws = shape::elementWiseStride(xShapeInfo);
 
-                if (xEws > 0) {
+                if (nd4j::Environment::getInstance()->isDeterministic()) {
+                    return OpType::postProcess(nd4j::ReductionFloatLoops<X,Z>::template loopReduceWhole<OpType>(x, xShapeInfo, extraParams), length, extraParams);
+                }
+                else if (xEws > 0) {
                     return execScalar<OpType>(x, xEws, length, extraParams);
                 }
                 else {
@@ -49,7 +49,10 @@ namespace functions {
             const int rank = shape::rank(xShapeInfo);
 
 
-            if (xEws >= 1) {
+            if (nd4j::Environment::getInstance()->isDeterministic()) {
+                z[0] = OpType::postProcess(nd4j::ReductionSameLoops<X>::template loopReduceWhole<OpType>(x, xShapeInfo, extraParams), length, extraParams);
+            }
+            else if (xEws >= 1) {
                 z[0] = execScalar<OpType>(x, xEws, length, extraParams);
             }
             else {
@@ -87,7 +90,10 @@ namespace functions {
                 const Nd4jLong length = shape::length(xShapeInfo);
                 const auto xEws = shape::elementWiseStride(xShapeInfo);
 
-                if (xEws >= 1) {
+                if (nd4j::Environment::getInstance()->isDeterministic()) {
+                    return OpType::postProcess(nd4j::ReductionSameLoops<X>::template loopReduceWhole<OpType>(x, xShapeInfo, extraParams), length, extraParams);
+                }
+                else if (xEws >= 1) {
                     return execScalar<OpType>(x, xEws, length, extraParams);
                 }
                 else {
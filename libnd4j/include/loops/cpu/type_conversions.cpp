@@ -180,6 +180,96 @@ namespace nd4j {
         }
     }
 
+    template <typename T>
+    void TypeCast::encodeThresholdP1(void *dx, Nd4jLong N, int *dz, float threshold) {
+        auto x = reinterpret_cast<T *>(dx);
+        const T tt = static_cast<T>(threshold);
+        const Nd4jLong numBlocks = N / THRESHOLD_BLOCK_SIZE + (N % THRESHOLD_BLOCK_SIZE ? 1 : 0);
+
+        int total = 0;
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(reduction(+:total) if(N > Environment::getInstance()->elementwiseThreshold()))
+        for (Nd4jLong b = 0; b < numBlocks; b++) {
+            const Nd4jLong start = b * THRESHOLD_BLOCK_SIZE;
+            const Nd4jLong stop = nd4j::math::nd4j_min<Nd4jLong>(N, start + THRESHOLD_BLOCK_SIZE);
+
+            int cnt = 0;
+            for (Nd4jLong e = start; e < stop; e++)
+                if (nd4j::math::nd4j_abs<T>(x[e]) >= tt)
+                    cnt++;
+
+            dz[b + 1] = cnt;
+            total += cnt;
+        }
+
+        dz[0] = total;
+    }
+
+    void TypeCast::encodeThresholdP2(int *dx, Nd4jLong N, int *dz) {
+        // per-block counts follow the total stored by P1
+        auto x = dx + 1;
+
+        const int threads = OmpLaunchHelper::betterThreads(N);
+        const Nd4jLong span = OmpLaunchHelper::betterSpan(N, threads);
+        std::vector<int> partials(threads + 1, 0);
+
+        // local exclusive scans first, then every chunk is shifted by the sum of its predecessors
+        PRAGMA_OMP_PARALLEL_FOR_THREADS(threads)
+        for (int t = 0; t < threads; t++) {
+            const Nd4jLong start = span * t;
+            const Nd4jLong stop = nd4j::math::nd4j_min<Nd4jLong>(N, span * (t + 1));
+
+            int sum = 0;
+            for (Nd4jLong e = start; e < stop; e++) {
+                dz[e] = sum;
+                sum += x[e];
+            }
+            partials[t + 1] = sum;
+        }
+
+        for (int t = 1; t <= threads; t++)
+            partials[t] += partials[t - 1];
+
+        PRAGMA_OMP_PARALLEL_FOR_THREADS(threads)
+        for (int t = 1; t < threads; t++) {
+            const Nd4jLong start = span * t;
+            const Nd4jLong stop = nd4j::math::nd4j_min<Nd4jLong>(N, span * (t + 1));
+
+            for (Nd4jLong e = start; e < stop; e++)
+                dz[e] += partials[t];
+        }
+    }
+
+    template <typename T>
+    void TypeCast::encodeThresholdP3(void *dx, int *offsets, Nd4jLong N, int *dz) {
+        auto x = reinterpret_cast<T *>(dx);
+
+        FloatBits fb;
+        int limit = dz[0];
+        fb.i_ = dz[2];
+        float threshold = fb.f_;
+
+        const T tt = static_cast<T>(threshold);
+        const Nd4jLong numBlocks = N / THRESHOLD_BLOCK_SIZE + (N % THRESHOLD_BLOCK_SIZE ? 1 : 0);
+
+        // we use 4 as offset, since first 16 bytes are occupied with header
+        const int flimit = limit + 4;
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(N > Environment::getInstance()->elementwiseThreshold())
+        for (Nd4jLong b = 0; b < numBlocks; b++) {
+            const Nd4jLong start = b * THRESHOLD_BLOCK_SIZE;
+            const Nd4jLong stop = nd4j::math::nd4j_min<Nd4jLong>(N, start + THRESHOLD_BLOCK_SIZE);
+
+            int idx = offsets[b] + 4;
+            for (Nd4jLong e = start; e < stop && idx < flimit; e++) {
+                T value = x[e];
+                if (nd4j::math::nd4j_abs<T>(value) >= tt) {
+                    dz[idx++] = value > static_cast<T>(0.0f) ? e + 1 : -(e + 1);
+                    x[e] = value > static_cast<T>(0.0f) ? value - tt : value + tt;
+                }
+            }
+        }
+    }
+
     /**
      * This is cpu version, so leave it here as inline, to avoid templates instantiation
      *
@@ -221,6 +311,7 @@ namespace nd4j {
     template void TypeCast::convertFromThreshold<float>(Nd4jPointer * extras, void *dx, Nd4jLong N, void *dz);
     template void TypeCast::convertFromThreshold<float16>(Nd4jPointer * extras, void *dx, Nd4jLong N, void *dz);
     template void TypeCast::convertFromThreshold<double>(Nd4jPointer * extras, void *dx, Nd4jLong N, void *dz);
+    template void TypeCast::convertFromThreshold<bfloat16>(Nd4jPointer * extras, void *dx, Nd4jLong N, void *dz);
 
     template void TypeCast::convertToThreshold<float>(Nd4jPointer * extras, void *dx, Nd4jLong N, void *dz);
     template void TypeCast::convertToThreshold<float16>(Nd4jPointer * extras, void *dx, Nd4jLong N, void *dz);
@@ -234,6 +325,9 @@ namespace nd4j {
     template void TypeCast::convertToQuantized<float16>(Nd4jPointer * extras, void *dx, Nd4jLong N, void *dz);
     template void TypeCast::convertToQuantized<double>(Nd4jPointer * extras, void *dx, Nd4jLong N, void *dz);
 
+    BUILD_SINGLE_TEMPLATE(template void TypeCast::encodeThresholdP1, (void *dx, Nd4jLong N, int *dz, float threshold), FLOAT_TYPES);
+    BUILD_SINGLE_TEMPLATE(template void TypeCast::encodeThresholdP3, (void *dx, int *offsets, Nd4jLong N, int *dz), FLOAT_TYPES);
+
 #ifndef __CLION_IDE__
     BUILD_DOUBLE_TEMPLATE(template void TypeCast::convertGeneric, (Nd4jPointer * extras, void *dx, Nd4jLong N, void *dz), LIBND4J_TYPES, LIBND4J_TYPES)
 #endif
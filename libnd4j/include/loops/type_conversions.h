@@ -48,6 +48,9 @@
 #define NUM_BANKS 32
 #define LOG_NUM_BANKS 4
 
+// number of elements covered by one P1/P3 threshold encoder block, same as cuda blockDim
+#define THRESHOLD_BLOCK_SIZE 1024
+
 
 namespace nd4j {
 
@@ -69,6 +72,20 @@ namespace nd4j {
         template <typename T>
         static _CUDA_H void convertFromThreshold(Nd4jPointer * extras, void *dx, Nd4jLong N, void *dz);
 
+        /**
+         * Three-phase threshold encoder, block-wise like the cuda kernels:
+         * P1 stores the number of eligible elements at dz[0] and per-block counts at dz[1...],
+         * P2 turns these counts into exclusive per-block offsets,
+         * P3 writes encoded indices after the 4-int header and leaves residuals in dx
+         */
+        template <typename T>
+        static _CUDA_H void encodeThresholdP1(void *dx, Nd4jLong N, int *dz, float threshold);
+
+        static _CUDA_H void encodeThresholdP2(int *dx, Nd4jLong N, int *dz);
+
+        template <typename T>
+        static _CUDA_H void encodeThresholdP3(void *dx, int *offsets, Nd4jLong N, int *dz);
+
         static _CUDA_H Nd4jLong estimateQuantizedSize(Nd4jLong rawSize);
 
         template <typename T>
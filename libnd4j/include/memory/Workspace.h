@@ -55,18 +55,33 @@ namespace nd4j {
             Nd4jLong _initialSize = 0L;
             Nd4jLong _currentSize = 0L;
 
-            std::mutex _mutexAllocation;
-            std::mutex _mutexSpills;
-
             bool _externalized = false;
 
-            std::vector<void*> _spills;
+            // spilled allocations form lock-free list, each one is preceded by SpillHeader
+            struct SpillHeader {
+                SpillHeader* next;
+                Nd4jLong size;
+            };
+
+            std::atomic<SpillHeader*> _spills;
 
             std::atomic<Nd4jLong> _spillsSize;
             std::atomic<Nd4jLong> _cycleAllocations;
 
+            // growth policy: on scopeOut main buffer grows to high-water mark of the cycle multiplied by growth factor, but not above max size
+            double _growthFactor = 1.0;
+            Nd4jLong _maxSize = 0L;
+
+            // spill statistics, accumulated across cycles
+            std::atomic<Nd4jLong> _cycles;
+            std::atomic<Nd4jLong> _spilledCycles;
+            std::atomic<Nd4jLong> _totalSpills;
+            std::atomic<Nd4jLong> _peakAllocations;
+
             void init(Nd4jLong bytes);
             void freeSpills();
+
+            void* spillBytes(Nd4jLong numBytes);
         public:
             explicit Workspace(ExternalWorkspace *external);
             explicit Workspace(Nd4jLong initialSize = 0);
@@ -81,6 +96,23 @@ namespace nd4j {
             void expandBy(Nd4jLong numBytes);
             void expandTo(Nd4jLong numBytes);
 
+            /**
+             * These methods configure growth policy applied on scopeOut.
+             * Growth factor is applied to high-water mark of the cycle, max size of 0 means no limit.
+             */
+            void setGrowthFactor(double factor);
+            void setMaxSize(Nd4jLong numBytes);
+            double growthFactor();
+            Nd4jLong maxSize();
+
+            /**
+             * These methods return statistics collected across cycles
+             */
+            Nd4jLong getNumberOfCycles();
+            Nd4jLong getSpilledCycles();
+            Nd4jLong getTotalSpilledSize();
+            Nd4jLong getPeakSize();
+
 //            bool resizeSupported();
 
             void* allocateBytes(Nd4jLong numBytes);
@@ -41,8 +41,13 @@ namespace nd4j {
                 _initialSize = external->sizeHost();
                 _currentSize = external->sizeHost();
                 _offset = 0L;
+                _spills = nullptr;
                 this->_cycleAllocations = 0;
                 this->_spillsSize = 0;
+                this->_cycles = 0;
+                this->_spilledCycles = 0;
+                this->_totalSpills = 0;
+                this->_peakAllocations = 0;
 
                 _externalized = true;
             }
@@ -62,8 +67,13 @@ namespace nd4j {
             this->_initialSize = initialSize;
             this->_currentSize = initialSize;
             this->_offset = 0;
+            this->_spills = nullptr;
             this->_cycleAllocations = 0;
             this->_spillsSize = 0;
+            this->_cycles = 0;
+            this->_spilledCycles = 0;
+            this->_totalSpills = 0;
+            this->_peakAllocations = 0;
         }
 
         void Workspace::init(Nd4jLong bytes) {
@@ -92,13 +102,30 @@ namespace nd4j {
         void Workspace::freeSpills() {
             _spillsSize = 0;
 
-            if (_spills.size() < 1)
-                return;
+            auto header = _spills.exchange(nullptr);
+            while (header != nullptr) {
+                auto next = header->next;
+                free(header);
+                header = next;
+            }
+        }
+
+        void* Workspace::spillBytes(Nd4jLong numBytes) {
+            nd4j_debug("Allocating %lld bytes in spills\n", numBytes);
+
+            // header is padded, so returned pointer keeps malloc alignment
+            const Nd4jLong headerSize = 16;
+            auto header = reinterpret_cast<SpillHeader *>(malloc(numBytes + headerSize));
+
+            CHECK_ALLOC(header, "Failed to allocate new workspace");
+
+            header->size = numBytes;
+            header->next = _spills.load();
+            while (!_spills.compare_exchange_weak(header->next, header));
 
-            for (auto v:_spills)
-                free(v);
+            _spillsSize += numBytes;
 
-            _spills.clear();
+            return reinterpret_cast<char *>(header) + headerSize;
         }
 
         Workspace::~Workspace() {
@@ -127,35 +154,18 @@ namespace nd4j {
                 throw std::invalid_argument("Number of bytes for allocation should be positive");
             }
 
-            //numBytes += 32;
-            void* result = nullptr;
             this->_cycleAllocations += numBytes;
-            this->_mutexAllocation.lock();
 
-            if (_offset.load() + numBytes > _currentSize) {
-                nd4j_debug("Allocating %lld bytes in spills\n", numBytes);
-                this->_mutexAllocation.unlock();
+            // lock-free bump allocation: we just move offset forward, unless there's no space left
+            auto offset = _offset.load();
+            do {
+                if (offset + numBytes > _currentSize)
+                    return spillBytes(numBytes);
+            } while (!_offset.compare_exchange_weak(offset, offset + numBytes));
 
-                void *p = malloc(numBytes);
-
-                CHECK_ALLOC(p, "Failed to allocate new workspace");
-
-                _mutexSpills.lock();
-                _spills.push_back(p);
-                _mutexSpills.unlock();
-
-                _spillsSize += numBytes;
-
-                return p;
-            }
+            void* result = (void *)(_ptrHost + offset);
 
-            result = (void *)(_ptrHost + _offset.load());
-            _offset += numBytes;
-            //memset(result, 0, (int) numBytes);
-
-            nd4j_debug("Allocating %lld bytes from workspace; Current PTR: %p; Current offset: %lld\n", numBytes, result, _offset.load());
-
-            this->_mutexAllocation.unlock();
+            nd4j_debug("Allocating %lld bytes from workspace; Current PTR: %p; Current offset: %lld\n", numBytes, result, offset + numBytes);
 
             return result;
         }
@@ -172,6 +182,65 @@ namespace nd4j {
 
         void Workspace::scopeOut() {
             _offset = 0;
+
+            auto cycle = _cycleAllocations.load();
+            _cycleAllocations = 0;
+            _cycles++;
+
+            if (cycle > _peakAllocations.load())
+                _peakAllocations = cycle;
+
+            if (_spillsSize.load() > 0) {
+                _spilledCycles++;
+                _totalSpills += _spillsSize.load();
+            }
+
+            // everything allocated within this cycle is released now, so next cycle can use single buffer without spills
+            freeSpills();
+
+            auto target = static_cast<Nd4jLong>(cycle * _growthFactor);
+            if (_maxSize > 0 && target > _maxSize)
+                target = _maxSize;
+
+            if (target > _currentSize) {
+                nd4j_debug("Growing workspace from %lld to %lld bytes\n", _currentSize, target);
+                init(target);
+            }
+        }
+
+        void Workspace::setGrowthFactor(double factor) {
+            if (factor < 1.0)
+                throw std::invalid_argument("Workspace growth factor can't be less than 1.0");
+
+            _growthFactor = factor;
+        }
+
+        void Workspace::setMaxSize(Nd4jLong numBytes) {
+            _maxSize = numBytes;
+        }
+
+        double Workspace::growthFactor() {
+            return _growthFactor;
+        }
+
+        Nd4jLong Workspace::maxSize() {
+            return _maxSize;
+        }
+
+        Nd4jLong Workspace::getNumberOfCycles() {
+            return _cycles.load();
+        }
+
+        Nd4jLong Workspace::getSpilledCycles() {
+            return _spilledCycles.load();
+        }
+
+        Nd4jLong Workspace::getTotalSpilledSize() {
+            return _totalSpills.load();
+        }
+
+        Nd4jLong Workspace::getPeakSize() {
+            return _peakAllocations.load();
         }
 
         Nd4jLong Workspace::getSpilledSize() {
@@ -187,7 +256,11 @@ namespace nd4j {
 
         Workspace* Workspace::clone() {
             // for clone we take whatever is higher: current allocated size, or allocated size of current loop
-            return new Workspace(nd4j::math::nd4j_max<Nd4jLong >(this->getCurrentSize(), this->_cycleAllocations.load()));
+            auto clone = new Workspace(nd4j::math::nd4j_max<Nd4jLong >(this->getCurrentSize(), this->_cycleAllocations.load()));
+            clone->_growthFactor = _growthFactor;
+            clone->_maxSize = _maxSize;
+
+            return clone;
         }
     }
 }
@@ -0,0 +1,75 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_LEGACYFUSEDOP_H
+#define LIBND4J_LEGACYFUSEDOP_H
+
+#include <ops/declarable/LegacyOp.h>
+#include <graph/generated/utils_generated.h>
+
+namespace nd4j {
+    namespace ops {
+        /**
+        *   This class describes one legacy op within fused chain
+        */
+        class ND4J_EXPORT FusedStep {
+        public:
+            nd4j::graph::OpType _opType;
+            int _opNum;
+
+            // index of op input used as Y operand, -1 if there's no such operand
+            int _operand = -1;
+
+            // scalar value, used by scalar ops without Y operand
+            double _scalar = 0.0;
+
+            std::vector<double> _extras;
+            std::vector<int> _dimensions;
+
+            FusedStep(nd4j::graph::OpType opType, int opNum);
+
+            /**
+             * This method returns TRUE if given legacy op type can be used as part of fused chain
+             */
+            static bool isFusable(nd4j::graph::OpType opType);
+        };
+
+        /**
+        *   This class provides wrapper for chains of elementwise legacy ops (transform, scalar, pairwise and broadcast),
+        *   i.e. z = tanh(x * y + 2). Whole chain is applied within single pass over memory, without intermediate arrays.
+        *
+        *   Input 0 is X operand of the first op in chain, other inputs are Y operands referenced by steps.
+        */
+        class ND4J_EXPORT LegacyFusedOp : public LegacyOp {
+        protected:
+            std::vector<FusedStep> _steps;
+
+            Nd4jStatus validateAndExecute(Context& block);
+
+            void execSequential(NDArray *x, std::vector<NDArray*> &operands, NDArray *z, nd4j::memory::Workspace *workspace);
+        public:
+            LegacyFusedOp(const std::vector<FusedStep> &steps, int numInputs);
+
+            std::vector<FusedStep>* steps();
+
+            ShapeList* calculateOutputShape(ShapeList* inputShape, nd4j::graph::Context& block);
+            virtual LegacyOp* clone();
+        };
+    }
+}
+
+
+#endif //LIBND4J_LEGACYFUSEDOP_H
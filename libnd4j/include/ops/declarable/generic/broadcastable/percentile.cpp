@@ -33,7 +33,7 @@ CUSTOM_OP_IMPL(percentile, 1, 1, false, 1, -2) {
     auto output = OUTPUT_VARIABLE(0);                                            // [bS, oD, oH, oW, iC] (NDHWC) or [bS, iC, oD, oH, oW] (NCDHW)
 
     const auto q = T_ARG(0);                                                             // percentile
-    const int interpolation = block.getTArguments()->size() > 1 ? T_ARG(1) : 2.;     // 0-"lower", 1-"higher", 2-"nearest"(default)
+    const int interpolation = block.getTArguments()->size() > 1 ? T_ARG(1) : 2.;     // 0-"lower", 1-"higher", 2-"nearest"(default), 3-"linear"
     const int keepDims = block.getTArguments()->size() > 2 ? T_ARG(2) : 0.;          // false is default
 
     const int axisArrRank = block.getIArguments()->size();
@@ -41,7 +41,7 @@ CUSTOM_OP_IMPL(percentile, 1, 1, false, 1, -2) {
 
     REQUIRE_TRUE(inputArrRank > 0, 0, "PERCENTILE OP: rank of input array must be positive (>0), but got %i instead !", inputArrRank);
     REQUIRE_TRUE(0.f <= q && q <= 100.f, 0, "PERCENTILE OP: percentile parameter must be within [0, 100] range, but got %f instead !", q);
-    REQUIRE_TRUE(interpolation == 0 || interpolation == 1 || interpolation == 2, 0, "PERCENTILE OP: the correct values for interpolation parameter are 0, 1, 2, but got %i instead !", interpolation);
+    REQUIRE_TRUE(interpolation >= 0 && interpolation <= 3, 0, "PERCENTILE OP: the correct values for interpolation parameter are 0, 1, 2, 3, but got %i instead !", interpolation);
     REQUIRE_TRUE(axisArrRank <= inputArrRank, 0, "PERCENTILE OP: the rank of axis array must be <= rank of input array, but got %i and %i correspondingly !", axisArrRank, inputArrRank);
 
     for(int i = 0; i < axisArrRank; ++i) {
@@ -24,6 +24,7 @@
 #include <ops/declarable/helpers/col2im.h>
 #include <NDArrayFactory.h>
 #include <MmulHelper.h>
+#include <helpers/ThreadPool.h>
 
 namespace nd4j {
 namespace ops  {
@@ -572,6 +573,318 @@ void ConvolutionUtils::getMKLDNNMemoryDescConv3d(
 }
 #endif
 
+//////////////////////////////////////////////////////////////////////////
+// accumulation type of native convolution kernels, half-precision types are accumulated in fp32
+template <typename T>
+struct ConvAccumulator {
+    typedef T type;
+};
+
+template <>
+struct ConvAccumulator<float16> {
+    typedef float type;
+};
+
+template <>
+struct ConvAccumulator<bfloat16> {
+    typedef float type;
+};
+
+// im2col block streamed into gemm is sized to stay in L2 cache
+#define CONV_COL_BLOCK_BYTES (512 * 1024)
+#define CONV_COL_BLOCK_MIN_ROWS 32
+
+// Winograd is used for 3x3 stride-1 convolutions once iC*oC products are large enough to amortize transforms,
+// F(4x4, 3x3) additionally needs big enough output to fill its tiles
+#define WINOGRAD_MIN_CHANNELS 16
+#define WINOGRAD_4X4_MIN_CHANNELS 256
+
+//////////////////////////////////////////////////////////////////////////
+// Winograd F(m x m, 3 x 3) transform matrices, see A. Lavin, S. Gray "Fast Algorithms for Convolutional Neural Networks"
+static const double winogradBT2[16] = { 1,  0, -1,  0,
+                                        0,  1,  1,  0,
+                                        0, -1,  1,  0,
+                                        0,  1,  0, -1};
+
+static const double winogradG2[12]  = { 1.,   0.,   0.,
+                                        0.5,  0.5,  0.5,
+                                        0.5, -0.5,  0.5,
+                                        0.,   0.,   1.};
+
+static const double winogradAT2[8]  = { 1,  1,  1,  0,
+                                        0,  1, -1, -1};
+
+static const double winogradBT4[36] = { 4,  0, -5,  0,  1,  0,
+                                        0, -4, -4,  1,  1,  0,
+                                        0,  4, -4, -1,  1,  0,
+                                        0, -2, -1,  2,  1,  0,
+                                        0,  2, -1, -2,  1,  0,
+                                        0,  4,  0, -5,  0,  1};
+
+static const double winogradG4[18]  = { 1./4,    0.,      0.,
+                                       -1./6,   -1./6,   -1./6,
+                                       -1./6,    1./6,   -1./6,
+                                        1./24,   1./12,   1./6,
+                                        1./24,  -1./12,   1./6,
+                                        0.,      0.,      1.};
+
+static const double winogradAT4[24] = { 1,  1,  1,  1,  1,  0,
+                                        0,  1, -1,  2, -2,  0,
+                                        0,  1,  1,  4,  4,  0,
+                                        0,  1, -1,  8, -8,  1};
+
+//////////////////////////////////////////////////////////////////////////
+// dst[rows x rows] = L[rows x n] * src[n x n] * L^T, tmp must hold rows*n elements
+template <typename T>
+static FORCEINLINE void winogradTransform(const T* L, const int rows, const int n, const T* src, T* tmp, T* dst) {
+
+    for (int i = 0; i < rows; ++i)
+        for (int j = 0; j < n; ++j) {
+            T sum = static_cast<T>(0);
+            for (int k = 0; k < n; ++k)
+                sum += L[i * n + k] * src[k * n + j];
+            tmp[i * n + j] = sum;
+        }
+
+    for (int i = 0; i < rows; ++i)
+        for (int j = 0; j < rows; ++j) {
+            T sum = static_cast<T>(0);
+            for (int k = 0; k < n; ++k)
+                sum += tmp[i * n + k] * L[j * n + k];
+            dst[i * rows + j] = sum;
+        }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 3x3 stride-1 convolution via Winograd F(m x m, 3 x 3), m = 2 or 4; bias is added while storing output
+template <typename X, typename Y>
+static void conv2dWinograd_(const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int m, const int pH, const int pW, const int isNCHW) {
+
+    typedef typename ConvAccumulator<Y>::type T;
+
+    int bS, iC, iH, iW, oC, oH, oW;                             // batch size, input channels, input height/width, output channels, output height/width;
+    int indIOioC, indIiH, indWoC, indWiC, indWkH, indOoH;       // corresponding indexes
+    ConvolutionUtils::getSizesAndIndexesConv2d(isNCHW, *input, *output, bS, iC, iH, iW, oC, oH, oW, indIOioC, indIiH, indWiC, indWoC, indWkH, indOoH);
+
+    const int a  = m + 2;                                       // size of input tile
+    const int a2 = a * a;
+
+    T bt[36], g[18], at[24];
+    for (int i = 0; i < a2; ++i)
+        bt[i] = static_cast<T>(m == 2 ? winogradBT2[i] : winogradBT4[i]);
+    for (int i = 0; i < 3 * a; ++i)
+        g[i]  = static_cast<T>(m == 2 ? winogradG2[i]  : winogradG4[i]);
+    for (int i = 0; i < m * a; ++i)
+        at[i] = static_cast<T>(m == 2 ? winogradAT2[i] : winogradAT4[i]);
+
+    // transformed weights, [a*a, iC, oC]
+    std::vector<T> U(static_cast<size_t>(a2) * iC * oC);
+    ThreadPool::getInstance()->parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+        T w[9], tmp[18], u[36];
+        for (auto ic = start; ic < stop; ++ic)
+            for (int oc = 0; oc < oC; ++oc) {
+                for (int kh = 0; kh < 3; ++kh)
+                    for (int kw = 0; kw < 3; ++kw)
+                        w[kh * 3 + kw] = weights->e<T>(kh, kw, ic, oc);
+
+                winogradTransform<T>(g, a, 3, w, tmp, u);
+
+                for (int xi = 0; xi < a2; ++xi)
+                    U[(static_cast<size_t>(xi) * iC + ic) * oC + oc] = u[xi];
+            }
+    }, 0, iC);
+
+    std::vector<T> biasT(oC, static_cast<T>(0));
+    if (bias != nullptr)
+        for (int oc = 0; oc < oC; ++oc)
+            biasT[oc] = bias->e<T>(oc);
+
+    const X* x = input->bufferAsT<X>();
+    Y* z = output->bufferAsT<Y>();
+    const Nd4jLong xStrB = input->stridesOf()[0],  xStrC = input->stridesOf()[indIOioC],  xStrH = input->stridesOf()[indIiH],  xStrW = input->stridesOf()[indIiH + 1];
+    const Nd4jLong zStrB = output->stridesOf()[0], zStrC = output->stridesOf()[indIOioC], zStrH = output->stridesOf()[indOoH], zStrW = output->stridesOf()[indOoH + 1];
+
+    const int tH = (oH + m - 1) / m;
+    const int tW = (oW + m - 1) / m;
+
+    ThreadPool::getInstance()->parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+        std::vector<T> V(static_cast<size_t>(a2) * iC);
+        std::vector<T> M(static_cast<size_t>(a2) * oC);
+        T d[36], tmp[36], v[36], y[16];
+
+        for (auto t = start; t < stop; ++t) {
+            const int b  = t / (tH * tW);
+            const int th = (t / tW) % tH;
+            const int tw = t % tW;
+            const int h0 = th * m - pH;
+            const int w0 = tw * m - pW;
+            const X* xB = x + b * xStrB;
+
+            // input tile transform, padding is zero
+            for (int ic = 0; ic < iC; ++ic) {
+                for (int i = 0; i < a; ++i) {
+                    const int ih = h0 + i;
+                    for (int j = 0; j < a; ++j) {
+                        const int iw = w0 + j;
+                        if (static_cast<unsigned>(ih) < static_cast<unsigned>(iH) && static_cast<unsigned>(iw) < static_cast<unsigned>(iW))
+                            d[i * a + j] = static_cast<T>(xB[ic * xStrC + ih * xStrH + iw * xStrW]);
+                        else
+                            d[i * a + j] = static_cast<T>(0);
+                    }
+                }
+
+                winogradTransform<T>(bt, a, a, d, tmp, v);
+
+                for (int xi = 0; xi < a2; ++xi)
+                    V[xi * iC + ic] = v[xi];
+            }
+
+            // a*a independent [1, iC] x [iC, oC] products
+            for (int xi = 0; xi < a2; ++xi) {
+                T* mRow = M.data() + xi * oC;
+                const T* uXi = U.data() + static_cast<size_t>(xi) * iC * oC;
+
+                for (int oc = 0; oc < oC; ++oc)
+                    mRow[oc] = static_cast<T>(0);
+
+                for (int ic = 0; ic < iC; ++ic) {
+                    const T vVal = V[xi * iC + ic];
+                    const T* uRow = uXi + ic * oC;
+                    PRAGMA_OMP_SIMD
+                    for (int oc = 0; oc < oC; ++oc)
+                        mRow[oc] += vVal * uRow[oc];
+                }
+            }
+
+            // output tile transform, tiles on bottom/right border are cropped
+            for (int oc = 0; oc < oC; ++oc) {
+                for (int xi = 0; xi < a2; ++xi)
+                    v[xi] = M[xi * oC + oc];
+
+                winogradTransform<T>(at, m, a, v, tmp, y);
+
+                for (int i = 0; i < m && th * m + i < oH; ++i)
+                    for (int j = 0; j < m && tw * m + j < oW; ++j)
+                        z[b * zStrB + oc * zStrC + (th * m + i) * zStrH + (tw * m + j) * zStrW] = static_cast<Y>(y[i * m + j] + biasT[oc]);
+            }
+        }
+    }, 0, (Nd4jLong) bS * tH * tW);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// gemm over raw buffers, BLAS is used when all operands have same float/double type
+static FORCEINLINE void convGemm(const nd4j::DataType aType, const nd4j::DataType bType, const nd4j::DataType cType, const char cOrder, const bool transA, const bool transB, const int M, const int N, const int K, const void* A, const int lda, const void* B, const int ldb, void* C, const int ldc, const double beta = 0.) {
+    if (aType == bType && bType == cType)
+        MmulHelper::blasGemm(cType, cOrder, transA, transB, M, N, K, 1., A, lda, B, ldb, beta, C, ldc);
+    else
+        MmulHelper::gemm(aType, bType, cType, cOrder, transA, transB, M, N, K, 1., A, lda, B, ldb, beta, C, ldc);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// fills one row of channels-last columns [kH, kW, iC] for given output pixel (flat index over bS*oH*oW), padding is zero
+// such rows match c-ordered weights [kH, kW, iC, oC], input is read through strides so any layout works
+template <typename X>
+static FORCEINLINE void im2colRow(const NDArray* input, X* colRow, const Nd4jLong pixel, const int oH, const int oW, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int isNCHW) {
+
+    const int iC = input->sizeAt(isNCHW ? 1 : 3);
+    const int iH = input->sizeAt(isNCHW ? 2 : 1);
+    const int iW = input->sizeAt(isNCHW ? 3 : 2);
+    const Nd4jLong* strides = input->stridesOf();
+    const Nd4jLong xStrC = strides[isNCHW ? 1 : 3], xStrH = strides[isNCHW ? 2 : 1], xStrW = strides[isNCHW ? 3 : 2];
+
+    const Nd4jLong oHW = (Nd4jLong) oH * oW;
+    const int b  = pixel / oHW;
+    const int oh = (pixel % oHW) / oW;
+    const int ow = pixel % oW;
+    const X* xB = input->bufferAsT<X>() + b * strides[0];
+
+    for (int kh = 0; kh < kH; ++kh) {
+        const int ih = oh * sH - pH + kh * dH;
+        for (int kw = 0; kw < kW; ++kw) {
+            const int iw = ow * sW - pW + kw * dW;
+            X* dst = colRow + (kh * kW + kw) * iC;
+
+            if (static_cast<unsigned>(ih) < static_cast<unsigned>(iH) && static_cast<unsigned>(iw) < static_cast<unsigned>(iW)) {
+                const X* src = xB + ih * xStrH + iw * xStrW;
+                for (int ic = 0; ic < iC; ++ic)
+                    dst[ic] = src[ic * xStrC];
+            }
+            else
+                for (int ic = 0; ic < iC; ++ic)
+                    dst[ic] = static_cast<X>(0);
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 1x1 stride-1 convolution without padding is plain gemm over input buffer, no columns are needed
+// input and output must be contiguous c-ordered arrays
+template <typename X, typename Y>
+static void conv2d1x1_(const NDArray* input, const NDArray* weights, NDArray* output, const int bS, const int iC, const int oC, const int oHW, const int isNCHW) {
+
+    NDArray* w = weights->ordering() == 'c' && weights->ews() == 1 ? const_cast<NDArray*>(weights) : const_cast<NDArray*>(weights)->dup('c');     // [iC, oC]
+
+    const X* x = input->bufferAsT<X>();
+    Y* z = output->bufferAsT<Y>();
+
+    if(!isNCHW)
+        convGemm(input->dataType(), w->dataType(), output->dataType(), 'c', false, false, bS * oHW, oC, iC, x, iC, w->getBuffer(), oC, z, oC);    // [bS*oH*oW, iC] x [iC, oC] = [bS*oH*oW, oC]
+    else
+        for (int b = 0; b < bS; ++b)        // [iC, oH*oW] is seen as f-ordered [oH*oW, iC], output [oC, oH*oW] is f-ordered [oH*oW, oC]
+            convGemm(input->dataType(), w->dataType(), output->dataType(), 'f', false, true, oHW, oC, iC, x + (Nd4jLong) b * iC * oHW, oHW, w->getBuffer(), oC, z + (Nd4jLong) b * oC * oHW, oHW);
+
+    if(w != weights)
+        delete w;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// im2col is done for blocks of output pixels which fit into cache, every block goes through gemm straight into output
+// output must be contiguous c-ordered array
+template <typename X, typename Y>
+static void conv2dTiledIm2col_(const NDArray* input, const NDArray* weights, NDArray* output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int isNCHW) {
+
+    int bS, iC, iH, iW, oC, oH, oW;                             // batch size, input channels, input height/width, output channels, output height/width;
+    int indIOioC, indIiH, indWoC, indWiC, indWkH, indOoH;       // corresponding indexes
+    ConvolutionUtils::getSizesAndIndexesConv2d(isNCHW, *input, *output, bS, iC, iH, iW, oC, oH, oW, indIOioC, indIiH, indWiC, indWoC, indWkH, indOoH);
+
+    NDArray* w = weights->ordering() == 'c' && weights->ews() == 1 ? const_cast<NDArray*>(weights) : const_cast<NDArray*>(weights)->dup('c');     // [kH*kW*iC, oC]
+
+    const int K = kH * kW * iC;
+    const Nd4jLong oHW = (Nd4jLong) oH * oW;
+
+    // NHWC output is one [bS*oH*oW, oC] matrix, NCHW output is bS f-ordered [oH*oW, oC] matrices
+    const Nd4jLong pixels = isNCHW ? oHW : bS * oHW;
+    const int images = isNCHW ? bS : 1;
+
+    Nd4jLong blockRows = CONV_COL_BLOCK_BYTES / (K * sizeof(X));
+    blockRows = nd4j::math::nd4j_min<Nd4jLong>(pixels, nd4j::math::nd4j_max<Nd4jLong>(CONV_COL_BLOCK_MIN_ROWS, blockRows));
+    const Nd4jLong blocksPerImage = (pixels + blockRows - 1) / blockRows;
+
+    Y* z = output->bufferAsT<Y>();
+
+    ThreadPool::getInstance()->parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+        // plain array rather than vector, since bool input is allowed here
+        std::unique_ptr<X[]> col(new X[blockRows * K]);
+
+        for (auto t = start; t < stop; ++t) {
+            const int img = t / blocksPerImage;
+            const Nd4jLong r0 = (t % blocksPerImage) * blockRows;
+            const int rows = nd4j::math::nd4j_min<Nd4jLong>(blockRows, pixels - r0);
+
+            for (int r = 0; r < rows; ++r)
+                im2colRow<X>(input, col.get() + (Nd4jLong) r * K, img * oHW + r0 + r, oH, oW, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW);
+
+            if(!isNCHW)
+                convGemm(input->dataType(), w->dataType(), output->dataType(), 'c', false, false, rows, oC, K, col.get(), K, w->getBuffer(), oC, z + r0 * oC, oC);
+            else
+                convGemm(input->dataType(), w->dataType(), output->dataType(), 'f', true, true, rows, oC, K, col.get(), K, w->getBuffer(), oC, z + img * oC * oHW + r0, oHW);
+        }
+    }, 0, images * blocksPerImage);
+
+    if(w != weights)
+        delete w;
+}
+
 //////////////////////////////////////////////////////////////////////////
 template <typename X, typename Y>
 static void conv2d_(nd4j::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int isSameMode, const int isNCHW) {
@@ -678,6 +991,26 @@ static void conv2d_(nd4j::graph::Context& block, const NDArray* input, const NDA
 #endif
     nd4j_debug("MKL-DNN is not used for conv2d!\n", 0);
 
+    const bool isOutputContiguous = output->ordering() == 'c' && output->ews() == 1;
+
+    if(kH == 3 && kW == 3 && sH == 1 && sW == 1 && dH == 1 && dW == 1 && iC * oC >= WINOGRAD_MIN_CHANNELS) {
+        // F(4x4, 3x3) does 4x less multiplications than direct convolution, F(2x2, 3x3) does 2.25x less but is more precise
+        const int m = oH >= 8 && oW >= 8 && iC * oC >= WINOGRAD_4X4_MIN_CHANNELS ? 4 : 2;
+        conv2dWinograd_<X, Y>(input, weights, bias, output, m, pH, pW, isNCHW);
+        return;
+    }
+
+    if(isOutputContiguous) {
+        if(kH == 1 && kW == 1 && sH == 1 && sW == 1 && pH == 0 && pW == 0 && input->ordering() == 'c' && input->ews() == 1)
+            conv2d1x1_<X, Y>(input, weights, output, bS, iC, oC, oH * oW, isNCHW);
+        else
+            conv2dTiledIm2col_<X, Y>(input, weights, output, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW);
+
+        if(bias)
+            helpers::addBias(*output, *bias, isNCHW);
+        return;
+    }
+
     std::vector<int> permutForOutput;
     if(!isNCHW)
         input = input->permute({0, 3, 1, 2});                                       // [bS, iH, iW, iC] -> [bS, iC, iH, iW] if NHWC
@@ -712,6 +1045,99 @@ static void conv2d_(nd4j::graph::Context& block, const NDArray* input, const NDA
     delete colP;
 }
 
+//////////////////////////////////////////////////////////////////////////
+// channels-last conv2d backprop: columns are built for cache-sized blocks of output pixels, never for whole batch
+// gradO must be contiguous c-ordered array, all arrays have same data type
+template <typename T>
+static void conv2dBPChannelsLast_(const NDArray* input, const NDArray* weights, const NDArray* gradO, NDArray* gradI, NDArray* gradW, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW) {
+
+    int bS, iC, iH, iW, oC, oH, oW;                             // batch size, input channels, input height/width, output channels, output height/width;
+    int indIOioC, indIiH, indWoC, indWiC, indWkH, indOoH;       // corresponding indexes
+    ConvolutionUtils::getSizesAndIndexesConv2d(false, *input, *gradO, bS, iC, iH, iW, oC, oH, oW, indIOioC, indIiH, indWiC, indWoC, indWkH, indOoH);
+
+    const int K = kH * kW * iC;
+    const Nd4jLong oHW = (Nd4jLong) oH * oW;
+    const auto type = input->dataType();
+    const T* gO = gradO->bufferAsT<T>();
+
+    const Nd4jLong blockRows = nd4j::math::nd4j_max<Nd4jLong>(CONV_COL_BLOCK_MIN_ROWS, CONV_COL_BLOCK_BYTES / (K * sizeof(T)));
+
+    // ----- gradW = columns^T x gradO, accumulated block after block ----- //
+    if(gradW) {
+        NDArray* gW = gradW->ordering() == 'c' && gradW->ews() == 1 ? gradW : gradW->dup('c');     // [kH*kW*iC, oC]
+
+        const Nd4jLong pixels = bS * oHW;
+        const Nd4jLong rowsPerBlock = nd4j::math::nd4j_min<Nd4jLong>(blockRows, pixels);
+        std::unique_ptr<T[]> col(new T[rowsPerBlock * K]);
+
+        for (Nd4jLong r0 = 0; r0 < pixels; r0 += rowsPerBlock) {
+            const int rows = nd4j::math::nd4j_min<Nd4jLong>(rowsPerBlock, pixels - r0);
+
+            ThreadPool::getInstance()->parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+                for (auto r = start; r < stop; ++r)
+                    im2colRow<T>(input, col.get() + r * K, r0 + r, oH, oW, kH, kW, sH, sW, pH, pW, dH, dW, false);
+            }, 0, rows);
+
+            convGemm(type, type, type, 'c', true, false, K, oC, rows, col.get(), K, gO + r0 * oC, oC, gW->getBuffer(), oC, r0 == 0 ? 0. : 1.);
+        }
+
+        if(gW != gradW) {
+            gradW->assign(gW);
+            delete gW;
+        }
+    }
+
+    // ----- gradI: columns = gradO x weights^T, then col2im ----- //
+    if(gradI) {
+        NDArray* w = weights->ordering() == 'c' && weights->ews() == 1 ? const_cast<NDArray*>(weights) : const_cast<NDArray*>(weights)->dup('c');     // [kH*kW*iC, oC]
+
+        const Nd4jLong rowsPerBlock = nd4j::math::nd4j_min<Nd4jLong>(blockRows, oHW);
+        const Nd4jLong gStrB = gradI->stridesOf()[0], gStrH = gradI->stridesOf()[1], gStrW = gradI->stridesOf()[2], gStrC = gradI->stridesOf()[3];
+        T* gI = gradI->bufferAsT<T>();
+
+        gradI->nullify();
+
+        // every thread takes whole images, so col2im scatter of different threads never overlaps
+        ThreadPool::getInstance()->parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+            std::unique_ptr<T[]> col(new T[rowsPerBlock * K]);
+
+            for (auto b = start; b < stop; ++b) {
+                for (Nd4jLong r0 = 0; r0 < oHW; r0 += rowsPerBlock) {
+                    const int rows = nd4j::math::nd4j_min<Nd4jLong>(rowsPerBlock, oHW - r0);
+
+                    convGemm(type, type, type, 'c', false, true, rows, K, oC, gO + (b * oHW + r0) * oC, oC, w->getBuffer(), oC, col.get(), K);
+
+                    for (int r = 0; r < rows; ++r) {
+                        const int oh = (r0 + r) / oW;
+                        const int ow = (r0 + r) % oW;
+                        const T* colRow = col.get() + (Nd4jLong) r * K;
+
+                        for (int kh = 0; kh < kH; ++kh) {
+                            const int ih = oh * sH - pH + kh * dH;
+                            if (static_cast<unsigned>(ih) >= static_cast<unsigned>(iH))
+                                continue;
+
+                            for (int kw = 0; kw < kW; ++kw) {
+                                const int iw = ow * sW - pW + kw * dW;
+                                if (static_cast<unsigned>(iw) >= static_cast<unsigned>(iW))
+                                    continue;
+
+                                T* dst = gI + b * gStrB + ih * gStrH + iw * gStrW;
+                                const T* src = colRow + (kh * kW + kw) * iC;
+                                for (int ic = 0; ic < iC; ++ic)
+                                    dst[ic * gStrC] += src[ic];
+                            }
+                        }
+                    }
+                }
+            }
+        }, 0, bS);
+
+        if(w != weights)
+            delete w;
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
 template <typename X, typename Y>
 static void conv2dBP_(nd4j::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, const NDArray* gradO, NDArray* gradI, NDArray* gradW, NDArray* gradB, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int isSameMode, const int isNCHW) {
@@ -892,23 +1318,11 @@ static void conv2dBP_(nd4j::graph::Context& block, const NDArray* input, const N
 
     std::vector<int> gradOaxesForDot;
 
-    if(!isNCHW) {
-        input = input->permute({0, 3, 1, 2});                                   // [bS, iH, iW, iC] -> [bS, iC, iH, iW]
-        gradI = gradI->permute({0, 3, 1, 2});                                   // [bS, iH, iW, iC] -> [bS, iC, iH, iW]
+    if(!isNCHW)
         gradOaxesForDot  = {0, 1, 2};                                           // bS, oH, oW
-    }
     else
         gradOaxesForDot  = {0, 2, 3};                                           // bS, oH, oW
 
-    NDArray columns(input->ordering(), {bS, iC, kH, kW, oH, oW}, input->dataType(), input->getWorkspace());
-
-    // ----- calculation of gradW ----- //
-    if(gradW) {
-        graph::LaunchContext ctx;
-        helpers::im2col(ctx, *input, columns, kH, kW, sH, sW, pH, pW, dH, dW, NDArrayFactory::create(0.f, input->getWorkspace()));   // [bS, iC, iH, iW] is convoluted to [bS, iC, kH, kW, oH, oW]
-        nd4j::MmulHelper::tensorDot(&columns, gradO, gradW, {0,4,5}, gradOaxesForDot, {2, 0, 1, 3});       // [bS, iC, kH, kW, oH, oW] x [bS, oH, oW, oC]/[bS, oC, oH, oW] = [iC, kH, kW, oC]
-    }
-
     // ----- calculation of gradB ----- //
     if(gradB) {
         NDArray* gradBR = gradB;
@@ -919,6 +1333,27 @@ static void conv2dBP_(nd4j::graph::Context& block, const NDArray* input, const N
             delete gradBR;
     }
 
+    // NHWC is processed as is, without permutation into channels-first layout
+    const auto xType = input->dataType();
+    if(!isNCHW && gradO->ordering() == 'c' && gradO->ews() == 1 && weights->dataType() == xType && gradO->dataType() == xType && (gradW == nullptr || gradW->dataType() == xType) && (gradI == nullptr || gradI->dataType() == xType)) {
+        conv2dBPChannelsLast_<X>(input, weights, gradO, gradI, gradW, kH, kW, sH, sW, pH, pW, dH, dW);
+        return;
+    }
+
+    if(!isNCHW) {
+        input = input->permute({0, 3, 1, 2});                                   // [bS, iH, iW, iC] -> [bS, iC, iH, iW]
+        gradI = gradI->permute({0, 3, 1, 2});                                   // [bS, iH, iW, iC] -> [bS, iC, iH, iW]
+    }
+
+    NDArray columns(input->ordering(), {bS, iC, kH, kW, oH, oW}, input->dataType(), input->getWorkspace());
+
+    // ----- calculation of gradW ----- //
+    if(gradW) {
+        graph::LaunchContext ctx;
+        helpers::im2col(ctx, *input, columns, kH, kW, sH, sW, pH, pW, dH, dW, NDArrayFactory::create(0.f, input->getWorkspace()));   // [bS, iC, iH, iW] is convoluted to [bS, iC, kH, kW, oH, oW]
+        nd4j::MmulHelper::tensorDot(&columns, gradO, gradW, {0,4,5}, gradOaxesForDot, {2, 0, 1, 3});       // [bS, iC, kH, kW, oH, oW] x [bS, oH, oW, oC]/[bS, oC, oH, oW] = [iC, kH, kW, oC]
+    }
+
     //----- calculation of gradI -----//
     nd4j::MmulHelper::tensorDot(weights, gradO, &columns, {indWoC}, {indIOioC}, {2, 3, 1, 0, 4, 5});  // [kH, kW, iC, oC]/[oC, iC, kH, kW]] x [bS, oH, oW, oC]/[bS, oC, oH, oW] = [kH, kW, iC, bS, oH, oW]
     graph::LaunchContext ctx;
@@ -955,37 +1390,71 @@ static void depthwiseConv2d_(const NDArray* input, const NDArray* weights, const
     ConvolutionUtils::getSizesAndIndexesConv2d(isNCHW, *input, *output, bS, iC, iH, iW, oC, oH, oW, indIOioC, indIiH, indWiC, indWmC, indWkH, indOoH);
     mC = weights->sizeAt(indWmC);                           // channels multiplier
 
-    std::vector<std::vector<Nd4jLong>> modifColumns = {{1,0,4,5,2,3}, {iC,bS*oH*oW,kH*kW}};  // [bS,iC,kH,kW,oH,oW] -> [iC,bS,oH,oW,kH,kW] -> [iC,bS*oH*oW,kH*kW]
-    std::vector<std::vector<Nd4jLong>> modifOutput;
-    std::vector<Nd4jLong> outReShape;
-
-    if(!isNCHW) {
-        input = input->permute({0, 3, 1, 2});                                           // [bS,iH,iW,iC]    -> [bS,iC,iH,iW]
-        outReShape = {bS, oH, oW, iC, mC};                                              // [bS,oH,oW,iC*mC] -> [bS,oH,oW,iC,mC]
-        modifOutput = {{3,0,1,2,4},{iC, bS*oH*oW, mC}};                                 // [bS,oH,oW,iC,mC] -> [iC,bS,oH,oW,mC] -> [iC,bS*oH*oW,mC]
-    }
-    else {
-        outReShape = {bS, iC, mC, oH, oW};                                              // [bS,iC*mC,oH,oW] -> [bS,iC,mC,oH,oW]
-        modifOutput = {{1,0,3,4,2},{iC, bS*oH*oW, mC}};                                 // [bS,iC,mC,oH,oW] -> [iC,bS,oH,oW,mC] -> [iC,bS*oH*oW,mC]
-    }
-
     if(isSameMode)                       // SAME
         ConvolutionUtils::calcPadding2D(pH, pW, oH, oW, iH, iW, kH, kW, sH, sW, dH, dW);
 
-    NDArray columns(input->ordering(), {bS, iC, kH, kW, oH, oW}, input->dataType(), input->getWorkspace());
-    NDArray* outputReshaped = output->reshape(output->ordering(), outReShape);
+    typedef typename ConvAccumulator<Y>::type T;
 
-    graph::LaunchContext ctx;
-    helpers::im2col(ctx, *input, columns, kH, kW, sH, sW, pH, pW, dH, dW, NDArrayFactory::create(0.f, input->getWorkspace()));  // [bS, iC, iH, iW] is convoluted to [bS, iC, kH, kW, oH, oW]
-    MmulHelper::tensorDot(&columns, weights, outputReshaped, modifColumns, {{2,0,1,3},{iC,kH*kW,mC}}, modifOutput);              // [iC, bS*oH*oW, kW*kH] x [iC, kH*kW, mC] = [iC, bS*oH*oW, mC]
+    // direct kernel: every input pixel is read once per kernel tap, channels multipliers are accumulated in place, no columns are needed
+    std::vector<T> w(static_cast<size_t>(kH) * kW * iC * mC);
+    for (int kh = 0; kh < kH; ++kh)
+        for (int kw = 0; kw < kW; ++kw)
+            for (int ic = 0; ic < iC; ++ic)
+                for (int m = 0; m < mC; ++m)
+                    w[((kh * kW + kw) * iC + ic) * mC + m] = weights->e<T>(kh, kw, ic, m);
 
+    std::vector<T> biasT(oC, static_cast<T>(0));
     if(bias)
-        output->applyBroadcast(broadcast::Add, {indIOioC}, bias);
-
-    if(!isNCHW)
-        delete input;
+        for (int oc = 0; oc < oC; ++oc)
+            biasT[oc] = bias->e<T>(oc);
+
+    const X* x = input->bufferAsT<X>();
+    Y* z = output->bufferAsT<Y>();
+    const Nd4jLong xStrB = input->stridesOf()[0],  xStrC = input->stridesOf()[indIOioC],  xStrH = input->stridesOf()[indIiH],  xStrW = input->stridesOf()[indIiH + 1];
+    const Nd4jLong zStrB = output->stridesOf()[0], zStrC = output->stridesOf()[indIOioC], zStrH = output->stridesOf()[indOoH], zStrW = output->stridesOf()[indOoH + 1];
+
+    ThreadPool::getInstance()->parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+        std::vector<T> acc(oC);
+
+        for (auto t = start; t < stop; ++t) {
+            const int b  = t / oH;
+            const int oh = t % oH;
+            const X* xB = x + b * xStrB;
+
+            for (int ow = 0; ow < oW; ++ow) {
+                for (int oc = 0; oc < oC; ++oc)
+                    acc[oc] = biasT[oc];
+
+                for (int kh = 0; kh < kH; ++kh) {
+                    const int ih = oh * sH - pH + kh * dH;
+                    if (static_cast<unsigned>(ih) >= static_cast<unsigned>(iH))
+                        continue;
+
+                    for (int kw = 0; kw < kW; ++kw) {
+                        const int iw = ow * sW - pW + kw * dW;
+                        if (static_cast<unsigned>(iw) >= static_cast<unsigned>(iW))
+                            continue;
+
+                        const X* src = xB + ih * xStrH + iw * xStrW;
+                        const T* wK = w.data() + (kh * kW + kw) * iC * mC;
+
+                        for (int ic = 0; ic < iC; ++ic) {
+                            const T xVal = static_cast<T>(src[ic * xStrC]);
+                            const T* wRow = wK + ic * mC;
+                            T* aRow = acc.data() + ic * mC;
+                            PRAGMA_OMP_SIMD
+                            for (int m = 0; m < mC; ++m)
+                                aRow[m] += xVal * wRow[m];
+                        }
+                    }
+                }
 
-    delete outputReshaped;
+                Y* zP = z + b * zStrB + oh * zStrH + ow * zStrW;
+                for (int oc = 0; oc < oC; ++oc)
+                    zP[oc * zStrC] = static_cast<Y>(acc[oc]);
+            }
+        }
+    }, 0, (Nd4jLong) bS * oH);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -1112,36 +1581,36 @@ template <typename T>
 static void upsampling2d_(const NDArray& input, NDArray& output, const int factorH, const int factorW, const bool isNCHW) {
     // input  has shape [bS, iC, iH, iW] (NCHW) or [bS, iH, iW, iC] (NHWC) 
     // output has shape [bS, iC, factorH*iH, factorW*iW ] (NCHW) or [bS, factorH*iH, factorW*iW, iC] (NHWC)
-    
-    std::vector<Nd4jLong> indIn  = {0,0,  0,0,  0,0,  0,0};
-    std::vector<Nd4jLong> indOut = {0,0,  0,0,  0,0,  0,0};
-    const int dimIH = isNCHW ? 2 : 1;    
-    const int j0 = 2*dimIH;
-    const int j1 = j0+1, j2 = j0+2, j3 = j0+3;
-    const int size0 = input.sizeAt(dimIH) * input.sizeAt(dimIH+1);
-    // const int size1 = factorH * factorW;
 
-    int iT = input.sizeAt(dimIH);
-    int iH = input.sizeAt(dimIH + 1);
+    const int dimIH = isNCHW ? 2 : 1;
+    const int dimIC = isNCHW ? 1 : 3;
 
-    PRAGMA_OMP_PARALLEL_FOR_ARGS(collapse(2) firstprivate(indIn, indOut))
-    for(int ih = 0; ih < iT; ++ih) {
-        for(int iw = 0; iw < iH; ++iw) {
-            indIn[j0] = ih; indIn[j1] = ih+1; 
-            indIn[j2] = iw; indIn[j3] = iw+1; 
+    const int bS = input.sizeAt(0);
+    const int iC = input.sizeAt(dimIC);
+    const int oH = output.sizeAt(dimIH);
+    const int oW = output.sizeAt(dimIH + 1);
 
-            for(int fh = 0; fh < factorH; ++fh) {
-                for(int fw = 0; fw < factorW; ++fw) {
-                    
-                    indOut[j0] = ih * factorH + fh; indOut[j1] = indOut[j0] + 1; 
-                    indOut[j2] = iw * factorW + fw; indOut[j3] = indOut[j2] + 1;                     
-                    auto i = input(indIn);
-                    auto o = output(indOut);
-                    o.assign(i);
-                }
+    const Nd4jLong xStrB = input.stridesOf()[0],  xStrC = input.stridesOf()[dimIC],  xStrH = input.stridesOf()[dimIH],  xStrW = input.stridesOf()[dimIH + 1];
+    const Nd4jLong zStrB = output.stridesOf()[0], zStrC = output.stridesOf()[dimIC], zStrH = output.stridesOf()[dimIH], zStrW = output.stridesOf()[dimIH + 1];
+
+    const T* x = input.bufferAsT<T>();
+    T* z = output.bufferAsT<T>();
+
+    // channels are innermost loop, so NHWC is copied with unit stride
+    ThreadPool::getInstance()->parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+        for (auto t = start; t < stop; ++t) {
+            const int b  = t / oH;
+            const int oh = t % oH;
+
+            for (int ow = 0; ow < oW; ++ow) {
+                const T* pX = x + b * xStrB + (oh / factorH) * xStrH + (ow / factorW) * xStrW;
+                T* pZ = z + b * zStrB + oh * zStrH + ow * zStrW;
+
+                for (int c = 0; c < iC; ++c)
+                    pZ[c * zStrC] = pX[c * xStrC];
             }
         }
-    }
+    }, 0, (Nd4jLong) bS * oH);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -1191,39 +1660,43 @@ template <typename T>
 static void upsampling2dBP_(const NDArray& gradO, NDArray& gradI, const bool isNCHW) {
     // gradO has shape [bS, iC, factorH*iH, factorW*iW ] (NCHW) or [bS, factorH*iH, factorW*iW, iC] (NHWC)
     // gradI has shape [bS, iC, iH, iW] (NCHW) or [bS, iH, iW, iC] (NHWC)     
-    std::vector<Nd4jLong> indIn  = {0,0,  0,0,  0,0,  0,0};
-    std::vector<Nd4jLong> indOut = {0,0,  0,0,  0,0,  0,0};
-    const int dimIH = isNCHW ? 2 : 1;    
-    const int factorH = gradO.sizeAt(dimIH)   / gradI.sizeAt(dimIH);
-    const int factorW = gradO.sizeAt(dimIH+1) / gradI.sizeAt(dimIH+1);
-    const int j0 = 2*dimIH;
-    const int j1 = j0+1, j2 = j0+2, j3 = j0+3;
-    const int size0 = gradI.sizeAt(dimIH) * gradI.sizeAt(dimIH+1);
-
-    int l0 = gradI.sizeAt(dimIH);
-    int l1 = gradI.sizeAt(dimIH + 1);
 
-    PRAGMA_OMP_PARALLEL_FOR_ARGS(collapse(2) firstprivate(indIn, indOut))
-    for(int ih = 0; ih < l0; ++ih) {
-        for(int iw = 0; iw < l1; ++iw) {
-            indIn[j0] = ih; indIn[j1] = ih+1; 
-            indIn[j2] = iw; indIn[j3] = iw+1; 
-            NDArray subGradI = gradI(indIn);
-
-            for(int fh = 0; fh < factorH; ++fh) {
-                for(int fw = 0; fw < factorW; ++fw) {                    
-                    indOut[j0] = ih * factorH + fh; indOut[j1] = indOut[j0] + 1; 
-                    indOut[j2] = iw * factorW + fw; indOut[j3] = indOut[j2] + 1;                     
-                    auto o = gradO(indOut);
-                    if(!fh && !fw) {                        
-                        subGradI.assign(o);
+    const int dimIH = isNCHW ? 2 : 1;
+    const int dimIC = isNCHW ? 1 : 3;
+
+    const int bS = gradI.sizeAt(0);
+    const int iC = gradI.sizeAt(dimIC);
+    const int iH = gradI.sizeAt(dimIH);
+    const int iW = gradI.sizeAt(dimIH + 1);
+    const int factorH = gradO.sizeAt(dimIH)   / iH;
+    const int factorW = gradO.sizeAt(dimIH+1) / iW;
+
+    const Nd4jLong oStrB = gradO.stridesOf()[0], oStrC = gradO.stridesOf()[dimIC], oStrH = gradO.stridesOf()[dimIH], oStrW = gradO.stridesOf()[dimIH + 1];
+    const Nd4jLong iStrB = gradI.stridesOf()[0], iStrC = gradI.stridesOf()[dimIC], iStrH = gradI.stridesOf()[dimIH], iStrW = gradI.stridesOf()[dimIH + 1];
+
+    const T* gO = gradO.bufferAsT<T>();
+    T* gI = gradI.bufferAsT<T>();
+
+    ThreadPool::getInstance()->parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+        for (auto t = start; t < stop; ++t) {
+            const int b  = t / iH;
+            const int ih = t % iH;
+
+            for (int iw = 0; iw < iW; ++iw) {
+                T* pI = gI + b * iStrB + ih * iStrH + iw * iStrW;
+
+                for (int c = 0; c < iC; ++c)
+                    pI[c * iStrC] = static_cast<T>(0.f);
+
+                for (int fh = 0; fh < factorH; ++fh)
+                    for (int fw = 0; fw < factorW; ++fw) {
+                        const T* pO = gO + b * oStrB + (ih * factorH + fh) * oStrH + (iw * factorW + fw) * oStrW;
+                        for (int c = 0; c < iC; ++c)
+                            pI[c * iStrC] += pO[c * oStrC];
                     }
-                    else
-                        subGradI += o;
-                }
             }
         }
-    }
+    }, 0, (Nd4jLong) bS * iH);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -1390,6 +1863,99 @@ void ConvolutionUtils::getMKLDNNMemoryDescPool3d(
 }
 #endif
 
+//////////////////////////////////////////////////////////////////////////
+// pooling for channels-last arrays (NHWC seen as [bS, iC, iH, iW] view), channels are innermost loop
+template <typename T>
+static void pooling2dChannelsLast_(const NDArray& input, NDArray& output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int poolingMode, const int extraParam0) {
+
+    const T* in = input.bufferAsT<T>();
+    T* out = output.bufferAsT<T>();
+
+    const int bS = input.sizeAt(0);
+    const int iC = input.sizeAt(1);
+    const int iH = input.sizeAt(2);
+    const int iW = input.sizeAt(3);
+    const int oH = output.sizeAt(2);
+    const int oW = output.sizeAt(3);
+
+    const Nd4jLong iStride0 = input.stridesOf()[0],  iStride1 = input.stridesOf()[1],  iStride2 = input.stridesOf()[2],  iStride3 = input.stridesOf()[3];
+    const Nd4jLong oStride0 = output.stridesOf()[0], oStride1 = output.stridesOf()[1], oStride2 = output.stridesOf()[2], oStride3 = output.stridesOf()[3];
+
+    const int kHEff = kH + (kH-1)*(dH-1);
+    const int kWEff = kW + (kW-1)*(dW-1);
+    const T pNorm = static_cast<T>(extraParam0);
+
+    ThreadPool::getInstance()->parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+        std::unique_ptr<T[]> acc(new T[iC]);
+
+        for (auto t = start; t < stop; ++t) {
+            const int b  = t / oH;
+            const int oh = t % oH;
+
+            for (int ow = 0; ow < oW; ++ow) {
+
+                int hstart = oh * sH - pH;
+                int wstart = ow * sW - pW;
+                int hend = hstart + kHEff;
+                int wend = wstart + kWEff;
+
+                if(hstart < 0)
+                    hstart += dH * ((-hstart + dH - 1) / dH);
+                if(wstart < 0)
+                    wstart += dW * ((-wstart + dW - 1) / dW);
+                if(hend > iH)
+                    hend -= dH * ((hend - iH + dH - 1) / dH);
+                if(wend > iW)
+                    wend -= dW * ((wend - iW + dW - 1) / dW);
+
+                const T init = poolingMode == 0 ? -DataTypeUtils::max<T>() : static_cast<T>(0.f);
+                for (int c = 0; c < iC; ++c)
+                    acc[c] = init;
+
+                for (int ih = hstart; ih < hend; ih += dH)
+                    for (int iw = wstart; iw < wend; iw += dW) {
+                        const T* pIn = in + b * iStride0 + ih * iStride2 + iw * iStride3;
+
+                        if(poolingMode == 0) {
+                            for (int c = 0; c < iC; ++c)
+                                if (pIn[c * iStride1] > acc[c])
+                                    acc[c] = pIn[c * iStride1];
+                        }
+                        else if(poolingMode == 1) {
+                            PRAGMA_OMP_SIMD
+                            for (int c = 0; c < iC; ++c)
+                                acc[c] += pIn[c * iStride1];
+                        }
+                        else {
+                            for (int c = 0; c < iC; ++c)
+                                acc[c] += nd4j::math::nd4j_pow<T,T,T>(nd4j::math::nd4j_abs<T>(pIn[c * iStride1]), pNorm);
+                        }
+                    }
+
+                if(poolingMode == 1) {
+                    if (extraParam0 == 0) {             //Exclude padding
+                        const int taken = ((hend - hstart + dH - 1) / dH) * ((wend - wstart + dW - 1) / dW);
+                        for (int c = 0; c < iC; ++c)
+                            acc[c] /= taken;
+                    }
+                    else if (extraParam0 == 1) {        //Include padding
+                        for (int c = 0; c < iC; ++c)
+                            acc[c] /= kH * kW;
+                    }
+                }
+                else if(poolingMode == 2) {
+                    for (int c = 0; c < iC; ++c)
+                        acc[c] = nd4j::math::nd4j_pow<T,T,T>(acc[c], static_cast<T>((T)1.f) / pNorm);
+                }
+
+                T* pOut = out + b * oStride0 + oh * oStride2 + ow * oStride3;
+                for (int c = 0; c < iC; ++c)
+                    pOut[c * oStride1] = acc[c];
+            }
+        }
+    }, 0, (Nd4jLong) bS * oH);
+}
+
 //////////////////////////////////////////////////////////////////////////
 template <typename T>
 static void pooling2d_(nd4j::graph::Context& block, const NDArray& input, NDArray& output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int poolingMode, const int extraParam0) {
@@ -1480,6 +2046,12 @@ static void pooling2d_(nd4j::graph::Context& block, const NDArray& input, NDArra
     const Nd4jLong iStep3   = dW*iStride3;    
     const int kProd         = kH*kW;
 
+    // NHWC input comes here as permuted view, it is pooled in place rather than channel by channel
+    if(iStride1 == 1 && oStride1 == 1 && iC > 1 && poolingMode >= 0 && poolingMode <= 2) {
+        pooling2dChannelsLast_<T>(input, output, kH, kW, sH, sW, pH, pW, dH, dW, poolingMode, extraParam0);
+        return;
+    }
+
     Nd4jLong hstart, wstart, hend, wend;
     T *pIn;
 
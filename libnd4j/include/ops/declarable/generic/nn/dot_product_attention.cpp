@@ -23,6 +23,7 @@
 
 #include <ops/declarable/CustomOperations.h>
 #include <ops/declarable/helpers/reverse.h>
+#include <helpers/AttentionHelper.h>
 
 
 namespace nd4j {
@@ -35,15 +36,7 @@ namespace ops  {
         auto mask    = block.width() > 3 ? INPUT_VARIABLE(3) : nullptr;
 
         auto output = OUTPUT_VARIABLE(0);
-        NDArray* weights;
         bool outputWeights = INT_ARG(1);
-        if(outputWeights){
-            weights = OUTPUT_VARIABLE(1);
-        }else{
-            auto weightShape = ShapeUtils::evalShapeForMatmul(keys->getShapeInfo(), queries->getShapeInfo(), true, false);
-            weights = new NDArray('c', weightShape, values->dataType(), block.workspace());
-        }
-
         int normalization = INT_ARG(0);
 
         REQUIRE_TRUE(queries->rankOf() == keys->rankOf() && keys->rankOf() == values->rankOf(), 0,
@@ -67,6 +60,20 @@ namespace ops  {
                 "dot_product_attention: Keys and Values must have the same timestep length. "
                 "But got keys = %i, values = %i", keys->sizeAt(-1), values->sizeAt(-1));
 
+        // attention weights are only materialized when they are requested as output
+        if(!outputWeights && AttentionHelper::canFuseAttention({queries, keys, values, output})) {
+            AttentionHelper::dotProductAttention(queries, keys, values, mask, normalization, output);
+            return Status::OK();
+        }
+
+        NDArray* weights;
+        if(outputWeights){
+            weights = OUTPUT_VARIABLE(1);
+        }else{
+            auto weightShape = ShapeUtils::evalShapeForMatmul(keys->getShapeInfo(), queries->getShapeInfo(), true, false);
+            weights = new NDArray('c', weightShape, values->dataType(), block.workspace());
+        }
+
         nd4j::ops::matmul mmul;
         mmul.execute({keys, queries}, {weights}, {}, {1}, {});
         if(normalization) {
@@ -162,6 +169,10 @@ namespace ops  {
                      "dot_product_attention: Keys and Values must have the same timestep length. "
                      "But got keys = %i, values = %i", keys->sizeAt(-1), values->sizeAt(-1));
 
+        if(AttentionHelper::canFuseAttention({queries, keys, values, eps, dLdq, dLdk, dLdv})) {
+            AttentionHelper::dotProductAttentionBp(queries, keys, values, eps, mask, normalization, dLdq, dLdk, dLdv);
+            return Status::OK();
+        }
 
         double factor;
         if(normalization)
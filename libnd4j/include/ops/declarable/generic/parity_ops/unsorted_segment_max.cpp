@@ -36,9 +36,7 @@ namespace nd4j {
             REQUIRE_TRUE(helpers::unsortedSegmentIndicesValidate(idxSegments, numOfClasses, wrong), 0, "unsorted_segment_max: segment indices should be in range [0, %i), but %i > %i",
                     numOfClasses, wrong, numOfClasses);
 
-            helpers::unsortedSegmentMaxFunctor(input, idxSegments, numOfClasses, segmentedOutput);
-
-            return ND4J_STATUS_OK;
+            return helpers::unsortedSegmentMaxFunctor(input, idxSegments, numOfClasses, segmentedOutput);
         }
         DECLARE_TYPES(unsorted_segment_max) {
             getOpDescriptor()
@@ -37,9 +37,7 @@ namespace nd4j {
             REQUIRE_TRUE(helpers::unsortedSegmentIndicesValidate(idxSegments, numOfClasses, wrong), 0, "unsorted_segment_mean: segment indices should be in range [0, %i), but %i > %i",
                     numOfClasses, wrong, numOfClasses);
 
-            helpers::unsortedSegmentMeanFunctor(input, idxSegments, numOfClasses, segmentedOutput);
-
-            return ND4J_STATUS_OK;
+            return helpers::unsortedSegmentMeanFunctor(input, idxSegments, numOfClasses, segmentedOutput);
         }
         DECLARE_TYPES(unsorted_segment_mean) {
             getOpDescriptor()
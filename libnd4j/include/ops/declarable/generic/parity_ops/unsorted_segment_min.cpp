@@ -36,9 +36,7 @@ namespace nd4j {
             REQUIRE_TRUE(helpers::unsortedSegmentIndicesValidate(idxSegments, numOfClasses, wrong), 0, "unsorted_segment_min: segment indices should be in range [0, %i), but %i > %i",
                     numOfClasses, wrong, numOfClasses);
 
-            helpers::unsortedSegmentMinFunctor(input, idxSegments, numOfClasses, segmentedOutput);
-
-            return ND4J_STATUS_OK;
+            return helpers::unsortedSegmentMinFunctor(input, idxSegments, numOfClasses, segmentedOutput);
         }
 
         DECLARE_SHAPE_FN(unsorted_segment_min) {
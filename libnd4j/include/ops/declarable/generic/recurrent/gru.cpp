@@ -115,6 +115,73 @@ DECLARE_SHAPE_FN(gru) {
 }   
 
 
+
+//////////////////////////////////////////////////////////////////////////
+CUSTOM_OP_IMPL(gru_bp, 6, 5, false, 0, 0) {
+    auto x    = INPUT_VARIABLE(0);                  // input [time x bS x iS]
+    auto h0   = INPUT_VARIABLE(1);                  // initial cell output (at time step = 0) [bS x nU]
+    auto Wx   = INPUT_VARIABLE(2);                  // input-to-hidden  weights, [iS x 3*nU]
+    auto Wh   = INPUT_VARIABLE(3);                  // hidden-to-hidden weights, [nU x 3*nU]
+    auto b    = INPUT_VARIABLE(4);                  // biases, [3*nU]
+    auto dLdh = INPUT_VARIABLE(5);                  // gradient wrt cell outputs, [time x bS x nU], that is epsilon_next
+
+    auto dLdx  = OUTPUT_VARIABLE(0);                // gradient wrt x,  [time x bS x iS], that is epsilon
+    auto dLdh0 = OUTPUT_VARIABLE(1);                // gradient wrt h0, [bS x nU]
+    auto dLdWx = OUTPUT_VARIABLE(2);                // gradient wrt Wx, [iS x 3*nU]
+    auto dLdWh = OUTPUT_VARIABLE(3);                // gradient wrt Wh, [nU x 3*nU]
+    auto dLdb  = OUTPUT_VARIABLE(4);                // gradient wrt b,  [3*nU]
+
+    const int time = x->sizeAt(0);
+    const int bS   = x->sizeAt(1);
+    const int iS   = x->sizeAt(2);
+    const int nU   = h0->sizeAt(1);
+
+    const std::string h0Shape          = ShapeUtils::shapeAsString(h0);
+    const std::string h0CorrectShape   = ShapeUtils::shapeAsString({bS, nU});
+    const std::string wxShape          = ShapeUtils::shapeAsString(Wx);
+    const std::string wxCorrectShape   = ShapeUtils::shapeAsString({iS, 3*nU});
+    const std::string whShape          = ShapeUtils::shapeAsString(Wh);
+    const std::string whCorrectShape   = ShapeUtils::shapeAsString({nU, 3*nU});
+    const std::string bShape           = ShapeUtils::shapeAsString(b);
+    const std::string bCorrectShape    = ShapeUtils::shapeAsString({3*nU});
+    const std::string dLdhShape        = ShapeUtils::shapeAsString(dLdh);
+    const std::string dLdhCorrectShape = ShapeUtils::shapeAsString({time, bS, nU});
+
+    REQUIRE_TRUE(h0Shape   == h0CorrectShape,   0, "GRU_BP operation: wrong shape of previous cell output array, expected is %s, but got %s instead !", h0CorrectShape.c_str(), h0Shape.c_str());
+    REQUIRE_TRUE(wxShape   == wxCorrectShape,   0, "GRU_BP operation: wrong shape of input-to-hidden weights array, expected is %s, but got %s instead !", wxCorrectShape.c_str(), wxShape.c_str());
+    REQUIRE_TRUE(whShape   == whCorrectShape,   0, "GRU_BP operation: wrong shape of hidden-to-hidden weights array, expected is %s, but got %s instead !", whCorrectShape.c_str(), whShape.c_str());
+    REQUIRE_TRUE(bShape    == bCorrectShape,    0, "GRU_BP operation: wrong shape of biases array, expected is %s, but got %s instead !", bCorrectShape.c_str(), bShape.c_str());
+    REQUIRE_TRUE(dLdhShape == dLdhCorrectShape, 0, "GRU_BP operation: wrong shape of dLdh array (epsilon_next), expected is %s, but got %s instead !", dLdhCorrectShape.c_str(), dLdhShape.c_str());
+
+    helpers::gruTimeLoopBP(x, h0, Wx, Wh, b, dLdh, dLdx, dLdh0, dLdWx, dLdWh, dLdb);
+
+    return Status::OK();
+}
+
+        DECLARE_TYPES(gru_bp) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes(nd4j::DataType::ANY)
+                    ->setAllowedOutputTypes({ALL_FLOATS});
+        }
+
+DECLARE_SHAPE_FN(gru_bp) {
+    auto xShapeInfo  = inputShape->at(0);                           // [time x bS x iS]
+    auto h0ShapeInfo = inputShape->at(1);                           // [bS x nU]
+    auto WxShapeInfo = inputShape->at(2);                           // [iS x 3*nU]
+    auto WhShapeInfo = inputShape->at(3);                           // [nU x 3*nU]
+    auto bShapeInfo  = inputShape->at(4);                           // [3*nU]
+
+    Nd4jLong *dLdxShapeInfo(nullptr), *dLdh0ShapeInfo(nullptr), *dLdWxShapeInfo(nullptr), *dLdWhShapeInfo(nullptr), *dLdbShapeInfo(nullptr);
+    COPY_SHAPE(xShapeInfo,  dLdxShapeInfo);
+    COPY_SHAPE(h0ShapeInfo, dLdh0ShapeInfo);
+    COPY_SHAPE(WxShapeInfo, dLdWxShapeInfo);
+    COPY_SHAPE(WhShapeInfo, dLdWhShapeInfo);
+    COPY_SHAPE(bShapeInfo,  dLdbShapeInfo);
+
+    return SHAPELIST(dLdxShapeInfo, dLdh0ShapeInfo, dLdWxShapeInfo, dLdWhShapeInfo, dLdbShapeInfo);
+}
+
+
 }
 }
 
@@ -389,6 +389,10 @@ namespace nd4j {
         DECLARE_CUSTOM_OP(gru, 5, 1, false, 0, 0);
         #endif
 
+        #if NOT_EXCLUDED(OP_gru)
+        DECLARE_CUSTOM_OP(gru_bp, 6, 5, false, 0, 0);
+        #endif
+
     //////////////////////////////////////////////////////////////////////////
     /**
        * Implementation of operation "static RNN time sequences" with peep hole connections:
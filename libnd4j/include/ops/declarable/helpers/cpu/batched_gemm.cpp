@@ -22,6 +22,9 @@
 #include <types/float16.h>
 #include <ops/declarable/helpers/batched_gemm.h>
 #include <helpers/BlasHelper.h>
+#include <helpers/MmulHelper.h>
+#include <Environment.h>
+#include <helpers/ThreadPool.h>
 
 
 namespace nd4j {
@@ -29,6 +32,9 @@ namespace nd4j {
         namespace helpers {
         
 
+            // per-problem work (M * N * K) below which batch items are spread over threads instead of splitting each gemm
+            static const Nd4jLong BGEMM_BATCH_PARALLEL_THRESHOLD = 262144;
+
             template <typename T>
             void __bgemm(std::vector<NDArray*>& vA, std::vector<NDArray*>& vB, std::vector<NDArray*>& vC, NDArray* alphas, NDArray* betas, int transA, int transB, int M, int N, int K, int ldA, int ldB, int ldC) {
                 int batchSize = vA.size();
@@ -58,6 +64,15 @@ namespace nd4j {
                     shape::fill(tldC, ldC, batchSize);
                     shape::fill(tsize, 1, batchSize);
 
+                    // all problems share M/N/K here, so with uniform scalars they go to blas as a single group
+                    bool uniform = true;
+                    for (int e = 1; e < batchSize && uniform; e++)
+                        uniform = alphas->e<double>(e) == alphas->e<double>(0) && betas->e<double>(e) == betas->e<double>(0);
+
+                    int groupCount = uniform ? 1 : batchSize;
+                    if (uniform)
+                        tsize[0] = batchSize;
+
                     std::vector<T*> buffersA(batchSize);
                     std::vector<T*> buffersB(batchSize);
                     std::vector<T*> buffersC(batchSize);
@@ -69,9 +84,9 @@ namespace nd4j {
                     }
 
                     if (std::is_same<T, double>::value) {
-                        BlasHelper::getInstance()->dgemmBatched()(CblasColMajor, tA, tB, tM, tN, tK, (double *) alphas->buffer(), (double **) buffersA.data(), tldA, (double **) buffersB.data(), tldB, (double *) betas->buffer(),(double **)  buffersC.data(), tldC, vA.size(), tsize);
+                        BlasHelper::getInstance()->dgemmBatched()(CblasColMajor, tA, tB, tM, tN, tK, (double *) alphas->buffer(), (double **) buffersA.data(), tldA, (double **) buffersB.data(), tldB, (double *) betas->buffer(),(double **)  buffersC.data(), tldC, groupCount, tsize);
                     } else if (std::is_same<T, float >::value) {
-                        BlasHelper::getInstance()->sgemmBatched()(CblasColMajor, tA, tB, tM, tN, tK, (float *) alphas->buffer(), (float **) buffersA.data(), tldA, (float **) buffersB.data(), tldB, (float *) betas->buffer(), (float **) buffersC.data(), tldC, vA.size(), tsize);
+                        BlasHelper::getInstance()->sgemmBatched()(CblasColMajor, tA, tB, tM, tN, tK, (float *) alphas->buffer(), (float **) buffersA.data(), tldA, (float **) buffersB.data(), tldB, (float *) betas->buffer(), (float **) buffersC.data(), tldC, groupCount, tsize);
                     }
 
                     // release temporary arrays
@@ -88,27 +103,30 @@ namespace nd4j {
                     CBLAS_TRANSPOSE tA = (CBLAS_TRANSPOSE) transA;
                     CBLAS_TRANSPOSE tB = (CBLAS_TRANSPOSE) transB;
 
-                    int vaSize = vA.size();
-
-                    PRAGMA_OMP_PARALLEL_FOR
-                    for (int p = 0; p < vaSize; ++p) {
-                        auto A = reinterpret_cast<T*>(vA.at(p)->buffer());
-                        auto B = reinterpret_cast<T*>(vB.at(p)->buffer());
-                        auto C = reinterpret_cast<T*>(vC.at(p)->buffer());
-                        auto alpha = alphas->e<T>(p);
-                        auto beta = betas->e<T>(p);
-                        for (int m = 0; m < M; ++m) {
-                            for (int n = 0; n < N; ++n) {
-                                T c_mnp = 0;
-
-                                PRAGMA_OMP_SIMD
-                                for (int k = 0; k < K; ++k)
-                                    c_mnp += A[tA == CblasNoTrans ? (m + k * ldA) : (m * ldA + k)] * B[tB == CblasNoTrans ? (k + n * ldB) : (k * ldB + n)];
-
-                                C[m + n * ldC] = alpha * c_mnp + beta * C[m + n * ldC];
-                            } 
-                        } 
-                    }
+                    // small problems: one gemm per thread, large problems: one gemm at a time, parallel inside
+                    const bool batchParallel = batchSize > 1 && (batchSize >= ThreadPool::getInstance()->maxThreads() || (Nd4jLong) M * N * K <= BGEMM_BATCH_PARALLEL_THRESHOLD);
+
+                    const auto xType = vA.at(0)->dataType();
+                    const bool hasBlas = BlasHelper::getInstance()->hasGEMM<T>() && (std::is_same<T, float>::value || std::is_same<T, double>::value);
+
+                    // one ticket per gemm, idle workers steal remaining ones
+                    ThreadPool::getInstance()->parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+                        for (auto p = start; p < stop; ++p) {
+                            auto A = vA.at(p);
+                            auto B = vB.at(p);
+                            auto C = vC.at(p);
+
+                            if (hasBlas && A->dataType() == xType && B->dataType() == xType && C->dataType() == xType) {
+                                if (std::is_same<T, double>::value)
+                                    BlasHelper::getInstance()->dgemm()(CblasColMajor, tA, tB, M, N, K, alphas->e<double>(p), (double *) A->getBuffer(), ldA, (double *) B->getBuffer(), ldB, betas->e<double>(p), (double *) C->getBuffer(), ldC);
+                                else
+                                    BlasHelper::getInstance()->sgemm()(CblasColMajor, tA, tB, M, N, K, alphas->e<float>(p), (float *) A->getBuffer(), ldA, (float *) B->getBuffer(), ldB, betas->e<float>(p), (float *) C->getBuffer(), ldC);
+                            } else {
+                                // column-major gemm, half-precision types are accumulated in fp32 there
+                                MmulHelper::gemm(A->dataType(), B->dataType(), C->dataType(), 'f', tA != CblasNoTrans, tB != CblasNoTrans, M, N, K, alphas->e<double>(p), A->getBuffer(), ldA, B->getBuffer(), ldB, betas->e<double>(p), C->getBuffer(), ldC);
+                            }
+                        }
+                    }, 0, batchSize, 1, batchParallel ? 0 : 1);
                 }
             };
 
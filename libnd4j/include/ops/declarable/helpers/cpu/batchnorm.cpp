@@ -22,6 +22,7 @@
 #include<ops/declarable/helpers/batchnorm.h>
 #include <helpers/ShapeUtils.h>
 #include <OmpLaunchHelper.h>
+#include <helpers/ThreadPool.h>
 
 namespace nd4j 	  {
 namespace ops 	  {
@@ -63,6 +64,35 @@ static void batchnorm_(const NDArray* input, const NDArray* mean, const NDArray*
     bool canCastMean = nd4j::DataTypeUtils::castShapeInfo(meanShapeInfo, meanShapeInfoCast);    
     
     const Nd4jLong step = lenBig / lenSmall;
+
+    // channels-last case (NHWC with axis = last dimension): every row of input meets parameters with unit stride
+    if(axes.size() == 1 && axes[0] == input->rankOf() - 1 && input->ordering() == 'c' && input->ews() == 1 && output->ordering() == 'c' && output->ews() == 1 &&
+       mean->ews() == 1 && sigmaInvGam.ews() == 1 && (beta == nullptr || beta->ews() == 1)) {
+
+        const T* betaBuff = beta != nullptr ? beta->bufferAsT<T>() : nullptr;
+        const Nd4jLong grain = nd4j::math::nd4j_max<Nd4jLong>(1, Environment::getInstance()->elementwiseThreshold() / lenSmall);
+
+        ThreadPool::getInstance()->parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+            for (auto r = start; r < stop; ++r) {
+                const T* x = inBuff + r * lenSmall;
+                      T* z = outBuff + r * lenSmall;
+
+                if(betaBuff != nullptr) {
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong c = 0; c < lenSmall; ++c)
+                        z[c] = (x[c] - meanBuff[c]) * sigmaBuff[c] + betaBuff[c];
+                }
+                else {
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong c = 0; c < lenSmall; ++c)
+                        z[c] = (x[c] - meanBuff[c]) * sigmaBuff[c];
+                }
+            }
+        }, 0, step, grain);
+
+        return;
+    }
+
     std::vector<int> dimsToExclude = ShapeUtils::evalDimsToExclude(input->rankOf(), axes);
 
     OmpLaunchHelper info(lenBig, lenSmall);
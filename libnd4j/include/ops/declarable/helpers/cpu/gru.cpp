@@ -28,6 +28,7 @@
 #include <ops/declarable/CustomOperations.h>
 #include<ops/declarable/helpers/transforms.h>
 #include <MmulHelper.h>
+#include <Environment.h>
 
 namespace nd4j 	  {
 namespace ops 	  {
@@ -117,29 +118,124 @@ void gruCell(const NDArray* x, const NDArray* hLast, const NDArray* Wru, const N
 }
 
 //////////////////////////////////////////////////////////////////////////
-void gruTimeLoop(const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDArray* Wh, const NDArray* b, NDArray* h) {
+// dense c-ordered array of given type with the content of arr: arr itself if it is one already, otherwise a copy released by the caller
+static NDArray* denseC(const NDArray* arr, const nd4j::DataType type) {
+    if (arr->dataType() == type && arr->ordering() == 'c' && arr->ews() == 1)
+        return const_cast<NDArray*>(arr);
+
+    auto copy = new NDArray('c', arr->getShapeAsVector(), type, arr->getWorkspace());
+    copy->assign(arr);
+    return copy;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// fused forward pass over dense c-ordered buffers
+// gates [time*bS, 3*nU] receive r, u and n activations for every time step, x*Wx + b is evaluated for all steps by one gemm
+// rh receives r◦h(t-1), with rhStride = 0 one [bS, nU] buffer is reused for all steps
+template <typename T>
+static void gruForward_(const int time, const int bS, const int iS, const int nU, const nd4j::DataType type,
+                        const T* x, const T* h0, const T* Wx, const T* Wh, const T* b, T* gates, T* rh, const Nd4jLong rhStride, T* h) {
+
+    const int nG = 3 * nU;
+    const bool parallelRows = bS > 1 && (Nd4jLong) bS * nU > Environment::getInstance()->elementwiseThreshold();
+
+    PRAGMA_OMP_PARALLEL_FOR_IF((Nd4jLong) time * bS * nG > Environment::getInstance()->elementwiseThreshold())
+    for (Nd4jLong r = 0; r < (Nd4jLong) time * bS; ++r) {
+        PRAGMA_OMP_SIMD
+        for (int j = 0; j < nG; ++j)
+            gates[r * nG + j] = b[j];
+    }
+
+    MmulHelper::blasGemm(type, 'c', false, false, time * bS, nG, iS, 1.0, x, iS, Wx, nG, 1.0, gates, nG);
+
+    for (int t = 0; t < time; ++t) {
+
+        const T* hPrev = t == 0 ? h0 : h + (Nd4jLong) (t - 1) * bS * nU;
+        T* gt  = gates + (Nd4jLong) t * bS * nG;
+        T* rht = rh + t * rhStride;
+        T* ht  = h + (Nd4jLong) t * bS * nU;
+
+        // reset and update gates: += h(t-1) * Wh[:, 0:2*nU]
+        MmulHelper::blasGemm(type, 'c', false, false, bS, 2 * nU, nU, 1.0, hPrev, nU, Wh, nG, 1.0, gt, nG);
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(parallelRows)
+        for (int r = 0; r < bS; ++r) {
+            T* g = gt + (Nd4jLong) r * nG;
+            const T* hp = hPrev + (Nd4jLong) r * nU;
+            T* rhr = rht + (Nd4jLong) r * nU;
+
+            PRAGMA_OMP_SIMD
+            for (int j = 0; j < 2 * nU; ++j)
+                g[j] = nd4j::math::nd4j_sigmoid<T,T>(g[j]);
+
+            PRAGMA_OMP_SIMD
+            for (int j = 0; j < nU; ++j)
+                rhr[j] = g[j] * hp[j];
+        }
+
+        // cell gate: += (r◦h(t-1)) * Wh[:, 2*nU:3*nU]
+        MmulHelper::blasGemm(type, 'c', false, false, bS, nU, nU, 1.0, rht, nU, Wh + 2 * nU, nG, 1.0, gt + 2 * nU, nG);
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(parallelRows)
+        for (int r = 0; r < bS; ++r) {
+            T* g = gt + (Nd4jLong) r * nG;
+            const T* u = g + nU;
+            T* n = g + 2 * nU;
+            const T* hp = hPrev + (Nd4jLong) r * nU;
+            T* hr = ht + (Nd4jLong) r * nU;
+
+            // h = u◦h(t-1) + (1-u)◦n
+            PRAGMA_OMP_SIMD
+            for (int j = 0; j < nU; ++j) {
+                n[j] = nd4j::math::nd4j_tanh<T,T>(n[j]);
+                hr[j] = u[j] * hp[j] + (static_cast<T>(1.f) - u[j]) * n[j];
+            }
+        }
+    }
+}
 
-// x   input [time, bS, iS]
-// h0  initial cell output (at time step = 0) [bS, nU]
-// Wx  input-to-hidden  weights, [iS, 3*nU]
-// Wh  hidden-to-hidden weights, [nU, 3*nU]
-// b   biases, [3*nU]
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void gruTimeLoop_(const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDArray* Wh, const NDArray* b, NDArray* h) {
 
-// h is cell outputs at each time step [time, bS, nU]
+    const int time = x->sizeAt(0);
+    const int bS   = x->sizeAt(1);
+    const int iS   = x->sizeAt(2);
+    const int nU   = h0->sizeAt(1);
 
-const int time = x->sizeAt(0);
+    NDArray gates('c', {(Nd4jLong) time * bS, (Nd4jLong) 3 * nU}, x->dataType(), x->getWorkspace());
+    NDArray rh('c', {(Nd4jLong) bS, (Nd4jLong) nU}, x->dataType(), x->getWorkspace());
 
-NDArray ht_1(*h0);
+    gruForward_<T>(time, bS, iS, nU, x->dataType(), x->bufferAsT<T>(), h0->bufferAsT<T>(), Wx->bufferAsT<T>(), Wh->bufferAsT<T>(), b->bufferAsT<T>(),
+                   gates.bufferAsT<T>(), rh.bufferAsT<T>(), 0, h->bufferAsT<T>());
+}
 
-// loop through time steps
-for (int t = 0; t < time; ++t) {
+//////////////////////////////////////////////////////////////////////////
+void gruTimeLoop(const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDArray* Wh, const NDArray* b, NDArray* h) {
 
-    auto xt = (*x)({t,t+1, 0,0, 0,0});
-    auto ht = (*h)({t,t+1, 0,0, 0,0});
+    // x   input [time, bS, iS]
+    // h0  initial cell output (at time step = 0) [bS, nU]
+    // Wx  input-to-hidden  weights, [iS, 3*nU]
+    // Wh  hidden-to-hidden weights, [nU, 3*nU]
+    // b   biases, [3*nU]
 
-    //helpers::gruCell(&xt, &ht_1, Wx, Wh, b, &ht);
-    //ht_1.assign(ht);
-}
+    // h is cell outputs at each time step [time, bS, nU]
+
+    const auto type = h->dataType();
+    std::vector<NDArray*> in({denseC(x, type), denseC(h0, type), denseC(Wx, type), denseC(Wh, type), denseC(b, type)});
+    NDArray* hC = denseC(h, type);
+
+    BUILD_SINGLE_SELECTOR(type, gruTimeLoop_, (in[0], in[1], in[2], in[3], in[4], hC), FLOAT_TYPES);
+
+    if (hC != h) {
+        h->assign(hC);
+        delete hC;
+    }
+
+    const std::vector<const NDArray*> orig({x, h0, Wx, Wh, b});
+    for (int e = 0; e < (int) in.size(); ++e)
+        if (in[e] != orig[e])
+            delete in[e];
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -244,63 +340,156 @@ if(dLdb0 != nullptr)
 
 }
 
-// //////////////////////////////////////////////////////////////////////////
-// FIXME - gruTimeLoopBP is not correct
-// template <typename T>
-// void gruTimeLoopBP(const std::vector<NDArray<T>*>& inArrs, const std::vector<NDArray<T>*>& outArrs) {
-
-//     NDArray<T>* x      = inArrs[0];                   // input [time, bS, iS]
-//     NDArray<T>* hi     = inArrs[1];                   // previous/initial cell output [bS, nU],  that is at previous time step t-1
-//     NDArray<T>* Wx     = inArrs[2];                   // input-to-hidden  weights, [iS, 3*nU]
-//     NDArray<T>* Wh     = inArrs[3];                   // hidden-to-hidden weights, [nU, 3*nU]
-//     NDArray<T>* b      = inArrs[4];                   // biases, [3*nU]
-//     NDArray<T>* dLdh   = inArrs[5];                   // gradient wrt output, [time, bS, nU], that is epsilon_next
-
-//     NDArray<T>* dLdx   = outArrs[0];                  // gradient wrt x,  [time, bS, iS], that is epsilon
-//     NDArray<T>* dLdhi  = outArrs[1];                  // gradient wrt hi, [bS, nU]
-//     NDArray<T>* dLdWx  = outArrs[2];                  // gradient wrt Wx, [iS, 3*nU]
-//     NDArray<T>* dLdWh  = outArrs[3];                  // gradient wrt Wh, [nU, 3*nU]
-//     NDArray<T>* dLdb   = outArrs[4];                  // gradient wrt b,  [3*nU]
-
-//     const Nd4jLong time = x->sizeAt(0);
-//     const Nd4jLong bS   = x->sizeAt(1);
-//     const Nd4jLong iS   = x->sizeAt(2);
-//     const Nd4jLong nU   = hi->sizeAt(1);
-
-//     NDArray<T> h(hi->ordering(), {time, bS, nU});      // feed forward output
-
-//     // first step, time = 0, feed forward
-//     NDArray<T> x0 = (*x)({{0,1}, {}, {}});
-//     NDArray<T> h0 = h({{0,1}, {}, {}});
-//     helpers::gruCell<T>({&x0, hi, Wx, Wh, b}, &h0);
-
-//     // first step, time = 0, back prop
-//     NDArray<T> dLdx0 = (*dLdx)({{0,1}, {}, {}});
-//     NDArray<T> dLdh0 = (*dLdh)({{0,1}, {}, {}});
-//     helpers::gruCellBP<T>({&x0, hi, Wx, Wh, b, &dLdh0, nullptr, nullptr, nullptr}, {&dLdx0, dLdhi, dLdWx, dLdWh, dLdb});
-
-//     // loop through the rest time steps
-//     for (Nd4jLong t = time-1; t > 0; --t) {
-//     for (Nd4jLong t = 1; t < time; ++t) {
-
-//         NDArray<T> xt    =    (*x)({{t,t+1}, {}, {}});
-//         NDArray<T> ht    =       h({{t,t+1}, {}, {}});
-//         NDArray<T> ht_1  =       h({{t-1,t}, {}, {}});
-//         NDArray<T> dLdxt = (*dLdx)({{t,t+1}, {}, {}});
-//         NDArray<T> dLdht = (*dLdh)({{t,t+1}, {}, {}});
-
-//         NDArray<T> dLdWxt_1 = dLdWx;
-//         NDArray<T> dLdWht_1 = dLdWh;
-//         NDArray<T> dLdbt_1  = dLdb;
-
-//         // feed forward, calculation of ht
-//         helpers::gruCell<T>({&xt, &ht_1, Wx, Wh, b}, &ht);
-
-//         // back prop
-//         helpers::gruCellBP<T>({&xt, &ht_1, Wx, Wh, b, &dLdht, &dLdWxt_1, &dLdWht_1, &dLdbt_1}, {&dLdxt, nullptr, dLdWx, dLdWh, dLdb});
-//     }
-// }
+//////////////////////////////////////////////////////////////////////////
+// back propagation through time: the forward pass keeps gate activations of all steps, the reverse loop only runs
+// the recurrent gemms, gradients wrt x, Wx, Wh and b are then evaluated for the whole sequence by single gemms
+template <typename T>
+static void gruTimeLoopBP_(const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDArray* Wh, const NDArray* b, const NDArray* dLdh,
+                           NDArray* dLdx, NDArray* dLdh0, NDArray* dLdWx, NDArray* dLdWh, NDArray* dLdb) {
+
+    const int time = x->sizeAt(0);
+    const int bS   = x->sizeAt(1);
+    const int iS   = x->sizeAt(2);
+    const int nU   = h0->sizeAt(1);
+    const int nG   = 3 * nU;
+    const auto type = x->dataType();
+    const auto ws   = x->getWorkspace();
+
+    const bool parallelRows = bS > 1 && (Nd4jLong) bS * nU > Environment::getInstance()->elementwiseThreshold();
+
+    NDArray gates('c', {(Nd4jLong) time * bS, (Nd4jLong) nG}, type, ws);      // r, u, n activations
+    NDArray dGates('c', {(Nd4jLong) time * bS, (Nd4jLong) nG}, type, ws);     // gradients wrt gate pre-activations
+    NDArray rhSeq('c', {(Nd4jLong) time * bS, (Nd4jLong) nU}, type, ws);      // r◦h(t-1)
+    NDArray hSeq('c', {(Nd4jLong) time * bS, (Nd4jLong) nU}, type, ws);
+    NDArray drh('c', {(Nd4jLong) bS, (Nd4jLong) nU}, type, ws);
+
+    auto x_  = x->bufferAsT<T>();
+    auto h0_ = h0->bufferAsT<T>();
+    auto Wx_ = Wx->bufferAsT<T>();
+    auto Wh_ = Wh->bufferAsT<T>();
+    auto g_  = gates.bufferAsT<T>();
+    auto dg_ = dGates.bufferAsT<T>();
+    auto rh_ = rhSeq.bufferAsT<T>();
+    auto h_  = hSeq.bufferAsT<T>();
+    auto drh_ = drh.bufferAsT<T>();
+    auto dLdh_ = dLdh->bufferAsT<T>();
+    auto dh_ = dLdh0->bufferAsT<T>();         // carries dL/dh(t-1) between steps, ends up as dL/dh0
+
+    gruForward_<T>(time, bS, iS, nU, type, x_, h0_, Wx_, Wh_, b->bufferAsT<T>(), g_, rh_, (Nd4jLong) bS * nU, h_);
+
+    dLdh0->nullify();
+
+    for (int t = time - 1; t >= 0; --t) {
+
+        const T* hPrev = t == 0 ? h0_ : h_ + (Nd4jLong) (t - 1) * bS * nU;
+        const T* gt = g_ + (Nd4jLong) t * bS * nG;
+        const T* dLdht = dLdh_ + (Nd4jLong) t * bS * nU;
+        T* dgt = dg_ + (Nd4jLong) t * bS * nG;
+
+        // dh = dL/dh(t) + carry, gradients wrt pre-activations of update and cell gates
+        PRAGMA_OMP_PARALLEL_FOR_IF(parallelRows)
+        for (int r = 0; r < bS; ++r) {
+            const T* u = gt + (Nd4jLong) r * nG + nU;
+            const T* n = u + nU;
+            const T* hp = hPrev + (Nd4jLong) r * nU;
+            const T* dl = dLdht + (Nd4jLong) r * nU;
+            T* dh  = dh_ + (Nd4jLong) r * nU;
+            T* dau = dgt + (Nd4jLong) r * nG + nU;
+            T* dan = dau + nU;
+
+            PRAGMA_OMP_SIMD
+            for (int j = 0; j < nU; ++j) {
+                const T d = dl[j] + dh[j];
+                dh[j]  = d;
+                dan[j] = d * (static_cast<T>(1.f) - u[j]) * (static_cast<T>(1.f) - n[j] * n[j]);
+                dau[j] = d * (hp[j] - n[j]) * u[j] * (static_cast<T>(1.f) - u[j]);
+            }
+        }
+
+        // d(r◦h(t-1)) = dan * Whn^T
+        MmulHelper::blasGemm(type, 'c', false, true, bS, nU, nU, 1.0, dgt + 2 * nU, nG, Wh_ + 2 * nU, nG, 0.0, drh_, nU);
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(parallelRows)
+        for (int r = 0; r < bS; ++r) {
+            const T* rg = gt + (Nd4jLong) r * nG;
+            const T* u  = rg + nU;
+            const T* hp = hPrev + (Nd4jLong) r * nU;
+            const T* d  = drh_ + (Nd4jLong) r * nU;
+            T* dh  = dh_ + (Nd4jLong) r * nU;
+            T* dar = dgt + (Nd4jLong) r * nG;
+
+            PRAGMA_OMP_SIMD
+            for (int j = 0; j < nU; ++j) {
+                dar[j] = d[j] * hp[j] * rg[j] * (static_cast<T>(1.f) - rg[j]);
+                dh[j]  = dh[j] * u[j] + d[j] * rg[j];
+            }
+        }
+
+        // dL/dh(t-1) += [dar, dau] * Whru^T
+        MmulHelper::blasGemm(type, 'c', false, true, bS, nU, 2 * nU, 1.0, dgt, nG, Wh_, nG, 1.0, dh_, nU);
+    }
+
+    // dL/dx = dGates * Wx^T,  dL/dWx = x^T * dGates
+    MmulHelper::blasGemm(type, 'c', false, true, time * bS, iS, nG, 1.0, dg_, nG, Wx_, nG, 0.0, dLdx->getBuffer(), iS);
+    MmulHelper::blasGemm(type, 'c', true, false, iS, nG, time * bS, 1.0, x_, iS, dg_, nG, 0.0, dLdWx->getBuffer(), nG);
+
+    // dL/dWh[:, 0:2*nU] = h(t-1)^T * [dar, dau],  dL/dWh[:, 2*nU:3*nU] = (r◦h(t-1))^T * dan
+    auto dWh_ = dLdWh->bufferAsT<T>();
+    MmulHelper::blasGemm(type, 'c', true, false, nU, 2 * nU, bS, 1.0, h0_, nU, dg_, nG, 0.0, dWh_, nG);
+    if (time > 1)
+        MmulHelper::blasGemm(type, 'c', true, false, nU, 2 * nU, (time - 1) * bS, 1.0, h_, nU, dg_ + (Nd4jLong) bS * nG, nG, 1.0, dWh_, nG);
+    MmulHelper::blasGemm(type, 'c', true, false, nU, nU, time * bS, 1.0, rh_, nU, dg_ + 2 * nU, nG, 0.0, dWh_ + 2 * nU, nG);
+
+    // dL/db = sum of dGates over time and batch
+    auto db_ = dLdb->bufferAsT<T>();
+    PRAGMA_OMP_PARALLEL_FOR_IF(nG > 1 && (Nd4jLong) time * bS * nG > Environment::getInstance()->elementwiseThreshold())
+    for (int j = 0; j < nG; ++j) {
+        T sum = static_cast<T>(0.f);
+        for (Nd4jLong r = 0; r < (Nd4jLong) time * bS; ++r)
+            sum += dg_[r * nG + j];
+        db_[j] = sum;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void gruTimeLoopBP(const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDArray* Wh, const NDArray* b, const NDArray* dLdh,
+                   NDArray* dLdx, NDArray* dLdh0, NDArray* dLdWx, NDArray* dLdWh, NDArray* dLdb) {
+
+    // x      input [time, bS, iS]
+    // h0     initial cell output (at time step = 0) [bS, nU]
+    // Wx     input-to-hidden  weights, [iS, 3*nU]
+    // Wh     hidden-to-hidden weights, [nU, 3*nU]
+    // b      biases, [3*nU]
+    // dLdh   gradient wrt cell outputs at each time step, [time, bS, nU], that is epsilon_next
+
+    // dLdx   gradient wrt x,  [time, bS, iS], that is epsilon
+    // dLdh0  gradient wrt h0, [bS, nU]
+    // dLdWx  gradient wrt Wx, [iS, 3*nU]
+    // dLdWh  gradient wrt Wh, [nU, 3*nU]
+    // dLdb   gradient wrt b,  [3*nU]
+
+    const auto type = dLdx->dataType();
+    std::vector<NDArray*> in({denseC(x, type), denseC(h0, type), denseC(Wx, type), denseC(Wh, type), denseC(b, type), denseC(dLdh, type)});
+    std::vector<NDArray*> out({denseC(dLdx, type), denseC(dLdh0, type), denseC(dLdWx, type), denseC(dLdWh, type), denseC(dLdb, type)});
+
+    BUILD_SINGLE_SELECTOR(type, gruTimeLoopBP_, (in[0], in[1], in[2], in[3], in[4], in[5], out[0], out[1], out[2], out[3], out[4]), FLOAT_TYPES);
+
+    const std::vector<const NDArray*> origIn({x, h0, Wx, Wh, b, dLdh});
+    for (int e = 0; e < (int) in.size(); ++e)
+        if (in[e] != origIn[e])
+            delete in[e];
+
+    const std::vector<NDArray*> origOut({dLdx, dLdh0, dLdWx, dLdWh, dLdb});
+    for (int e = 0; e < (int) out.size(); ++e)
+        if (out[e] != origOut[e]) {
+            origOut[e]->assign(out[e]);
+            delete out[e];
+        }
+}
+
 
+BUILD_SINGLE_TEMPLATE(template void gruTimeLoop_, (const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDArray* Wh, const NDArray* b, NDArray* h), FLOAT_TYPES);
+BUILD_SINGLE_TEMPLATE(template void gruTimeLoopBP_, (const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDArray* Wh, const NDArray* b, const NDArray* dLdh, NDArray* dLdx, NDArray* dLdh0, NDArray* dLdWx, NDArray* dLdWh, NDArray* dLdb), FLOAT_TYPES);
 
 }
 }
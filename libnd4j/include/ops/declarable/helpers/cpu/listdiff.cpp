@@ -19,23 +19,50 @@
 //
 
 #include <ops/declarable/helpers/listdiff.h>
+#include <specials.h>
+#include <algorithm>
 #include <vector>
-//#include <memory>
+#include <memory>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
+    /**
+     * sorted copy of keep array, binary search over it replaces FirstIndex reduction per value
+     */
+    template <typename T>
+    class SortedKeep {
+    private:
+        std::unique_ptr<T[]> _keys;
+        Nd4jLong _length = 0;
+    public:
+        explicit SortedKeep(NDArray* keep) : _keys(new T[keep->lengthOf()]) {
+            for (Nd4jLong e = 0; e < keep->lengthOf(); e++) {
+                T v = keep->e<T>(e);
+                // NaN never matches anything
+                if (v == v)
+                    _keys[_length++] = v;
+            }
+
+            SpecialMethods<T>::sortBuffer(_keys.get(), _length, false);
+        }
+
+        bool contains(T v) const {
+            auto end = _keys.get() + _length;
+            auto it = std::lower_bound(_keys.get(), end, v);
+            return it != end && *it == v;
+        }
+    };
+
     template <typename T>
     static Nd4jLong listDiffCount_(NDArray* values, NDArray* keep) {
+        SortedKeep<T> sortedKeep(keep);
+
         Nd4jLong saved = 0L;
-        for (Nd4jLong e = 0; e < values->lengthOf(); e++) {
-            T v = values->e<T>(e);
-            T extras[] = {v, (T) 0.0f, (T) 10.0f};
-            NDArray idx = keep->indexReduceNumber(indexreduce::FirstIndex, extras);
-            Nd4jLong index = idx.e<Nd4jLong>(0);
-            if (index < 0)
+        for (Nd4jLong e = 0; e < values->lengthOf(); e++)
+            if (!sortedKeep.contains(values->e<T>(e)))
                 saved++;
-        }
+
         return saved;
     }
 
@@ -50,16 +77,14 @@ namespace helpers {
     template <typename T>
     static int listDiffFunctor_(NDArray* values, NDArray* keep, NDArray* output1, NDArray* output2) {
 
+        SortedKeep<T> sortedKeep(keep);
         std::vector<T> saved;
         std::vector<Nd4jLong> indices;
 
         for (Nd4jLong e = 0; e < values->lengthOf(); e++) {
             T v = values->e<T>(e);
-            T extras[] = {v, (T) 0.0f, (T) 10.0f};
-            NDArray idxScalar = keep->indexReduceNumber(indexreduce::FirstIndex, extras);
-            Nd4jLong idx = idxScalar.e<Nd4jLong>(0);
 
-            if (idx < 0) {
+            if (!sortedKeep.contains(v)) {
                 saved.emplace_back(v);
                 indices.emplace_back(e);
             }
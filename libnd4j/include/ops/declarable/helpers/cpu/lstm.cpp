@@ -34,6 +34,7 @@
 #include <array/NDArrayList.h>
 #include <iterator>
 #include <MmulHelper.h>
+#include <Environment.h>
 
 namespace nd4j 	  {
 namespace ops 	  {
@@ -294,6 +295,229 @@ void lstmBlockCell(const NDArray* xt, const NDArray* cLast, const NDArray* yLast
 
 
 
+//////////////////////////////////////////////////////////////////////////
+static FORCEINLINE bool isDenseC(const NDArray* arr) {
+    return arr->ordering() == 'c' && arr->ews() == 1;
+}
+
+template <typename T>
+static FORCEINLINE T clipValue(const T val, const T limit) {
+    return val > limit ? limit : (val < -limit ? -limit : val);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// fused time loop over dense c-ordered arrays: x*Wx + b is evaluated for all time steps by a single gemm,
+// every step then adds h(t-1)*Wh into its slice in place and applies gates and cell update in one pass
+template <typename T>
+static void lstmTimeLoop_(const NDArray* x, const NDArray* h0, const NDArray* c0, const NDArray* Wx, const NDArray* Wh, const NDArray* Wc, const NDArray* Wp, const NDArray* b,
+                          NDArray* h, NDArray* c, const std::vector<double>& params) {
+
+    const bool peephole       = (bool)params[0];
+    const bool projection     = (bool)params[1];
+    const T clippingCellValue = static_cast<T>(params[2]);
+    const T clippingProjValue = static_cast<T>(params[3]);
+    const T forgetBias        = static_cast<T>(params[4]);
+
+    const int time     = x->sizeAt(0);
+    const int bS       = x->sizeAt(1);
+    const int inSize   = x->sizeAt(2);
+    const int numProj  = h0->sizeAt(1);
+    const int numUnits = c0->sizeAt(1);
+    const int nG       = 4 * numUnits;
+    const auto type    = x->dataType();
+
+    const bool parallelRows = bS > 1 && (Nd4jLong) bS * numUnits > Environment::getInstance()->elementwiseThreshold();
+
+    NDArray zSeq('c', {(Nd4jLong) time * bS, (Nd4jLong) nG}, type, x->getWorkspace());
+    auto z_  = zSeq.bufferAsT<T>();
+    auto b_  = b->bufferAsT<T>();
+
+    PRAGMA_OMP_PARALLEL_FOR_IF((Nd4jLong) time * bS * nG > Environment::getInstance()->elementwiseThreshold())
+    for (Nd4jLong r = 0; r < (Nd4jLong) time * bS; ++r) {
+        PRAGMA_OMP_SIMD
+        for (int j = 0; j < nG; ++j)
+            z_[r * nG + j] = b_[j];
+    }
+
+    MmulHelper::blasGemm(type, 'c', false, false, time * bS, nG, inSize, 1.0, x->getBuffer(), inSize, Wx->getBuffer(), nG, 1.0, z_, nG);
+
+    // cell output before projection, written straight into h when there is no projection
+    NDArray* hNoProj = projection ? new NDArray('c', {(Nd4jLong) bS, (Nd4jLong) numUnits}, type, x->getWorkspace()) : nullptr;
+
+    auto h_   = h->bufferAsT<T>();
+    auto c_   = c->bufferAsT<T>();
+    auto Wh_  = Wh->bufferAsT<T>();
+    auto Wci_ = peephole ? Wc->bufferAsT<T>() : nullptr;
+    auto Wcf_ = peephole ? Wci_ + numUnits : nullptr;
+    auto Wco_ = peephole ? Wci_ + 2 * numUnits : nullptr;
+
+    for (int t = 0; t < time; ++t) {
+
+        const T* hPrev = t == 0 ? h0->bufferAsT<T>() : h_ + (Nd4jLong) (t - 1) * bS * numProj;
+        const T* cPrev = t == 0 ? c0->bufferAsT<T>() : c_ + (Nd4jLong) (t - 1) * bS * numUnits;
+        T* zt = z_ + (Nd4jLong) t * bS * nG;
+        T* ct = c_ + (Nd4jLong) t * bS * numUnits;
+        T* ht = h_ + (Nd4jLong) t * bS * numProj;
+        T* hu = projection ? hNoProj->bufferAsT<T>() : ht;
+
+        MmulHelper::blasGemm(type, 'c', false, false, bS, nG, numProj, 1.0, hPrev, numProj, Wh_, nG, 1.0, zt, nG);
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(parallelRows)
+        for (int r = 0; r < bS; ++r) {
+            const T* zi = zt + (Nd4jLong) r * nG;
+            const T* zf = zi + numUnits;
+            const T* zc = zi + 2 * numUnits;
+            const T* zo = zi + 3 * numUnits;
+            const T* cp = cPrev + (Nd4jLong) r * numUnits;
+            T* cc = ct + (Nd4jLong) r * numUnits;
+            T* hh = hu + (Nd4jLong) r * numUnits;
+
+            PRAGMA_OMP_SIMD
+            for (int j = 0; j < numUnits; ++j) {
+                T gi = zi[j];
+                T gf = zf[j];
+                T go = zo[j];
+                if (peephole) {
+                    gi += cp[j] * Wci_[j];
+                    gf += cp[j] * Wcf_[j];
+                }
+
+                T cs = nd4j::math::nd4j_sigmoid<T,T>(gf + forgetBias) * cp[j] + nd4j::math::nd4j_sigmoid<T,T>(gi) * nd4j::math::nd4j_tanh<T,T>(zc[j]);
+                if (clippingCellValue > static_cast<T>(0.f))
+                    cs = clipValue<T>(cs, clippingCellValue);
+
+                if (peephole)
+                    go += cs * Wco_[j];
+
+                cc[j] = cs;
+                hh[j] = nd4j::math::nd4j_sigmoid<T,T>(go) * nd4j::math::nd4j_tanh<T,T>(cs);
+            }
+        }
+
+        if (projection) {
+            MmulHelper::blasGemm(type, 'c', false, false, bS, numProj, numUnits, 1.0, hu, numUnits, Wp->getBuffer(), numProj, 0.0, ht, numProj);
+
+            if (clippingProjValue != static_cast<T>(0.f)) {
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < (Nd4jLong) bS * numProj; ++e)
+                    ht[e] = clipValue<T>(ht[e], clippingProjValue);
+            }
+        }
+    }
+
+    delete hNoProj;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// fused lstmBlock time loop for TNS and NTS layouts: rows of every sequence array are addressed as row(t, b) = t*stepStride + b*batchStride
+template <typename T>
+static void lstmBlockTimeLoop_(const NDArray* xSeq, const NDArray* c0, const NDArray* y0,
+                               const NDArray* W, const NDArray* Wci, const NDArray* Wcf, const NDArray* Wco, const NDArray* b,
+                               const NDArray* iSeq, const NDArray* cSeq, const NDArray* fSeq, const NDArray* oSeq, const NDArray* zSeq,
+                               const NDArray* hSeq, const NDArray* ySeq, const std::vector<double>& params, const int dataFormat) {
+
+    const bool peephole       = (bool)params[0];
+    const T forgetBias        = static_cast<T>(params[1]);
+    const T clippingCellValue = static_cast<T>(params[2]);
+
+    const int seqLen   = dataFormat == 0 ? xSeq->sizeAt(0) : xSeq->sizeAt(1);
+    const int bS       = dataFormat == 0 ? xSeq->sizeAt(1) : xSeq->sizeAt(0);
+    const int inSize   = xSeq->sizeAt(2);
+    const int numUnits = c0->sizeAt(1);
+    const int nG       = 4 * numUnits;
+    const auto type    = xSeq->dataType();
+
+    const Nd4jLong stepStride  = dataFormat == 0 ? bS : 1;
+    const Nd4jLong batchStride = dataFormat == 0 ? 1 : seqLen;
+
+    const bool parallelRows = bS > 1 && (Nd4jLong) bS * numUnits > Environment::getInstance()->elementwiseThreshold();
+
+    // gate pre-activations for all time steps, rows follow the layout of xSeq
+    NDArray gates('c', {(Nd4jLong) seqLen * bS, (Nd4jLong) nG}, type, xSeq->getWorkspace());
+    auto g_ = gates.bufferAsT<T>();
+    auto b_ = b->bufferAsT<T>();
+
+    PRAGMA_OMP_PARALLEL_FOR_IF((Nd4jLong) seqLen * bS * nG > Environment::getInstance()->elementwiseThreshold())
+    for (Nd4jLong r = 0; r < (Nd4jLong) seqLen * bS; ++r) {
+        PRAGMA_OMP_SIMD
+        for (int j = 0; j < nG; ++j)
+            g_[r * nG + j] = b_[j];
+    }
+
+    // W = [Wx; Wh], so input and recurrent weights are row blocks of the same buffer
+    auto Wx_ = W->bufferAsT<T>();
+    auto Wh_ = Wx_ + (Nd4jLong) inSize * nG;
+    MmulHelper::blasGemm(type, 'c', false, false, seqLen * bS, nG, inSize, 1.0, xSeq->getBuffer(), inSize, Wx_, nG, 1.0, g_, nG);
+
+    auto i_ = iSeq->bufferAsT<T>();
+    auto c_ = cSeq->bufferAsT<T>();
+    auto f_ = fSeq->bufferAsT<T>();
+    auto o_ = oSeq->bufferAsT<T>();
+    auto z_ = zSeq->bufferAsT<T>();
+    auto h_ = hSeq->bufferAsT<T>();
+    auto y_ = ySeq->bufferAsT<T>();
+
+    auto Wci_ = peephole ? Wci->bufferAsT<T>() : nullptr;
+    auto Wcf_ = peephole ? Wcf->bufferAsT<T>() : nullptr;
+    auto Wco_ = peephole ? Wco->bufferAsT<T>() : nullptr;
+
+    for (int t = 0; t < seqLen; ++t) {
+
+        // previous output/state rows are spaced by batchStride rows inside the sequence arrays
+        const T* yPrev = t == 0 ? y0->bufferAsT<T>() : y_ + (t - 1) * stepStride * numUnits;
+        const T* cPrev = t == 0 ? c0->bufferAsT<T>() : c_ + (t - 1) * stepStride * numUnits;
+        const Nd4jLong prevStride = t == 0 ? numUnits : batchStride * numUnits;
+
+        T* gt = g_ + t * stepStride * nG;
+        MmulHelper::blasGemm(type, 'c', false, false, bS, nG, numUnits, 1.0, yPrev, prevStride, Wh_, nG, 1.0, gt, batchStride * nG);
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(parallelRows)
+        for (int r = 0; r < bS; ++r) {
+            //Note: gates are ordered [inputGate, blockInput, forgetGate, outputGate], see lstmBlockCell
+            const T* zi = gt + r * batchStride * nG;
+            const T* zz = zi + numUnits;
+            const T* zf = zi + 2 * numUnits;
+            const T* zo = zi + 3 * numUnits;
+            const T* cp = cPrev + r * prevStride;
+
+            const Nd4jLong offset = (t * stepStride + r * batchStride) * numUnits;
+
+            PRAGMA_OMP_SIMD
+            for (int j = 0; j < numUnits; ++j) {
+                T gi = zi[j];
+                T gf = zf[j] + forgetBias;
+                T go = zo[j];
+                if (peephole) {
+                    gi += cp[j] * Wci_[j];
+                    gf += cp[j] * Wcf_[j];
+                }
+
+                const T iv = nd4j::math::nd4j_sigmoid<T,T>(gi);
+                const T zv = nd4j::math::nd4j_tanh<T,T>(zz[j]);
+                const T fv = nd4j::math::nd4j_sigmoid<T,T>(gf);
+
+                T cs = zv * iv + fv * cp[j];
+                if (clippingCellValue > static_cast<T>(0.f))
+                    cs = clipValue<T>(cs, clippingCellValue);
+
+                if (peephole)
+                    go += cs * Wco_[j];
+
+                const T ov = nd4j::math::nd4j_sigmoid<T,T>(go);
+                const T hv = nd4j::math::nd4j_tanh<T,T>(cs);
+
+                i_[offset + j] = iv;
+                z_[offset + j] = zv;
+                f_[offset + j] = fv;
+                c_[offset + j] = cs;
+                o_[offset + j] = ov;
+                h_[offset + j] = hv;
+                y_[offset + j] = ov * hv;
+            }
+        }
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
 void lstmTimeLoop(const NDArray* x, const NDArray* h0, const NDArray* c0, const NDArray* Wx, const NDArray* Wh, const NDArray* Wc, const NDArray* Wp, const NDArray* b,
                   NDArray* h, NDArray* c, const std::vector<double>& params) {
@@ -313,6 +537,19 @@ void lstmTimeLoop(const NDArray* x, const NDArray* h0, const NDArray* c0, const
 
     const int time  = x->sizeAt(0);
 
+    const auto type = x->dataType();
+    const bool projection = (bool)params[1];
+    bool fused = DataTypeUtils::isR(type);
+    for (auto arr : {x, h0, c0, Wx, Wh, Wc, b, const_cast<const NDArray*>(h), const_cast<const NDArray*>(c)})
+        fused &= arr->dataType() == type && isDenseC(arr);
+    if (projection)
+        fused &= Wp->dataType() == type && isDenseC(Wp);
+
+    if (fused) {
+        BUILD_SINGLE_SELECTOR(type, lstmTimeLoop_, (x, h0, c0, Wx, Wh, Wc, Wp, b, h, c, params), FLOAT_TYPES);
+        return;
+    }
+
     NDArray currentH(*h0);
     NDArray currentC(*c0);
 
@@ -334,6 +571,20 @@ void lstmBlockTimeLoop(const NDArray* maxSeqLength, const NDArray* xSeq, const N
                        const NDArray* iSeq, const NDArray* cSeq, const NDArray* fSeq, const NDArray* oSeq, const NDArray* zSeq,
                        const NDArray* hSeq, const NDArray* ySeq, const std::vector<double>& params, const int dataFormat){
 
+    const auto type = xSeq->dataType();
+    const bool peephole = (bool)params[0];
+    bool fused = DataTypeUtils::isR(type) && dataFormat != 1;
+    for (auto arr : {xSeq, c0, y0, W, b, iSeq, cSeq, fSeq, oSeq, zSeq, hSeq, ySeq})
+        fused &= arr->dataType() == type && isDenseC(arr);
+    if (peephole)
+        for (auto arr : {Wci, Wcf, Wco})
+            fused &= arr->dataType() == type && arr->ews() == 1;
+
+    if (fused) {
+        BUILD_SINGLE_SELECTOR(type, lstmBlockTimeLoop_, (xSeq, c0, y0, W, Wci, Wcf, Wco, b, iSeq, cSeq, fSeq, oSeq, zSeq, hSeq, ySeq, params, dataFormat), FLOAT_TYPES);
+        return;
+    }
+
     const int seqLen = xSeq->sizeAt(0);
     const int mb = xSeq->sizeAt(1);
     const int inSize = xSeq->sizeAt(2);
@@ -365,7 +616,9 @@ void lstmBlockTimeLoop(const NDArray* maxSeqLength, const NDArray* xSeq, const N
 
 }
 
+BUILD_SINGLE_TEMPLATE(template void lstmTimeLoop_, (const NDArray* x, const NDArray* h0, const NDArray* c0, const NDArray* Wx, const NDArray* Wh, const NDArray* Wc, const NDArray* Wp, const NDArray* b, NDArray* h, NDArray* c, const std::vector<double>& params), FLOAT_TYPES);
+BUILD_SINGLE_TEMPLATE(template void lstmBlockTimeLoop_, (const NDArray* xSeq, const NDArray* c0, const NDArray* y0, const NDArray* W, const NDArray* Wci, const NDArray* Wcf, const NDArray* Wco, const NDArray* b, const NDArray* iSeq, const NDArray* cSeq, const NDArray* fSeq, const NDArray* oSeq, const NDArray* zSeq, const NDArray* hSeq, const NDArray* ySeq, const std::vector<double>& params, const int dataFormat), FLOAT_TYPES);
+
 }
 }
 }
-
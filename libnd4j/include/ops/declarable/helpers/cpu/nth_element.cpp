@@ -22,6 +22,9 @@
 #include <TAD.h>
 #include <ShapeUtils.h>
 #include <helpers/ConstantTadHelper.h>
+#include <helpers/ThreadPool.h>
+#include <specials.h>
+#include <Environment.h>
 
 namespace nd4j {
 namespace ops {
@@ -30,34 +33,43 @@ namespace helpers {
     template <typename T>
     void nthElementFunctor_(NDArray* input, NDArray* nVal, NDArray* output, bool reverse) {
         Nd4jLong n = nVal->e<Nd4jLong>(0);
-        NDArray sortedVals(*input);
+
         if (input->isVector()) {
-            //std::vector<float> data(input->lengthOf());
-            //memcpy(&data[0], input->getBuffer(), sizeof(T) * data.size());
-            //size_t l = 0;
-            //for (size_t l = 0; l < data.size(); ++l)
-            //    data[l] = input->e<float>(l);
-            //auto nthPos = data.begin();
-            //nthPos += n;
-            //std::nth_element(data.begin(), nthPos, data.end());
-            SpecialMethods<T>::sortGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), reverse);
-            output->p(0, sortedVals.e<T>(n));
+            std::unique_ptr<T[]> buffer(new T[input->lengthOf()]);
+            for (Nd4jLong e = 0; e < input->lengthOf(); e++)
+                buffer[e] = input->e<T>(e);
+
+            output->p(0, SpecialMethods<T>::nthElementGeneric(buffer.get(), input->lengthOf(), n, reverse));
         }
         else { // rank greater than 1
-            std::vector<int> lastDims({input->rankOf() - 1});// = ShapeUtils::evalDimsToExclude(input->rankOf(), {input->rankOf() - 1});
+            std::vector<int> lastDims({input->rankOf() - 1});
+
+            auto tadPack = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(input->shapeInfo(), lastDims);
+            auto tadShapeInfo = tadPack.primaryShapeInfo();
+            auto tadOffsets = tadPack.primaryOffsets();
+
+            const Nd4jLong tadLen = shape::length(tadShapeInfo);
+            const Nd4jLong tadEws = shape::elementWiseStride(tadShapeInfo);
+            auto x = input->bufferAsT<T>();
+            const Nd4jLong grain = nd4j::math::nd4j_max<Nd4jLong>(1, Environment::getInstance()->elementwiseThreshold() / tadLen);
 
-            auto tadPack = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(sortedVals.shapeInfo(), lastDims);
-            SpecialMethods<T>::sortTadGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), lastDims.data(), lastDims.size(), tadPack.primaryShapeInfo(), tadPack.primaryOffsets(), reverse);
+            // every chunk of TADs reuses its own scratch buffer, so input stays intact
+            ThreadPool::getInstance()->parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+                std::unique_ptr<T[]> buffer(new T[tadLen]);
 
-            std::unique_ptr<ResultSet> rows(sortedVals.allTensorsAlongDimension(lastDims));
+                for (auto e = start; e < stop; e++) {
+                    auto tad = x + tadOffsets[e];
 
-            Nd4jLong oL = output->lengthOf();
+                    if (tadEws > 0)
+                        for (Nd4jLong j = 0; j < tadLen; j++)
+                            buffer[j] = tad[j * tadEws];
+                    else
+                        for (Nd4jLong j = 0; j < tadLen; j++)
+                            buffer[j] = tad[shape::getIndexOffset(j, tadShapeInfo, tadLen)];
 
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong e = 0; e < oL; e++) {
-                auto row = rows->at(e);
-                output->p(e, row->e<T>(n));
-            }
+                    output->p(e, SpecialMethods<T>::nthElementGeneric(buffer.get(), tadLen, n, reverse));
+                }
+            }, 0, tadPack.numberOfTads(), grain);
         }
     }
     void nthElementFunctor(NDArray* input, NDArray* n, NDArray* output, bool reverse) {
@@ -20,7 +20,10 @@
 
 #include <ops/declarable/helpers/percentile.h>
 #include <NDArrayFactory.h>
-#include "ResultSet.h"
+#include <helpers/ConstantTadHelper.h>
+#include <helpers/ThreadPool.h>
+#include <specials.h>
+#include <Environment.h>
 
 namespace nd4j    {
 namespace ops     {
@@ -39,43 +42,68 @@ static void _percentile(const NDArray& input, NDArray& output, std::vector<int>&
     else
         shape::checkDimensions(inputRank, axises);          // check, sort dimensions and remove duplicates if they are present
 
+    auto tadPack = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(input.getShapeInfo(), axises);
+    auto tadShapeInfo = tadPack.primaryShapeInfo();
+    auto tadOffsets = tadPack.primaryOffsets();
 
-    auto listOfSubArrs = input.allTensorsAlongDimension(axises);
-    
-    std::vector<Nd4jLong> shapeOfSubArr(listOfSubArrs->at(0)->rankOf());
-    for(int i=0; i<shapeOfSubArr.size(); ++i)
-        shapeOfSubArr[i] = listOfSubArrs->at(0)->shapeOf()[i];
+    const Nd4jLong len = shape::length(tadShapeInfo);
+    const Nd4jLong tadEws = shape::elementWiseStride(tadShapeInfo);
 
-    auto flattenedArr = NDArrayFactory::create('c', shapeOfSubArr, input.dataType(), input.getWorkspace());
-    const int len = flattenedArr.lengthOf();
-    
     const float fraction = 1.f - q / 100.;
     Nd4jLong position = 0;
-    
+    double weight = 0.;
+
     switch(interpolation) {
         case 0: // lower
-            position = static_cast<Nd4jLong>(math::nd4j_ceil<float,T>((len - 1) * fraction));
+            position = static_cast<Nd4jLong>(math::nd4j_ceil<float,float>((len - 1) * fraction));
             break;
         case 1: // higher
-            position = static_cast<Nd4jLong>(math::nd4j_floor<float,T>((len - 1) * fraction));
+            position = static_cast<Nd4jLong>(math::nd4j_floor<float,float>((len - 1) * fraction));
             break;
         case 2: // nearest
-            position = static_cast<Nd4jLong>(math::nd4j_round<float,T>((len - 1) * fraction));
+            position = static_cast<Nd4jLong>(math::nd4j_round<float,float>((len - 1) * fraction));
+            break;
+        case 3: { // linear, interpolated between lower and the next one
+            const double exact = (len - 1) * (1. - q / 100.);
+            position = static_cast<Nd4jLong>(math::nd4j_ceil<double,double>(exact));
+            weight = position - exact;
+        }
             break;
     }
     position = len - position - 1;
 
-    // FIXME: our sort impl should be used instead, so this operation might be implemented as generic
-    PRAGMA_OMP_PARALLEL_FOR_ARGS(firstprivate(flattenedArr))
-    for(int i=0; i<listOfSubArrs->size(); ++i) {
-        
-        T* buff = reinterpret_cast<T *>(flattenedArr.getBuffer());
-        flattenedArr.assign(listOfSubArrs->at(i));
-        std::sort(buff, buff + len);
-        output.p(i, flattenedArr.e<T>(position));
-    }
+    auto x = input.bufferAsT<T>();
+    const Nd4jLong grain = nd4j::math::nd4j_max<Nd4jLong>(1, Environment::getInstance()->elementwiseThreshold() / len);
+
+    // selection instead of full sort, every chunk of TADs reuses its own scratch buffer
+    ThreadPool::getInstance()->parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+        std::unique_ptr<T[]> buffer(new T[len]);
+
+        for (auto i = start; i < stop; i++) {
+            auto tad = x + tadOffsets[i];
+
+            if (tadEws > 0)
+                for (Nd4jLong j = 0; j < len; j++)
+                    buffer[j] = tad[j * tadEws];
+            else
+                for (Nd4jLong j = 0; j < len; j++)
+                    buffer[j] = tad[shape::getIndexOffset(j, tadShapeInfo, len)];
+
+            const T lower = SpecialMethods<T>::nthElementGeneric(buffer.get(), len, position, false);
+
+            if (weight > 0. && position + 1 < len) {
+                // next element in sorted order is the smallest one after selected position
+                T upper = buffer[position + 1];
+                for (Nd4jLong j = position + 2; j < len; j++)
+                    if (buffer[j] < upper)
+                        upper = buffer[j];
 
-    delete listOfSubArrs;
+                output.p(i, static_cast<double>(lower) + (static_cast<double>(upper) - static_cast<double>(lower)) * weight);
+            }
+            else
+                output.p(i, lower);
+        }
+    }, 0, tadPack.numberOfTads(), grain);
 }
 
     void percentile(const NDArray& input, NDArray& output, std::vector<int>& axises, const float q, const int interpolation) {
@@ -19,291 +19,276 @@
 //
 
 #include <ops/declarable/helpers/segment.h>
+#include <helpers/ConstantTadHelper.h>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
-    // segment max
-    template <typename T>
-    static void segmentMaxFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        //int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        Nd4jLong idx = indices->e<Nd4jLong>(0);
-        if (input->isVector()) {
-            T val = input->e<T>(0);
+    // rows of input grouped by segment: target class, [start, end) range in rows and input row ids in group order
+    struct SegmentGroups {
+        std::vector<Nd4jLong> classes;
+        std::vector<Nd4jLong> bounds;
+        std::vector<Nd4jLong> rows;
 
-            for (Nd4jLong e = 1; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<Nd4jLong>(e)) {
-                   // max
-                   val = nd4j::math::nd4j_max<T>(val, input->t<T>(e));
-                }
-                else {
-                    idx = indices->e<Nd4jLong>(e);
-                    val = input->t<T>(e);
-                }
-                output->t<T>(idx) = val;
-            }
+        FORCEINLINE Nd4jLong row(Nd4jLong e) const {
+            return rows.empty() ? e : rows[e];
         }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong loop_size = input->rankOf();
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
+    };
 
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
+    // segment ids are read only once, directly from buffer for the usual integer types
+    static void segmentIds(NDArray* indices, std::vector<Nd4jLong>& ids) {
+        const Nd4jLong length = indices->lengthOf();
+        ids.resize(length);
 
-            auto numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto maxT = listOfOutTensors->at(idx);
+        if (indices->ews() == 1 && indices->dataType() == nd4j::DataType::INT64) {
+            memcpy(ids.data(), indices->getBuffer(), length * sizeof(Nd4jLong));
+        } else if (indices->ews() == 1 && indices->dataType() == nd4j::DataType::INT32) {
+            auto buffer = reinterpret_cast<int *>(indices->getBuffer());
+            PRAGMA_OMP_PARALLEL_FOR_SIMD_ARGS(if(length > Environment::getInstance()->elementwiseThreshold()))
+            for (Nd4jLong e = 0; e < length; e++)
+                ids[e] = buffer[e];
+        } else {
+            for (Nd4jLong e = 0; e < length; e++)
+                ids[e] = indices->e<Nd4jLong>(e);
+        }
+    }
 
-            //int pos = 0;
-            maxT->assign(listOfTensors->at(0));
+    // sorted ids: every run of equal ids is a group, rows are kept in place
+    static void sortedSegmentGroups(NDArray* indices, SegmentGroups& groups) {
+        std::vector<Nd4jLong> ids;
+        segmentIds(indices, ids);
 
-            for (Nd4jLong i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i) == idx) {
+        for (Nd4jLong e = 0; e < (Nd4jLong) ids.size(); e++) {
+            if (e == 0 || ids[e] != ids[e - 1]) {
+                groups.classes.emplace_back(ids[e]);
+                groups.bounds.emplace_back(e);
+            }
+        }
+        groups.bounds.emplace_back(ids.size());
+    }
 
-                    for (Nd4jLong e = 0; e < maxT->lengthOf(); e++) {
-                       maxT->t<T>(e) = nd4j::math::nd4j_max(maxT->t<T>(e), listOfTensors->at(i)->t<T>(e));
-                    }
-                }
-                else {
-                    idx = indices->e<Nd4jLong>(i);
-                    maxT = listOfOutTensors->at(idx);
-                    maxT->assign(listOfTensors->at(i));
-                }
+    // unsorted ids: counting sort of rows by class, rows within a class keep their original order
+    static int unsortedSegmentGroups(NDArray* indices, Nd4jLong numOfClasses, SegmentGroups& groups) {
+        std::vector<Nd4jLong> ids;
+        segmentIds(indices, ids);
+
+        // ids are used as indices below, so out-of-range id must not get there
+        for (auto id: ids)
+            if (id < 0 || id >= numOfClasses) {
+                nd4j_printf("unsorted_segment: segment id %lld is out of range [0, %lld)\n", id, numOfClasses);
+                return ND4J_STATUS_BAD_ARGUMENTS;
+            }
+
+        std::vector<Nd4jLong> counts(numOfClasses + 1, 0);
+        for (auto id: ids)
+            counts[id + 1]++;
 
+        for (Nd4jLong c = 0; c < numOfClasses; c++) {
+            if (counts[c + 1] > 0) {
+                groups.classes.emplace_back(c);
+                groups.bounds.emplace_back(counts[c]);
             }
-            delete listOfTensors;
-            delete listOfOutTensors;
+            counts[c + 1] += counts[c];
         }
+        groups.bounds.emplace_back(ids.size());
+
+        groups.rows.resize(ids.size());
+        for (Nd4jLong e = 0; e < (Nd4jLong) ids.size(); e++)
+            groups.rows[counts[ids[e]]++] = e;
+
+        return ND4J_STATUS_OK;
     }
 
-    // segmen min 
     template <typename T>
-    static void segmentMinFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        //int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        Nd4jLong idx = indices->e<Nd4jLong>(0);
-        if (input->isVector()) {
-            T val = input->e<T>(0);
+    struct SegmentMax {
+        static FORCEINLINE T op(T a, T b) { return nd4j::math::nd4j_max<T>(a, b); }
+        static FORCEINLINE T post(T v, Nd4jLong count) { return v; }
+    };
 
-            for (int e = 1; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<Nd4jLong>(e)) {
-                   // min 
-                   val = nd4j::math::nd4j_min<T>(val, input->t<T>(e));
-                }
-                else {
-                    idx = indices->e<int>(e);
-                    val = input->t<T>(e);
-                }
-                output->t<T>(idx) = val;
-            }
-        }
-        else {
+    template <typename T>
+    struct SegmentMin {
+        static FORCEINLINE T op(T a, T b) { return nd4j::math::nd4j_min<T>(a, b); }
+        static FORCEINLINE T post(T v, Nd4jLong count) { return v; }
+    };
+
+    template <typename T>
+    struct SegmentSum {
+        static FORCEINLINE T op(T a, T b) { return a + b; }
+        static FORCEINLINE T post(T v, Nd4jLong count) { return v; }
+    };
+
+    template <typename T>
+    struct SegmentProd {
+        static FORCEINLINE T op(T a, T b) { return a * b; }
+        static FORCEINLINE T post(T v, Nd4jLong count) { return v; }
+    };
+
+    template <typename T>
+    struct SegmentMean {
+        static FORCEINLINE T op(T a, T b) { return a + b; }
+        static FORCEINLINE T post(T v, Nd4jLong count) { return static_cast<T>(static_cast<double>(v) / count); }
+    };
+
+    template <typename T>
+    struct SegmentSqrtN {
+        static FORCEINLINE T op(T a, T b) { return a + b; }
+        static FORCEINLINE T post(T v, Nd4jLong count) { return static_cast<T>(static_cast<double>(v) / nd4j::math::nd4j_sqrt<Nd4jLong, double>(count)); }
+    };
+
+    /**
+     * Reduces every group of input rows into the output row of its class: the first row is copied,
+     * the rest are combined with R::op along the row, and R::post is applied with the group size.
+     * Groups are independent, so they're processed in parallel. Output rows without a group are left untouched.
+     */
+    template <typename T, typename R>
+    static void segmentReduce_(NDArray* input, NDArray* output, const SegmentGroups& groups) {
+        const Nd4jLong numOfGroups = groups.classes.size();
+        if (numOfGroups == 0)
+            return;
+
+        auto x = input->bufferAsT<T>();
+        auto z = output->bufferAsT<T>();
+
+        // rank-1 arrays are handled as rows of a single element
+        const bool isVector = input->rankOf() == 1;
+        Nd4jLong rowLength = 1;
+        Nd4jLong xEws = 1, zEws = 1;
+        Nd4jLong *xOffsets = nullptr, *zOffsets = nullptr;
+        Nd4jLong *xTadShape = nullptr, *zTadShape = nullptr;
+
+        TadPack packX, packZ;
+        if (!isVector) {
             std::vector<int> restDims(input->rankOf() - 1);
-            auto loop_length = input->rankOf();
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int e = 1; e < loop_length; e++)
+            for (int e = 1; e < input->rankOf(); e++)
                 restDims[e - 1] = e;
 
-            std::unique_ptr<ResultSet> listOfTensors( input->allTensorsAlongDimension(restDims) );
-            std::unique_ptr<ResultSet> listOfOutTensors( output->allTensorsAlongDimension(restDims) );
-
-            int numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto minT = listOfOutTensors->at(idx);
+            packX = ConstantTadHelper::getInstance()->tadForDimensions(input->getShapeInfo(), restDims);
+            packZ = ConstantTadHelper::getInstance()->tadForDimensions(output->getShapeInfo(), restDims);
 
-            int pos = 0;
-            minT->assign(listOfTensors->at(0));
+            xTadShape = packX.primaryShapeInfo();
+            zTadShape = packZ.primaryShapeInfo();
+            xOffsets = packX.primaryOffsets();
+            zOffsets = packZ.primaryOffsets();
+            rowLength = shape::length(xTadShape);
+            xEws = shape::elementWiseStride(xTadShape);
+            zEws = shape::elementWiseStride(zTadShape);
+        }
 
-            for (Nd4jLong i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<T>(i) == idx) {
+        const bool contiguous = xEws == 1 && zEws == 1;
 
-                    for (int e = 0; e < minT->lengthOf(); e++) {
-                       minT->p(e, nd4j::math::nd4j_min(minT->e<T>(e), listOfTensors->at(i)->e<T>(e)));
-                    }
-                }
-                else {
-                    idx = indices->e<T>(i);
-                    minT = listOfOutTensors->at(idx);
-                    minT->assign(listOfTensors->at(i));
-                }
+        // element offsets within a row are the same for all rows, so they're computed once
+        std::vector<Nd4jLong> xInner, zInner;
+        if (!contiguous) {
+            xInner.resize(rowLength);
+            zInner.resize(rowLength);
+            for (Nd4jLong e = 0; e < rowLength; e++) {
+                xInner[e] = xEws > 0 ? e * xEws : shape::getIndexOffset(e, xTadShape, rowLength);
+                zInner[e] = zEws > 0 ? e * zEws : shape::getIndexOffset(e, zTadShape, rowLength);
             }
         }
-    }
 
-    // segmen mean
-    template <typename T>
-    static void segmentMeanFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        int idx = indices->e<int>(0);
-        if (input->isVector()) {
-            T val = T(0.f);
-            int count = 0;
-
-            for (int e = 0; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<int>(e)) {
-                   // mean 
-                   val += input->e<T>(e);
-                   count++;
+        auto xRow = [&](Nd4jLong r) -> Nd4jLong {
+            return isVector ? shape::getIndexOffset(r, input->getShapeInfo(), input->lengthOf()) : xOffsets[r];
+        };
+        auto zRow = [&](Nd4jLong c) -> Nd4jLong {
+            return isVector ? shape::getIndexOffset(c, output->getShapeInfo(), output->lengthOf()) : zOffsets[c];
+        };
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(numOfGroups > 1 && input->lengthOf() > Environment::getInstance()->elementwiseThreshold()) schedule(guided))
+        for (Nd4jLong g = 0; g < numOfGroups; g++) {
+            const Nd4jLong start = groups.bounds[g];
+            const Nd4jLong end = groups.bounds[g + 1];
+            const Nd4jLong count = end - start;
+
+            auto zR = z + zRow(groups.classes[g]);
+            auto xF = x + xRow(groups.row(start));
+
+            if (contiguous) {
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < rowLength; e++)
+                    zR[e] = xF[e];
+
+                for (Nd4jLong r = start + 1; r < end; r++) {
+                    auto xR = x + xRow(groups.row(r));
+
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong e = 0; e < rowLength; e++)
+                        zR[e] = R::op(zR[e], xR[e]);
                 }
-                else {
-                   output->p<T>(idx, val / count);
-                    idx = indices->e<int>(e);
-                    val = input->e<T>(e);
-                    count = 1;
+
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < rowLength; e++)
+                    zR[e] = R::post(zR[e], count);
+            } else {
+                for (Nd4jLong e = 0; e < rowLength; e++)
+                    zR[zInner[e]] = xF[xInner[e]];
+
+                for (Nd4jLong r = start + 1; r < end; r++) {
+                    auto xR = x + xRow(groups.row(r));
+
+                    for (Nd4jLong e = 0; e < rowLength; e++)
+                        zR[zInner[e]] = R::op(zR[zInner[e]], xR[xInner[e]]);
                 }
-                output->p<T>(idx, val / count);
+
+                for (Nd4jLong e = 0; e < rowLength; e++)
+                    zR[zInner[e]] = R::post(zR[zInner[e]], count);
             }
         }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
+    }
 
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            int numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto meanT = listOfOutTensors->at(idx);
-            int count = 1;
-            auto meanV = meanT->dup();
-            meanV->assign(listOfTensors->at(0));
-
-            for (int i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i) == idx) {
-                    PRAGMA_OMP_PARALLEL_FOR
-                    for (int e = 0; e < meanT->lengthOf(); e++) {
-                       meanV->p<T>(e, meanV->e<T>(e) + listOfTensors->at(i)->e<T>(e));
-                    }
-                    count++;
-                }
-                else {
-                    //meanT->assign(meanV);
-                    meanV->applyScalar(scalar::Divide, count, meanT, nullptr);
-                    idx = indices->e<int>(i);
-                    meanT = listOfOutTensors->at(idx);
-                    meanV->assign(listOfTensors->at(i));
-                    count = 1;
-                }
-                meanV->applyScalar(scalar::Divide, count, meanT, nullptr);
-            }
-            delete meanV;
-            delete listOfTensors;
-            delete listOfOutTensors;
+    // kernels work on input data type, any other output type goes through a temporary array
+    template <typename T, typename R>
+    static void segmentReduce(NDArray* input, NDArray* output, const SegmentGroups& groups) {
+        if (output->dataType() == input->dataType()) {
+            segmentReduce_<T, R>(input, output, groups);
+            return;
         }
+
+        NDArray temp(output->ordering(), output->getShapeAsVector(), input->dataType(), output->getWorkspace());
+        temp.assign(output);
+        segmentReduce_<T, R>(input, &temp, groups);
+        output->assign(temp);
     }
 
+    // segment max
     template <typename T>
-    static void segmentSumFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        int idx = indices->e<int>(0);
-        if (input->isVector()) {
-            T val = T(0.f);
-            int count = 0;
-            for (int e = 0; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<int>(e)) {
-                   // sum 
-                   val += input->t<T>(e);
-                }
-                else {
-                    idx = indices->e<int>(e);
-                    val = input->t<T>(e);
-                }
-                output->p(idx, val);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-	    int loop_size = input->rankOf();
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
+    static void segmentMaxFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
+        SegmentGroups groups;
+        sortedSegmentGroups(indices, groups);
+        segmentReduce<T, SegmentMax<T>>(input, output, groups);
+    }
 
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
+    // segmen min 
+    template <typename T>
+    static void segmentMinFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
+        SegmentGroups groups;
+        sortedSegmentGroups(indices, groups);
+        segmentReduce<T, SegmentMin<T>>(input, output, groups);
+    }
 
-            int numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto sumT = listOfOutTensors->at(idx);
+    // segmen mean
+    template <typename T>
+    static void segmentMeanFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
+        SegmentGroups groups;
+        sortedSegmentGroups(indices, groups);
+        segmentReduce<T, SegmentMean<T>>(input, output, groups);
+    }
 
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i) == idx) {
-                    PRAGMA_OMP_PARALLEL_FOR
-                    for (int e = 0; e < sumT->lengthOf(); e++) {
-                       sumT->p(e, sumT->e<T>(e) + listOfTensors->at(i)->e<T>(e));
-                    }
-                }
-                else {
-                    idx = indices->e<int>(i);
-                    sumT = listOfOutTensors->at(idx);
-                    sumT->assign(listOfTensors->at(i));
-                }
-            }
-            delete listOfTensors;
-            delete listOfOutTensors;
-        }
+    template <typename T>
+    static void segmentSumFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
+        SegmentGroups groups;
+        sortedSegmentGroups(indices, groups);
+        segmentReduce<T, SegmentSum<T>>(input, output, groups);
     }
 
     template <typename T>
     static void segmentProdFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        //int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        int idx = indices->e<int>(0);
         output->assign(1.f);
-        if (input->isVector()) {
-            T val = input->e<T>(0);
-            int count = 0;
-
-            for (int e = 1; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<int>(e)) {
-                   // sum 
-                   val *= input->e<T>(e);
-                }
-                else {
-                    idx = indices->e<int>(e);
-                    val = input->e<T>(e);
-                }
-                output->p(idx, val);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            PRAGMA_OMP_SIMD
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
 
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            int numOfClasses = output->sizeAt(0); // number of classes
-            auto sumT = listOfOutTensors->at(idx);
-            sumT->assign(listOfTensors->at(0));
-            for (int i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i)  == idx) {
-                    PRAGMA_OMP_PARALLEL_FOR
-                    for (int e = 0; e < sumT->lengthOf(); e++) {
-                       sumT->p(e, sumT->e<T>(e) * listOfTensors->at(i)->e<T>(e));
-                    }
-                }
-                else {
-                    idx = indices->e<int>(i);
-                    sumT = listOfOutTensors->at(idx);
-                    sumT->assign(listOfTensors->at(i));
-                }
-            }
-            delete listOfTensors;
-            delete listOfOutTensors;
-        }
+        SegmentGroups groups;
+        sortedSegmentGroups(indices, groups);
+        segmentReduce<T, SegmentProd<T>>(input, output, groups);
     }
 
 //    template <typename T>
@@ -365,286 +350,111 @@ namespace helpers {
     }
 
     template <typename T>
-    static void unsortedSegmentMaxFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+    static int unsortedSegmentMaxFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        T maxVal = DataTypeUtils::max<T>();
+        output->assign(-maxVal);
 
-        // if input is a vector: (as if in doc sample)
-        //int idx = static_cast<int>((*indices)(0.));
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
+        SegmentGroups groups;
+        auto status = unsortedSegmentGroups(indices, numOfClasses, groups);
+        if (status != ND4J_STATUS_OK)
+            return status;
 
-        if (input->isVector()) { // 1D case
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(-maxVal);
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                T val = input->e<T>(fi->second.at(0));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    val = nd4j::math::nd4j_max(val, input->e<T>(fi->second.at(idx)));
-                }
-                output->p(fi->first, val);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong idx = idxs[0][0];
-            int loop_size = input->rankOf();
-            PRAGMA_OMP_SIMD
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
+        segmentReduce<T, SegmentMax<T>>(input, output, groups);
 
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(-maxVal);
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto maxT = listOfTensors->at(fi->second.at(idx));
-                    for (Nd4jLong e = 0; e < outputT->lengthOf(); ++e) {
-                        T val = nd4j::math::nd4j_max(maxT->e<T>(e), outputT->e<T>(e));
-
-                        outputT->p(e, val);
-                    }
-                }
-                //outputT->assign(maxT);
-            }
-        }
+        return ND4J_STATUS_OK;
     }
-    void unsortedSegmentMaxFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentMaxFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
+    int unsortedSegmentMaxFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(input->dataType(), return unsortedSegmentMaxFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
     }
-    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMaxFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
+    BUILD_SINGLE_TEMPLATE(template int unsortedSegmentMaxFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
     template <typename T>
-    static void unsortedSegmentMinFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        // if input is a vector: (as if in doc sample)
-        //int idx = static_cast<int>((*indices)(0.));
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
-
-        if (input->isVector()) { // 1D case
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(maxVal);
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                T val = input->t<T>(fi->second.at(0));
-
-                for (size_t idx = 1; idx < fi->second.size(); ++idx) {
-                    val = nd4j::math::nd4j_min(val, input->t<T>(fi->second.at(idx)));
-                }
-                output->t<T>(fi->first) = val;
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong idx = idxs[0][0];
-            for (int e = 1; e < input->rankOf(); e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(maxVal);
+    static int unsortedSegmentMinFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        T maxVal = DataTypeUtils::max<T>();
+        output->assign(maxVal);
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto minT = listOfTensors->at(fi->second.at(idx));
+        SegmentGroups groups;
+        auto status = unsortedSegmentGroups(indices, numOfClasses, groups);
+        if (status != ND4J_STATUS_OK)
+            return status;
 
-                    for (Nd4jLong e = 0; e < outputT->lengthOf(); ++e) {
-                        outputT->t<T>(e) = nd4j::math::nd4j_min(minT->t<T>(e), outputT->t<T>(e));
-                    }
-                }
-                //outputT->assign(maxT);
-            }
-        }
+        segmentReduce<T, SegmentMin<T>>(input, output, groups);
 
+        return ND4J_STATUS_OK;
     }
-    void unsortedSegmentMinFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentMinFunctor_, (input, indices, numOfClasses, output),
+    int unsortedSegmentMinFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(input->dataType(), return unsortedSegmentMinFunctor_, (input, indices, numOfClasses, output),
                               NUMERIC_TYPES);
     }
 
-    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMinFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
-
-    void unsortedSegmentMeanFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
+    BUILD_SINGLE_TEMPLATE(template int unsortedSegmentMinFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
-        if (input->isVector()) { // 1D case
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                double sumValue = input->e<double>(fi->second.at(0));
-                int loop_size = fi->second.size();
-                PRAGMA_OMP_PARALLEL_FOR_SIMD_REDUCTION(+:sumValue)
-                for (size_t idx = 1; idx < loop_size; ++idx) {
-                    sumValue += input->e<double>(fi->second.at(idx));
-                }
-
-                output->p(fi->first, sumValue / fi->second.size());
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong loop_size= input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
+    template <typename T>
+    static int unsortedSegmentMeanFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        SegmentGroups groups;
+        auto status = unsortedSegmentGroups(indices, numOfClasses, groups);
+        if (status != ND4J_STATUS_OK)
+            return status;
 
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+        segmentReduce<T, SegmentMean<T>>(input, output, groups);
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                loop_size = fi->second.size();
-                PRAGMA_OMP_PARALLEL_FOR
-                for (Nd4jLong idx = 1; idx < loop_size; ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-                    *outputT += *current;
-                }
-                (*outputT) /= double(fi->second.size());
-            }
-        }
+        return ND4J_STATUS_OK;
     }
+    int unsortedSegmentMeanFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(input->dataType(), return unsortedSegmentMeanFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
+    }
+    BUILD_SINGLE_TEMPLATE(template int unsortedSegmentMeanFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
-    void unsortedSegmentSumFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        if (input->isVector()) { // 1D case
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                double sumValue = input->e<double>(fi->second.at(0));
-                Nd4jLong loop_size = fi->second.size();
-                PRAGMA_OMP_PARALLEL_FOR_REDUCTION(+:sumValue)
-                for (Nd4jLong idx = 1; idx < loop_size; ++idx) {
-                    sumValue += input->e<double>(fi->second.at(idx));
-                }
-                output->p(fi->first, sumValue);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
+    template <typename T>
+    static int unsortedSegmentSumFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        SegmentGroups groups;
+        auto status = unsortedSegmentGroups(indices, numOfClasses, groups);
+        if (status != ND4J_STATUS_OK)
+            return status;
 
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+        segmentReduce<T, SegmentSum<T>>(input, output, groups);
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                Nd4jLong loop_size = fi->second.size();
-                PRAGMA_OMP_PARALLEL_FOR
-                for (Nd4jLong idx = 1; idx < loop_size; ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-                    *(outputT) += *current;
-                }
-                //outputT->assign(maxT);
-            }
-        }
+        return ND4J_STATUS_OK;
+    }
+    int unsortedSegmentSumFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(input->dataType(), return unsortedSegmentSumFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
     }
+    BUILD_SINGLE_TEMPLATE(template int unsortedSegmentSumFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
     template <typename T>
-    void unsortedSegmentProdFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
-
+    int unsortedSegmentProdFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
         output->assign(1.f);
 
-        if (input->isVector()) { // 1D case
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                T prodValue = input->e<T>(fi->second.at(0));
-                for (size_t idx = 1; idx < fi->second.size(); ++idx) {
-                    prodValue *= input->e<T>(fi->second.at(idx));
-                }
-                output->p(fi->first, prodValue);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
+        SegmentGroups groups;
+        auto status = unsortedSegmentGroups(indices, numOfClasses, groups);
+        if (status != ND4J_STATUS_OK)
+            return status;
 
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
+        segmentReduce<T, SegmentProd<T>>(input, output, groups);
 
-                    *outputT *= *current;
-                }
-            }
-        }
+        return ND4J_STATUS_OK;
     }
 
-    void unsortedSegmentProdFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentProdFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
+    int unsortedSegmentProdFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(input->dataType(), return unsortedSegmentProdFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
     }
-    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentProdFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
-
-    void unsortedSegmentSqrtNFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
+    BUILD_SINGLE_TEMPLATE(template int unsortedSegmentProdFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
-        if (input->isVector()) { // 1D case
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                double sumValue = input->e<double>(fi->second.at(0));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    sumValue += input->e<double>(fi->second.at(idx));
-                }
-                output->p(fi->first, sumValue / nd4j::math::nd4j_sqrt<Nd4jLong, double>(fi->second.size()));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-
-            int loop_size =  input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
+    template <typename T>
+    static int unsortedSegmentSqrtNFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        SegmentGroups groups;
+        auto status = unsortedSegmentGroups(indices, numOfClasses, groups);
+        if (status != ND4J_STATUS_OK)
+            return status;
 
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+        segmentReduce<T, SegmentSqrtN<T>>(input, output, groups);
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-                    *outputT += *current;
-                }
-                //outputT->assign(maxT);
-                (*outputT) /= nd4j::math::nd4j_sqrt<size_t, double>(fi->second.size());
-            }
-        }
+        return ND4J_STATUS_OK;
     }
+    int unsortedSegmentSqrtNFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(input->dataType(), return unsortedSegmentSqrtNFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
+    }
+    BUILD_SINGLE_TEMPLATE(template int unsortedSegmentSqrtNFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
     // -------------------------------------------------------------------------------------------------------------- //
     // Backpropagate ops helpers
@@ -877,7 +687,12 @@ namespace helpers {
 //        int numOfClasses = gradOut->sizeAt(0);
         // if input is a vector: (as if in doc sample)
         auto tempRes = gradOut->dup();
-        unsortedSegmentMaxFunctor(input, indices, numOfClasses, tempRes);
+        auto status = unsortedSegmentMaxFunctor(input, indices, numOfClasses, tempRes);
+        if (status != ND4J_STATUS_OK) {
+            delete tempRes;
+            return status;
+        }
+
         if (input->isVector()) {
 
             for (Nd4jLong e = 0; e < input->lengthOf(); ++e) {
@@ -919,7 +734,12 @@ namespace helpers {
     template <typename T>
     static int unsortedSegmentMinFunctorBP_(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
         auto tempRes = gradOut->dup();
-        unsortedSegmentMinFunctor(input, indices, numOfClasses, tempRes);
+        auto status = unsortedSegmentMinFunctor(input, indices, numOfClasses, tempRes);
+        if (status != ND4J_STATUS_OK) {
+            delete tempRes;
+            return status;
+        }
+
         if (input->isVector()) {
 
             PRAGMA_OMP_PARALLEL_FOR
@@ -1040,7 +860,12 @@ namespace helpers {
     int unsortedSegmentProdFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
         auto tempRes = gradOut->dup();
 
-        unsortedSegmentProdFunctor(input, indices, numOfClasses, tempRes);
+        auto status = unsortedSegmentProdFunctor(input, indices, numOfClasses, tempRes);
+        if (status != ND4J_STATUS_OK) {
+            delete tempRes;
+            return status;
+        }
+
         if (input->isVector()) {
             PRAGMA_OMP_PARALLEL_FOR
             for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
@@ -21,120 +21,141 @@
 #include <ops/declarable/helpers/top_k.h>
 #include <ops/declarable/headers/parity_ops.h>
 #include <NDArrayFactory.h>
+#include <helpers/ConstantTadHelper.h>
+#include <specials.h>
+#include <algorithm>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
+    template <typename T>
+    static FORCEINLINE bool topKIsNan(T value) {
+        // half types go through double, so every NaN pattern is caught
+        auto v = static_cast<double>(value);
+        return v != v;
+    }
+
+    // (value, index) candidate; "better" means larger value, NaN is larger than anything, ties go to the lower index
+    template <typename T>
+    static FORCEINLINE bool topKBetter(const std::pair<T, Nd4jLong>& a, const std::pair<T, Nd4jLong>& b) {
+        const bool nanA = topKIsNan(a.first);
+        const bool nanB = topKIsNan(b.first);
+        if (nanA || nanB)
+            return nanA && (!nanB || a.second < b.second);
+
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    }
+
     template <typename T>
     static int topKFunctor_(NDArray* input, NDArray* values, NDArray* indeces, int k, bool needSort) {
-        Nd4jLong width = input->sizeAt(-1);
-//        Nd4jLong lastDim = input->rankOf() - 1;
-//      FIX ME: lastDim should be Nd4Long not int only?
-        int lastDim = input->rankOf() - 1;
-//        std::unique_ptr<ResultSet> lastDimList(input->allTensorsAlongDimension({lastDim}));
-// ----------------------------------------------------------------------------------------------- //
-// this assumption is right:
-//        if (values->lengthOf() != k * lastDimList->size()) {
-//            nd4j_printf("top_k: something is wrong. %i expected, but %i given.\n",
-//                values->lengthOf(), k * lastDimList->size());
-//        }
-// ----------------------------------------------------------------------------------------------- //
-        std::vector<int> dimsToExclude(input->rankOf() - 1);
+        const int lastDim = input->rankOf() - 1;
+        const Nd4jLong width = input->sizeAt(-1);
+
+        std::vector<int> dimsToExclude(lastDim);
         for (int d = 0; d < dimsToExclude.size(); ++d)
             dimsToExclude[d] = d;
 
-        const Nd4jLong numOfSubArrs = ShapeUtils::getNumOfSubArrs(input->getShapeInfo(), dimsToExclude);
-
-            if (k == 1) {
-                for (Nd4jLong e = 0; e < numOfSubArrs; ++e) {
-                    auto trial = (*input)(e, dimsToExclude);
-                    //int maxPos = //lastDimList->at(e)->argMax();
-                    Nd4jLong maxPos = 0;
-                    //trial.printIndexedBuffer("TRIAL:");
-                    T maxVal = trial.e<T>(0);
-                    for (Nd4jLong pos = 1; pos < trial.lengthOf(); pos++)
-                        if (maxVal < trial.e<T>(pos)) {
-                            maxPos = pos;
-                            maxVal = trial.e<T>(pos);
-                        }
-                    if (indeces)
-                        indeces->p(e, maxPos); //topIndex;
-                    if (values)
-                        values->p(e, maxVal);
+        auto packX = ConstantTadHelper::getInstance()->tadForDimensions(input->getShapeInfo(), {lastDim});
+        auto tadShapeInfo = packX.primaryShapeInfo();
+        auto tadOffsets = packX.primaryOffsets();
+        const Nd4jLong numOfSubArrs = packX.numberOfTads();
+        const Nd4jLong tadEws = shape::elementWiseStride(tadShapeInfo);
+        auto x = input->bufferAsT<T>();
+
+        // outputs of default types are written in place, anything else goes through sub-array views
+        const bool directV = values == nullptr || values->dataType() == input->dataType();
+        const bool directI = indeces == nullptr || indeces->dataType() == nd4j::DataType::INT64;
+
+        TadPack packV, packI;
+        if (values != nullptr && directV)
+            packV = ConstantTadHelper::getInstance()->tadForDimensions(values->getShapeInfo(), {lastDim});
+        if (indeces != nullptr && directI)
+            packI = ConstantTadHelper::getInstance()->tadForDimensions(indeces->getShapeInfo(), {lastDim});
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(numOfSubArrs > 1 && numOfSubArrs * width > Environment::getInstance()->elementwiseThreshold()) schedule(guided))
+        for (Nd4jLong e = 0; e < numOfSubArrs; ++e) {
+            auto trial = x + tadOffsets[e];
+            auto element = [&](Nd4jLong i) -> T {
+                return tadEws > 0 ? trial[i * tadEws] : trial[shape::getIndexOffset(i, tadShapeInfo, width)];
+            };
+
+            std::vector<std::pair<T, Nd4jLong>> heap(k);
+
+            if (k * 4 >= width) {
+                // large k: stable descending sort of the whole row keeps lower indices first among equal values.
+                // Order must match topKBetter, so NaNs go first by index, and -0 is sorted as +0
+                const T zero = static_cast<T>(0);
+                std::unique_ptr<T[]> keys(new T[width]);
+                std::unique_ptr<Nd4jLong[]> positions(new Nd4jLong[width]);
+                Nd4jLong numNans = 0, numKeys = 0;
+                for (Nd4jLong i = 0; i < width; ++i) {
+                    T val = element(i);
+                    if (topKIsNan(val)) {
+                        if (numNans < k)
+                            heap[numNans] = std::make_pair(val, i);
+                        numNans++;
+                    } else {
+                        keys[numKeys] = val == zero ? zero : val;
+                        positions[numKeys++] = i;
+                    }
+                }
+
+                SpecialMethods<T>::sortBufferByKey(keys.get(), positions.get(), numKeys, true);
+
+                for (Nd4jLong pos = numNans; pos < k; ++pos) {
+                    auto i = positions[pos - numNans];
+                    heap[pos] = std::make_pair(element(i), i);
                 }
             }
-            else { 
-                int nextPos = 0;
-
-                for (Nd4jLong e = 0; e < numOfSubArrs; ++e) {
-                    auto trial = (*input)(e, dimsToExclude);
-
-                    // fill up the first k elements
-                    NDArray topValues = NDArrayFactory::create<T>('c', {k});
-                    NDArray sortedVals = NDArrayFactory::create<T>('c', {k});
-                    NDArray topIndices = NDArrayFactory::create<Nd4jLong>('c', {k});
-                    for (Nd4jLong pos = 0; pos < k; ++pos) {
-                        topIndices.t<Nd4jLong>(pos) = pos;
-                        topValues.t<T>(pos) = trial.t<T>(pos);
-                    }
-                    //std::vector<T> sortedVals(topValues);
-                    sortedVals.assign(topValues);// = NDArrayFactory::create<T>('c', {k});
-                    //std::sort(sortedVals.begin(), sortedVals.end()); // sorted in ascending order
-                    SpecialMethods<T>::sortGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), false);
-                    for (int i = k; i < width; ++i) {
-                        T val = trial.e<T>(i);
-                        T minTopVal = sortedVals.t<T>(0);
-                        if (minTopVal < val) { // value should be inserted to top k
-                            // only if it is not contained in
-                            T* begin = reinterpret_cast<T*>(sortedVals.buffer());
-                            T* end = begin + k;
-                            bool exists = std::binary_search(begin, end, val);
-                            if (!exists) {
-                                //exchangePos - a distance between begin and minimal existed to be suppressed by val
-                                T* topBegin = reinterpret_cast<T*>(topValues.buffer());
-                                T* topEnd = topBegin + k;
-                                auto exchangePos = std::distance(topBegin, std::find(topBegin, topEnd, sortedVals.t<T>(0)));
-                                topValues.t<T>(exchangePos) = val; //*exchangeIt = val;
-                                topIndices.t<Nd4jLong>(exchangePos) = i;
-                                sortedVals.t<T>(0) = val; // suppress in sorted
-                                //std::sort(sortedVals.begin(), sortedVals.end()); // sorted in ascending order
-                                SpecialMethods<T>::sortGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), false);
-                            }
-                        }
+            else {
+                // min-heap on "better": the root is the weakest of the current top k
+                for (Nd4jLong pos = 0; pos < k; ++pos)
+                    heap[pos] = std::make_pair(element(pos), pos);
+                std::make_heap(heap.begin(), heap.end(), topKBetter<T>);
+
+                for (Nd4jLong i = k; i < width; ++i) {
+                    auto candidate = std::make_pair(element(i), i);
+                    // equal values never win against an earlier index
+                    if (topKBetter(candidate, heap.front())) {
+                        std::pop_heap(heap.begin(), heap.end(), topKBetter<T>);
+                        heap.back() = candidate;
+                        std::push_heap(heap.begin(), heap.end(), topKBetter<T>);
                     }
-                    if (needSort) {
-                        SpecialMethods<T>::sortGeneric(topValues.buffer(), topValues.shapeInfo(), true);
+                }
 
-                        for (int j = 0; j < width; j++)
-                            for (int pos = 0; pos < k; ++pos)
-                                if (topValues.t<T>(pos) == trial.t<T>(j))
-                                    topIndices.t<Nd4jLong>(pos) = j;
-                    }
-                    else { // else sort by indices
-                        std::map<Nd4jLong, T> sortValsMap;
-                        //std::vector<std::pair<int, T>> data(topValues.lengthOf());
-                        for (size_t e = 0; e < topValues.lengthOf(); ++e) {
-                            sortValsMap[topIndices.t<Nd4jLong>(e)] = topValues.t<T>(e);
-                        }
+                if (needSort)
+                    std::sort(heap.begin(), heap.end(), topKBetter<T>);
+            }
 
-                        //std::sort(data.begin(), data.end(), [](std::pair<int, T> const& a, std::pair<int, T> const& b) {
-                        //    return a.first < b.first;
-                        //});
-                        Nd4jLong e = 0;
-                        for (auto it = sortValsMap.begin(); it != sortValsMap.end(); ++it, e++) {
-                            topIndices.t<Nd4jLong>(e) = it->first;
-                            topValues.t<T>(e) = it->second;
-                        }
+            if (!needSort)
+                std::sort(heap.begin(), heap.end(), [](const std::pair<T, Nd4jLong>& a, const std::pair<T, Nd4jLong>& b) { return a.second < b.second; });
+
+            if (values != nullptr) {
+                if (directV) {
+                    auto z = values->bufferAsT<T>() + packV.primaryOffsets()[e];
+                    for (int pos = 0; pos < k; ++pos)
+                        z[shape::getIndexOffset(pos, packV.primaryShapeInfo(), k)] = heap[pos].first;
+                } else {
+                    auto z = (*values)(e, dimsToExclude);
+                    for (int pos = 0; pos < k; ++pos)
+                        z.p(pos, heap[pos].first);
+                }
+            }
 
-                    }
-                    if (values)
-                    (*values)(e, dimsToExclude).assign(topValues);
-                    if (indeces)
-                    (*indeces)(e, dimsToExclude).assign(topIndices);
+            if (indeces != nullptr) {
+                if (directI) {
+                    auto z = indeces->bufferAsT<Nd4jLong>() + packI.primaryOffsets()[e];
+                    for (int pos = 0; pos < k; ++pos)
+                        z[shape::getIndexOffset(pos, packI.primaryShapeInfo(), k)] = heap[pos].second;
+                } else {
+                    auto z = (*indeces)(e, dimsToExclude);
+                    for (int pos = 0; pos < k; ++pos)
+                        z.p(pos, heap[pos].second);
                 }
-                //indeces->printIndexedBuffer("Indices as is");
+            }
         }
+
         return Status::OK();
     }
 // ----------------------------------------------------------------------------------------------- //
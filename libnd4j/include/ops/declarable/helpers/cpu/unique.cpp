@@ -20,6 +20,8 @@
 
 #include <ops/declarable/helpers/unique.h>
 #include <Status.h>
+#include <specials.h>
+#include <memory>
 
 namespace nd4j {
 namespace ops {
@@ -27,17 +29,22 @@ namespace helpers {
 
     template <typename T>
     static Nd4jLong uniqueCount_(NDArray* input) {
-        Nd4jLong count = 0;
+        const Nd4jLong length = input->lengthOf();
+        if (length == 0)
+            return 0;
 
-        std::vector<T> values;
+        std::unique_ptr<T[]> sorted(new T[length]);
+        for (Nd4jLong e = 0; e < length; e++)
+            sorted[e] = input->e<T>(e);
 
-        for (int e = 0; e < input->lengthOf(); e++) {
-            T v = input->e<T>(e);
-            if (std::find(values.begin(), values.end(), v) == values.end()) {
-                values.push_back(v);
+        SpecialMethods<T>::sortBuffer(sorted.get(), length, false);
+
+        // NaN isn't equal to anything, so every NaN counts on its own, same as before
+        Nd4jLong count = 1;
+        for (Nd4jLong e = 1; e < length; e++)
+            if (!(sorted[e] == sorted[e - 1]))
                 count++;
-            }
-        }
+
         return count;
     }
 
@@ -50,34 +57,49 @@ namespace helpers {
 
     template <typename T>
     static Nd4jStatus uniqueFunctor_(NDArray* input, NDArray* values, NDArray* indices, NDArray* counts) {
-    
-        std::vector<T> valuesVector;
-        std::map<T, int> indicesMap;
-        std::map<T, int> countsMap;
-
-        for (int e = 0; e < input->lengthOf(); e++) {
+        const Nd4jLong length = input->lengthOf();
+        if (length == 0)
+            return Status::OK();
+
+        // stable sort keeps first occurrence of each value at the head of its group.
+        // -0 and +0 are equal, so both are sorted as +0, otherwise radix order would put -0 first
+        const T zero = static_cast<T>(0);
+        std::unique_ptr<T[]> sorted(new T[length]);
+        std::unique_ptr<Nd4jLong[]> positions(new Nd4jLong[length]);
+        for (Nd4jLong e = 0; e < length; e++) {
             T v = input->e<T>(e);
-            if (std::find(valuesVector.begin(), valuesVector.end(), v) == valuesVector.end()) {
-                valuesVector.push_back(v);
-                indicesMap[v] = e;
-                countsMap[v] = 1;
-            }
-            else {
-                countsMap[v]++;
-            }
+            sorted[e] = v == zero ? zero : v;
+            positions[e] = e;
         }
 
-        PRAGMA_OMP_PARALLEL_FOR_IF(values->lengthOf() > Environment::getInstance()->elementwiseThreshold())
-        for (int e = 0; e < values->lengthOf(); e++) {
-            values->p(e, static_cast<T>(valuesVector[e]));
-            if (counts != nullptr) 
-                counts->p(e, countsMap[valuesVector[e]]);
+        SpecialMethods<T>::sortBufferByKey(sorted.get(), positions.get(), length, false);
+
+        std::vector<Nd4jLong> groupStart;
+        for (Nd4jLong e = 0; e < length; e++)
+            if (e == 0 || !(sorted[e] == sorted[e - 1]))
+                groupStart.emplace_back(e);
+
+        const Nd4jLong numGroups = groupStart.size();
+        groupStart.emplace_back(length);
+
+        // unique values go out in order of their first occurrence
+        std::unique_ptr<Nd4jLong[]> firstPos(new Nd4jLong[numGroups]);
+        std::unique_ptr<Nd4jLong[]> groupOrder(new Nd4jLong[numGroups]);
+        for (Nd4jLong g = 0; g < numGroups; g++) {
+            firstPos[g] = positions[groupStart[g]];
+            groupOrder[g] = g;
         }
 
-        for (int e = 0; e < indices->lengthOf(); e++) {
-            auto posI = std::find(valuesVector.begin(), valuesVector.end(), input->e<T>(e));
-            auto dist = std::distance(valuesVector.begin(), posI);
-            indices->p(e, Nd4jLong(dist));//indicesMap[(*input)(e)];
+        SpecialMethods<Nd4jLong>::sortBufferByKey(firstPos.get(), groupOrder.get(), numGroups, false);
+
+        for (Nd4jLong u = 0; u < numGroups; u++) {
+            const auto g = groupOrder[u];
+            values->p(u, input->e<T>(firstPos[u]));
+            if (counts != nullptr)
+                counts->p(u, groupStart[g + 1] - groupStart[g]);
+
+            for (Nd4jLong e = groupStart[g]; e < groupStart[g + 1]; e++)
+                indices->p(positions[e], u);
         }
 
         return Status::OK();
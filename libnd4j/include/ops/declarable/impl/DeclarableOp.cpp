@@ -230,7 +230,16 @@ namespace nd4j {
                             if (Environment::getInstance()->isDebugAndVerbose())
                                 shape::printShapeInfoLinear("Going to create variable with shape", out);
 
-                            auto outArr = new NDArray(out, true, workspace);
+                            NDArray *outArr = nullptr;
+
+                            // if there's static memory plan for this variable - we don't allocate anything
+                            auto numBytes = shape::isEmpty(out) ? 0L : shape::length(out) * DataTypeUtils::sizeOfElement(ArrayOptions::dataType(out));
+                            auto buffer = ctx.getVariableSpace() != nullptr ? ctx.getVariableSpace()->plannedBuffer(pair, numBytes) : nullptr;
+                            if (buffer != nullptr) {
+                                memset(buffer, 0, numBytes);
+                                outArr = new NDArray(buffer, ShapeBuilders::copyShapeInfo(out, true, workspace), workspace, false, true);
+                            } else
+                                outArr = new NDArray(out, true, workspace);
 
                             ctx.pushNDArrayToVariableSpace(pair, outArr);
                         } else {
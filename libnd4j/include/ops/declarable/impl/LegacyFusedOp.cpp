@@ -0,0 +1,352 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <ops/declarable/LegacyFusedOp.h>
+#include <NativeOpExcutioner.h>
+#include <NDArrayFactory.h>
+#include <helpers/ConstantTadHelper.h>
+#include <loops/legacy_ops.h>
+#include <ops/ops.h>
+#include <ops/special_ops.h>
+#include <Status.h>
+
+using namespace simdOps;
+
+// number of elements pushed through all steps of the chain before moving on, so intermediates stay in L1
+#define FUSED_TILE_LENGTH 2048
+
+namespace nd4j {
+    namespace ops {
+
+        /**
+        *   Broadcast ops have no extra params, so this wrapper gives them pairwise signature
+        */
+        template <typename OpType, typename X>
+        class BroadcastAsPairwise {
+        public:
+            op_def static X op(X d1, X d2, X *params) {
+                return OpType::op(d1, d2);
+            }
+        };
+
+        template <typename X>
+        class FusedLoops {
+        public:
+            template <typename OpType>
+            static void specialCheck(bool &special) {
+                special = OpType::requiresSpecial;
+            }
+
+            template <typename OpType>
+            static void transformTile(const X *in, X *out, Nd4jLong len, X *extras) {
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < len; e++)
+                    out[e] = OpType::op(in[e], extras);
+            }
+
+            /**
+             * Y operand is either single value (yLen == 1), array of the same length as X, or row repeated along X,
+             * so tile is processed as few contiguous segments of Y
+             */
+            template <typename OpType>
+            static void pairwiseTile(const X *in, const X *y, Nd4jLong yLen, Nd4jLong start, X *out, Nd4jLong len, X *extras) {
+                if (yLen == 1) {
+                    const X scalar = y[0];
+
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong e = 0; e < len; e++)
+                        out[e] = OpType::op(in[e], scalar, extras);
+
+                    return;
+                }
+
+                Nd4jLong r = start % yLen;
+                for (Nd4jLong i = 0; i < len; ) {
+                    const Nd4jLong segment = nd4j::math::nd4j_min<Nd4jLong>(len - i, yLen - r);
+                    auto pIn = in + i;
+                    auto pOut = out + i;
+                    auto pY = y + r;
+
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong e = 0; e < segment; e++)
+                        pOut[e] = OpType::op(pIn[e], pY[e], extras);
+
+                    i += segment;
+                    r = 0;
+                }
+            }
+
+            template <typename OpType>
+            static void broadcastTile(const X *in, const X *y, Nd4jLong yLen, Nd4jLong start, X *out, Nd4jLong len, X *extras) {
+                pairwiseTile<BroadcastAsPairwise<OpType, X>>(in, y, yLen, start, out, len, extras);
+            }
+
+            static bool requiresSpecial(const FusedStep &step) {
+                // legacy op lists are declared with X/Y type names
+                typedef X Y;
+
+                const int opNum = step._opNum;
+                bool special = false;
+
+                switch (step._opType) {
+                    case nd4j::graph::OpType_TRANSFORM_SAME: {
+                            DISPATCH_BY_OPNUM_T(specialCheck, PARAMS(special), TRANSFORM_SAME_OPS);
+                        }
+                        break;
+                    case nd4j::graph::OpType_TRANSFORM_STRICT: {
+                            DISPATCH_BY_OPNUM_T(specialCheck, PARAMS(special), TRANSFORM_STRICT_OPS);
+                        }
+                        break;
+                    case nd4j::graph::OpType_TRANSFORM_FLOAT: {
+                            DISPATCH_BY_OPNUM_TT(specialCheck, PARAMS(special), TRANSFORM_FLOAT_OPS);
+                        }
+                        break;
+                    default:
+                        break;
+                }
+
+                return special;
+            }
+
+            static void execStep(const FusedStep &step, const X *in, const X *y, Nd4jLong yLen, Nd4jLong start, X *out, Nd4jLong len, X *extras) {
+                typedef X Y;
+                typedef X Z;
+
+                const int opNum = step._opNum;
+
+                switch (step._opType) {
+                    case nd4j::graph::OpType_TRANSFORM_SAME: {
+                            DISPATCH_BY_OPNUM_T(transformTile, PARAMS(in, out, len, extras), TRANSFORM_SAME_OPS);
+                        }
+                        break;
+                    case nd4j::graph::OpType_TRANSFORM_STRICT: {
+                            DISPATCH_BY_OPNUM_T(transformTile, PARAMS(in, out, len, extras), TRANSFORM_STRICT_OPS);
+                        }
+                        break;
+                    case nd4j::graph::OpType_TRANSFORM_FLOAT: {
+                            DISPATCH_BY_OPNUM_TT(transformTile, PARAMS(in, out, len, extras), TRANSFORM_FLOAT_OPS);
+                        }
+                        break;
+                    case nd4j::graph::OpType_SCALAR: {
+                            DISPATCH_BY_OPNUM_TTT(pairwiseTile, PARAMS(in, y, yLen, start, out, len, extras), SCALAR_OPS);
+                        }
+                        break;
+                    case nd4j::graph::OpType_PAIRWISE: {
+                            DISPATCH_BY_OPNUM_TTT(pairwiseTile, PARAMS(in, y, yLen, start, out, len, extras), PAIRWISE_TRANSFORM_OPS);
+                        }
+                        break;
+                    case nd4j::graph::OpType_BROADCAST: {
+                            DISPATCH_BY_OPNUM_TTT(broadcastTile, PARAMS(in, y, yLen, start, out, len, extras), BROADCAST_OPS);
+                        }
+                        break;
+                    default:
+                        throw std::runtime_error("LegacyFusedOp: unsupported op type");
+                }
+            }
+
+            static void exec(const std::vector<FusedStep> &steps, void *vx, void *vz, Nd4jLong length, std::vector<void*> &vys, std::vector<Nd4jLong> &yLengths, bool &executed) {
+                for (auto &step: steps)
+                    if (requiresSpecial(step)) {
+                        executed = false;
+                        return;
+                    }
+
+                auto x = reinterpret_cast<X *>(vx);
+                auto z = reinterpret_cast<X *>(vz);
+
+                const int numSteps = (int) steps.size();
+                std::vector<const X*> ys(numSteps, nullptr);
+                std::vector<X> scalars(numSteps, static_cast<X>(0.f));
+                std::vector<std::vector<X>> extras(numSteps);
+
+                for (int s = 0; s < numSteps; s++) {
+                    for (auto v: steps[s]._extras)
+                        extras[s].emplace_back(static_cast<X>(v));
+
+                    if (vys[s] != nullptr) {
+                        ys[s] = reinterpret_cast<X *>(vys[s]);
+                    } else {
+                        scalars[s] = static_cast<X>(steps[s]._scalar);
+                        ys[s] = &scalars[s];
+                    }
+                }
+
+                const Nd4jLong numTiles = (length + FUSED_TILE_LENGTH - 1) / FUSED_TILE_LENGTH;
+
+                PRAGMA_OMP_PARALLEL_FOR_IF(numTiles > 1 && length > Environment::getInstance()->elementwiseThreshold())
+                for (Nd4jLong t = 0; t < numTiles; t++) {
+                    const Nd4jLong start = t * FUSED_TILE_LENGTH;
+                    const Nd4jLong len = nd4j::math::nd4j_min<Nd4jLong>(FUSED_TILE_LENGTH, length - start);
+
+                    // first step reads X, all other steps are applied in place to the tile of Z
+                    const X *in = x + start;
+                    for (int s = 0; s < numSteps; s++) {
+                        execStep(steps[s], in, ys[s], yLengths[s], start, z + start, len, extras[s].empty() ? nullptr : extras[s].data());
+                        in = z + start;
+                    }
+                }
+
+                executed = true;
+            }
+        };
+
+        FusedStep::FusedStep(nd4j::graph::OpType opType, int opNum) {
+            _opType = opType;
+            _opNum = opNum;
+        }
+
+        bool FusedStep::isFusable(nd4j::graph::OpType opType) {
+            switch (opType) {
+                case nd4j::graph::OpType_TRANSFORM_SAME:
+                case nd4j::graph::OpType_TRANSFORM_STRICT:
+                case nd4j::graph::OpType_TRANSFORM_FLOAT:
+                case nd4j::graph::OpType_SCALAR:
+                case nd4j::graph::OpType_PAIRWISE:
+                case nd4j::graph::OpType_BROADCAST:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        LegacyFusedOp::LegacyFusedOp(const std::vector<FusedStep> &steps, int numInputs) : LegacyOp::LegacyOp(numInputs) {
+            _steps = steps;
+        }
+
+        LegacyOp* LegacyFusedOp::clone() {
+            return new LegacyFusedOp(_steps, _numInputs);
+        }
+
+        std::vector<FusedStep>* LegacyFusedOp::steps() {
+            return &_steps;
+        }
+
+        /**
+        *   This method applies steps one by one, using Z as intermediate array. Used whenever operands layout doesn't allow single pass.
+        */
+        void LegacyFusedOp::execSequential(NDArray *x, std::vector<NDArray*> &operands, NDArray *z, nd4j::memory::Workspace *workspace) {
+            for (int s = 0; s < (int) _steps.size(); s++) {
+                auto &step = _steps[s];
+                auto in = s == 0 ? x : z;
+                auto extras = step._extras.empty() ? nullptr : step._extras.data();
+                auto y = step._operand >= 0 ? operands[step._operand] : nullptr;
+
+                switch (step._opType) {
+                    case nd4j::graph::OpType_TRANSFORM_SAME:
+                        NativeOpExcutioner::execTransformSame(step._opNum, in->getBuffer(), in->getShapeInfo(), z->getBuffer(), z->getShapeInfo(), extras, nullptr, nullptr);
+                        break;
+                    case nd4j::graph::OpType_TRANSFORM_STRICT:
+                        NativeOpExcutioner::execTransformStrict(step._opNum, in->getBuffer(), in->getShapeInfo(), z->getBuffer(), z->getShapeInfo(), extras, nullptr, nullptr);
+                        break;
+                    case nd4j::graph::OpType_TRANSFORM_FLOAT:
+                        NativeOpExcutioner::execTransformFloat(step._opNum, in->getBuffer(), in->getShapeInfo(), z->getBuffer(), z->getShapeInfo(), extras, nullptr, nullptr);
+                        break;
+                    case nd4j::graph::OpType_SCALAR: {
+                            if (y != nullptr) {
+                                NativeOpExcutioner::execScalar(step._opNum, in->getBuffer(), in->getShapeInfo(), z->getBuffer(), z->getShapeInfo(), y->buffer(), y->shapeInfo(), extras);
+                            } else {
+                                auto scalar = NDArrayFactory::create(in->dataType(), step._scalar, workspace);
+                                NativeOpExcutioner::execScalar(step._opNum, in->getBuffer(), in->getShapeInfo(), z->getBuffer(), z->getShapeInfo(), scalar.buffer(), scalar.shapeInfo(), extras);
+                            }
+                        }
+                        break;
+                    case nd4j::graph::OpType_PAIRWISE: {
+                            REQUIRE_TRUE(in->isSameShape(y) || y->isScalar(), 0, "LegacyFusedOp: for Pairwise transforms shapes of both operands should be equal");
+                            NativeOpExcutioner::execPairwiseTransform(step._opNum, in->getBuffer(), in->getShapeInfo(), y->getBuffer(), y->getShapeInfo(), z->getBuffer(), z->getShapeInfo(), extras);
+                        }
+                        break;
+                    case nd4j::graph::OpType_BROADCAST: {
+                            std::vector<int> dims(step._dimensions);
+                            for (auto &d: dims)
+                                if (d < 0)
+                                    d += in->rankOf();
+                            std::sort(dims.begin(), dims.end());
+
+                            auto tadPack = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(in->shapeInfo(), dims);
+                            auto tadPackZ = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(z->shapeInfo(), dims);
+                            REQUIRE_TRUE(shape::length(tadPack.primaryShapeInfo()) == y->lengthOf(), 0, "LegacyFusedOp: length of broadcast TAD should be equal to length of Y operand");
+
+                            NativeOpExcutioner::execBroadcast(step._opNum, in->buffer(), in->shapeInfo(), y->buffer(), y->shapeInfo(), z->buffer(), z->shapeInfo(), dims.data(), dims.size(), tadPack.primaryShapeInfo(), tadPack.primaryOffsets(), tadPackZ.primaryShapeInfo(), tadPackZ.primaryOffsets());
+                        }
+                        break;
+                    default:
+                        throw std::runtime_error("LegacyFusedOp: unsupported op type");
+                }
+            }
+        }
+
+        Nd4jStatus LegacyFusedOp::validateAndExecute(Context &block) {
+            auto x = INPUT_VARIABLE(0);
+            auto z = OUTPUT_VARIABLE(0);
+
+            std::vector<NDArray*> operands(block.width(), nullptr);
+            for (size_t e = 1; e < block.width(); e++)
+                operands[e] = INPUT_VARIABLE(e);
+
+            // single pass is possible if X and Z are dense and every Y operand is either scalar, array of the same shape or row along last dimension
+            bool fusable = DataTypeUtils::isR(x->dataType()) && x->dataType() == z->dataType() && x->isSameShape(z) && x->ordering() == z->ordering() && x->ews() == 1 && z->ews() == 1;
+
+            const int numSteps = (int) _steps.size();
+            std::vector<void*> ys(numSteps, nullptr);
+            std::vector<Nd4jLong> yLengths(numSteps, 1);
+
+            for (int s = 0; s < numSteps && fusable; s++) {
+                auto &step = _steps[s];
+                if (step._operand < 0)
+                    continue;
+
+                auto y = operands[step._operand];
+                if (y->dataType() != x->dataType() || y->getBuffer() == z->getBuffer()) {
+                    fusable = false;
+                    break;
+                }
+
+                ys[s] = y->getBuffer();
+                yLengths[s] = y->lengthOf();
+
+                if (step._opType == nd4j::graph::OpType_BROADCAST) {
+                    // the only broadcast handled here is the row along last dimension of c-ordered X
+                    fusable = step._dimensions.size() == 1 && (step._dimensions[0] == x->rankOf() - 1 || step._dimensions[0] == -1) && x->ordering() == 'c' && y->ews() == 1 && y->lengthOf() == x->sizeAt(-1);
+                } else if (y->lengthOf() != 1) {
+                    fusable = step._opType == nd4j::graph::OpType_PAIRWISE && y->isSameShape(x) && y->ordering() == x->ordering() && y->ews() == 1;
+                }
+            }
+
+            bool executed = false;
+            if (fusable)
+                BUILD_SINGLE_SELECTOR(x->dataType(), FusedLoops, ::exec(_steps, x->getBuffer(), z->getBuffer(), x->lengthOf(), ys, yLengths, executed), FLOAT_TYPES);
+
+            if (!executed)
+                execSequential(x, operands, z, block.getWorkspace());
+
+            STORE_RESULT(*z);
+
+            return Status::OK();
+        }
+
+        /**
+        *   All ops in chain preserve shape of X
+        */
+        ShapeList *LegacyFusedOp::calculateOutputShape(ShapeList *inputShape, nd4j::graph::Context &block) {
+            auto inShape = inputShape->at(0);
+
+            Nd4jLong *newShape;
+            COPY_SHAPE(inShape, newShape);
+
+            return SHAPELIST(newShape);
+        }
+    }
+}
@@ -28,6 +28,18 @@
 #include <NDArray.h>
 #include <ops/declarable/CustomOperations.h>
 #include <types/types.h>
+#include <helpers/ThreadPool.h>
+#include <Environment.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+// arrays up to this length are sorted with sorting network
+#define SORT_NETWORK_LENGTH 16
+
+// minimal number of elements sorted by one thread before merge passes
+#define SORT_PARALLEL_GRAIN 32768
 
 namespace nd4j {
 
@@ -177,76 +189,6 @@ void SpecialMethods<T>::concatCpuGeneric(int dimension, int numArrays, Nd4jPoint
             return shape::getIndexOffset(index, xShapeInfo, shape::length(xShapeInfo));
     }
 
-    template<typename T>
-    void SpecialMethods<T>::quickSort_parallel_internal(T* array, Nd4jLong *xShapeInfo, int left, int right, int cutoff, bool descending) {
-
-        int i = left, j = right;
-        T tmp;
-        T pivot = array[getPosition(xShapeInfo, (left + right) / 2)];
-
-
-        {
-            /* PARTITION PART */
-            while (i <= j) {
-                if (descending) {
-                    while (array[getPosition(xShapeInfo, i)] > pivot)
-                        i++;
-                    while (array[getPosition(xShapeInfo, j)] < pivot)
-                        j--;
-                    if (i <= j) {
-                        tmp = array[getPosition(xShapeInfo, i)];
-                        array[getPosition(xShapeInfo, i)] = array[getPosition(xShapeInfo, j)];
-                        array[getPosition(xShapeInfo, j)] = tmp;
-                        i++;
-                        j--;
-                    }
-                } else {
-                    while (array[getPosition(xShapeInfo, i)] < pivot)
-                        i++;
-                    while (array[getPosition(xShapeInfo, j)] > pivot)
-                        j--;
-                    if (i <= j) {
-                        tmp = array[getPosition(xShapeInfo, i)];
-                        array[getPosition(xShapeInfo, i)] = array[getPosition(xShapeInfo, j)];
-                        array[getPosition(xShapeInfo, j)] = tmp;
-                        i++;
-                        j--;
-                    }
-                }
-            }
-
-        }
-
-        //
-
-        if ( ((right-left)<cutoff) ){
-            if (left < j){ quickSort_parallel_internal(array, xShapeInfo, left, j, cutoff, descending); }
-            if (i < right){ quickSort_parallel_internal(array, xShapeInfo, i, right, cutoff, descending); }
-
-        }else{
-#pragma omp task
-            { quickSort_parallel_internal(array, xShapeInfo, left, j, cutoff, descending); }
-#pragma omp task
-            { quickSort_parallel_internal(array, xShapeInfo, i, right, cutoff, descending); }
-        }
-
-    }
-
-    template<typename T>
-    void SpecialMethods<T>::quickSort_parallel(void *varray, Nd4jLong *xShapeInfo, Nd4jLong lenArray, int numThreads, bool descending){
-        auto array = reinterpret_cast<T *>(varray);
-        int cutoff = 1000;
-
-        PRAGMA_OMP_PARALLEL_THREADS(numThreads)
-        {
-#pragma omp single nowait
-            {
-                quickSort_parallel_internal(array, xShapeInfo, 0, lenArray-1, cutoff, descending);
-            }
-        }
-
-    }
-
     template <typename T>
     int SpecialMethods<T>::nextPowerOf2(int number) {
         int pos = 0;
@@ -269,30 +211,438 @@ void SpecialMethods<T>::concatCpuGeneric(int dimension, int numArrays, Nd4jPoint
     }
 
 
+    template <int SIZE>
+    struct SortUnsigned;
+    template <> struct SortUnsigned<1> { typedef uint8_t type; };
+    template <> struct SortUnsigned<2> { typedef uint16_t type; };
+    template <> struct SortUnsigned<4> { typedef uint32_t type; };
+    template <> struct SortUnsigned<8> { typedef uint64_t type; };
+
+    // raw bits of sort values, half types expose them via own bit fields
+    template <typename T, typename U>
+    struct SortBits {
+        static FORCEINLINE U get(const T &value) {
+            U bits;
+            memcpy(&bits, &value, sizeof(T));
+            return bits;
+        }
+
+        static FORCEINLINE T set(U bits) {
+            T value;
+            memcpy(&value, &bits, sizeof(T));
+            return value;
+        }
+    };
+
+    template <typename U>
+    struct SortBits<float16, U> {
+        static FORCEINLINE U get(const float16 &value) {
+            return static_cast<U>(value.data.getX());
+        }
+
+        static FORCEINLINE float16 set(U bits) {
+            float16 value;
+            *value.data.getXP() = static_cast<unsigned short>(bits);
+            return value;
+        }
+    };
+
+    template <typename U>
+    struct SortBits<bfloat16, U> {
+        static FORCEINLINE U get(const bfloat16 &value) {
+            return static_cast<U>(value._data);
+        }
+
+        static FORCEINLINE bfloat16 set(U bits) {
+            bfloat16 value;
+            value._data = static_cast<int16_t>(bits);
+            return value;
+        }
+    };
+
+    /**
+     * order preserving mapping of values to unsigned keys: sign bit of floats is flipped (all bits for negative ones),
+     * sign bit of signed integers is flipped, descending order complements keys
+     */
+    template <typename T>
+    struct SortKey {
+        typedef typename SortUnsigned<sizeof(T)>::type U;
+
+        static const bool isFloat = std::is_floating_point<T>::value || std::is_same<T, float16>::value || std::is_same<T, bfloat16>::value;
+        static const bool isSigned = isFloat || std::is_signed<T>::value;
+
+        static FORCEINLINE U encode(T value, bool descending) {
+            const U signBit = static_cast<U>(static_cast<U>(1) << (sizeof(U) * 8 - 1));
+            U key = SortBits<T, U>::get(value);
+
+            if (isFloat)
+                key = (key & signBit) ? static_cast<U>(~key) : static_cast<U>(key | signBit);
+            else if (isSigned)
+                key = static_cast<U>(key ^ signBit);
+
+            return descending ? static_cast<U>(~key) : key;
+        }
+
+        static FORCEINLINE T decode(U key, bool descending) {
+            const U signBit = static_cast<U>(static_cast<U>(1) << (sizeof(U) * 8 - 1));
+            if (descending)
+                key = static_cast<U>(~key);
+
+            if (isFloat)
+                key = (key & signBit) ? static_cast<U>(key ^ signBit) : static_cast<U>(~key);
+            else if (isSigned)
+                key = static_cast<U>(key ^ signBit);
+
+            return SortBits<T, U>::set(key);
+        }
+    };
+
+    // Batcher's odd-even merge sort network, comparators beyond length are skipped
+    template <typename U>
+    static void networkSort(U* keys, Nd4jLong length) {
+        for (Nd4jLong p = 1; p < length; p += p)
+            for (Nd4jLong k = p; k >= 1; k /= 2)
+                for (Nd4jLong j = k % p; j + k < length; j += 2 * k)
+                    for (Nd4jLong i = 0; i < k && i + j + k < length; i++)
+                        if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+                            const U a = keys[i + j];
+                            const U b = keys[i + j + k];
+                            keys[i + j]     = b < a ? b : a;
+                            keys[i + j + k] = b < a ? a : b;
+                        }
+    }
+
+    // stable insertion sort, tiny key-value arrays only
+    template <typename U>
+    static void insertionSort(U* keys, Nd4jLong* values, Nd4jLong length) {
+        for (Nd4jLong i = 1; i < length; i++) {
+            const U key = keys[i];
+            const Nd4jLong value = values[i];
+
+            auto j = i;
+            for (; j > 0 && key < keys[j - 1]; j--) {
+                keys[j] = keys[j - 1];
+                values[j] = values[j - 1];
+            }
+
+            keys[j] = key;
+            values[j] = value;
+        }
+    }
+
+    // stable LSD radix sort over 8-bit digits, passes where all keys share the digit are skipped. values are optional
+    template <typename U>
+    static void radixSort(U* keys, Nd4jLong* values, Nd4jLong length, U* keysTmp, Nd4jLong* valuesTmp) {
+        Nd4jLong histogram[sizeof(U)][256];
+        memset(histogram, 0, sizeof(histogram));
+
+        for (Nd4jLong e = 0; e < length; e++)
+            for (int d = 0; d < (int) sizeof(U); d++)
+                histogram[d][(keys[e] >> (d * 8)) & 0xFF]++;
+
+        U* srcK = keys;
+        U* dstK = keysTmp;
+        Nd4jLong* srcV = values;
+        Nd4jLong* dstV = valuesTmp;
+
+        for (int d = 0; d < (int) sizeof(U); d++) {
+            auto counts = histogram[d];
+            if (counts[(keys[0] >> (d * 8)) & 0xFF] == length)
+                continue;
+
+            Nd4jLong offsets[256];
+            Nd4jLong sum = 0;
+            for (int b = 0; b < 256; b++) {
+                offsets[b] = sum;
+                sum += counts[b];
+            }
+
+            for (Nd4jLong e = 0; e < length; e++) {
+                const auto pos = offsets[(srcK[e] >> (d * 8)) & 0xFF]++;
+                dstK[pos] = srcK[e];
+                if (srcV != nullptr)
+                    dstV[pos] = srcV[e];
+            }
+
+            std::swap(srcK, dstK);
+            std::swap(srcV, dstV);
+        }
+
+        if (srcK != keys) {
+            memcpy(keys, srcK, length * sizeof(U));
+            if (values != nullptr)
+                memcpy(values, srcV, length * sizeof(Nd4jLong));
+        }
+    }
+
+    // number of elements of a taken into first k elements of stable merge of a and b
+    template <typename U>
+    static Nd4jLong mergeCoRank(Nd4jLong k, const U* a, Nd4jLong aLen, const U* b, Nd4jLong bLen) {
+        Nd4jLong lo = k > bLen ? k - bLen : 0;
+        Nd4jLong hi = k < aLen ? k : aLen;
+
+        while (lo < hi) {
+            const auto i = (lo + hi) / 2;
+            const auto j = k - i;
+
+            // a[i] precedes b[j - 1], so more elements of a go first
+            if (j > 0 && !(b[j - 1] < a[i]))
+                lo = i + 1;
+            else
+                hi = i;
+        }
+
+        return lo;
+    }
+
+    // merges output range [kStart, kStop) of stable merge of a and b
+    template <typename U>
+    static void mergeRange(const U* aK, const Nd4jLong* aV, Nd4jLong aLen, const U* bK, const Nd4jLong* bV, Nd4jLong bLen, U* zK, Nd4jLong* zV, Nd4jLong kStart, Nd4jLong kStop) {
+        auto i = mergeCoRank(kStart, aK, aLen, bK, bLen);
+        auto j = kStart - i;
+
+        for (auto k = kStart; k < kStop; k++) {
+            const bool fromA = j >= bLen || (i < aLen && !(bK[j] < aK[i]));
+            if (fromA) {
+                zK[k] = aK[i];
+                if (zV != nullptr)
+                    zV[k] = aV[i];
+                i++;
+            }
+            else {
+                zK[k] = bK[j];
+                if (zV != nullptr)
+                    zV[k] = bV[j];
+                j++;
+            }
+        }
+    }
+
+    /**
+     * sorts keys, permuting values along with them if they're not nullptr. Tiny arrays go through sorting network,
+     * larger ones through radix sort, and large ones are split into chunks radix-sorted in parallel, then merged pairwise in parallel
+     */
+    template <typename U>
+    static void sortKeys(U* keys, Nd4jLong* values, Nd4jLong length) {
+        if (length < 2)
+            return;
+
+        if (length <= SORT_NETWORK_LENGTH) {
+            if (values == nullptr)
+                networkSort(keys, length);
+            else
+                insertionSort(keys, values, length);
+
+            return;
+        }
+
+        std::unique_ptr<U[]> keysTmp(new U[length]);
+        std::unique_ptr<Nd4jLong[]> valuesTmp(values != nullptr ? new Nd4jLong[length] : nullptr);
+
+        const int numChunks = ThreadPool::getInstance()->effectiveThreads(length, SORT_PARALLEL_GRAIN);
+        if (numChunks <= 1) {
+            radixSort(keys, values, length, keysTmp.get(), valuesTmp.get());
+            return;
+        }
+
+        const Nd4jLong chunk = (length + numChunks - 1) / numChunks;
+
+        ThreadPool::getInstance()->parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+            for (auto c = start; c < stop; c++) {
+                const auto first = c * chunk;
+                const auto len = first + chunk < length ? chunk : length - first;
+                if (len > 0)
+                    radixSort(keys + first, values != nullptr ? values + first : nullptr, len, keysTmp.get() + first, values != nullptr ? valuesTmp.get() + first : nullptr);
+            }
+        }, 0, numChunks);
+
+        U* srcK = keys;
+        U* dstK = keysTmp.get();
+        Nd4jLong* srcV = values;
+        Nd4jLong* dstV = valuesTmp.get();
+
+        // every pass merges pairs of runs, each pair split between threads at co-ranks of its output
+        for (Nd4jLong width = chunk; width < length; width *= 2) {
+            const Nd4jLong numPairs = (length + 2 * width - 1) / (2 * width);
+            const Nd4jLong parts = numPairs < numChunks ? (numChunks + numPairs - 1) / numPairs : 1;
+
+            ThreadPool::getInstance()->parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+                for (auto t = start; t < stop; t++) {
+                    const auto first = (t / parts) * 2 * width;
+                    const auto aLen = first + width < length ? width : length - first;
+                    const auto bLen = first + 2 * width < length ? width : length - first - aLen;
+                    const auto part = t % parts;
+                    const auto partLen = (aLen + bLen + parts - 1) / parts;
+                    const auto kStart = part * partLen < aLen + bLen ? part * partLen : aLen + bLen;
+                    const auto kStop = kStart + partLen < aLen + bLen ? kStart + partLen : aLen + bLen;
+
+                    mergeRange(srcK + first, srcV != nullptr ? srcV + first : nullptr, aLen,
+                               srcK + first + aLen, srcV != nullptr ? srcV + first + aLen : nullptr, bLen,
+                               dstK + first, dstV != nullptr ? dstV + first : nullptr, kStart, kStop);
+                }
+            }, 0, numPairs * parts);
+
+            std::swap(srcK, dstK);
+            std::swap(srcV, dstV);
+        }
+
+        if (srcK != keys) {
+            memcpy(keys, srcK, length * sizeof(U));
+            if (values != nullptr)
+                memcpy(values, srcV, length * sizeof(Nd4jLong));
+        }
+    }
+
+    template<typename T>
+    void SpecialMethods<T>::sortBuffer(T* buffer, Nd4jLong length, bool descending) {
+        typedef typename SortKey<T>::U U;
+
+        // tiny TADs don't need heap allocations
+        U stackKeys[SORT_NETWORK_LENGTH];
+        std::unique_ptr<U[]> heapKeys(length > SORT_NETWORK_LENGTH ? new U[length] : nullptr);
+        U* keys = length > SORT_NETWORK_LENGTH ? heapKeys.get() : stackKeys;
+
+        for (Nd4jLong e = 0; e < length; e++)
+            keys[e] = SortKey<T>::encode(buffer[e], descending);
+
+        sortKeys<U>(keys, nullptr, length);
+
+        for (Nd4jLong e = 0; e < length; e++)
+            buffer[e] = SortKey<T>::decode(keys[e], descending);
+    }
+
+    template<typename T>
+    void SpecialMethods<T>::sortBufferByKey(T* keys, Nd4jLong* indices, Nd4jLong length, bool descending) {
+        typedef typename SortKey<T>::U U;
+
+        std::unique_ptr<U[]> encoded(new U[length > 0 ? length : 1]);
+        for (Nd4jLong e = 0; e < length; e++)
+            encoded[e] = SortKey<T>::encode(keys[e], descending);
+
+        sortKeys<U>(encoded.get(), indices, length);
+
+        for (Nd4jLong e = 0; e < length; e++)
+            keys[e] = SortKey<T>::decode(encoded[e], descending);
+    }
+
     template<typename T>
     void SpecialMethods<T>::sortGeneric(void *vx, Nd4jLong *xShapeInfo, bool descending) {
         auto x = reinterpret_cast<T *>(vx);
+        const Nd4jLong length = shape::length(xShapeInfo);
+
+        if (shape::elementWiseStride(xShapeInfo) == 1) {
+            sortBuffer(x, length, descending);
+            return;
+        }
+
+        std::unique_ptr<T[]> buffer(new T[length]);
+        for (Nd4jLong e = 0; e < length; e++)
+            buffer[e] = x[getPosition(xShapeInfo, e)];
 
-        quickSort_parallel(x, xShapeInfo, shape::length(xShapeInfo), omp_get_max_threads(), descending);
+        sortBuffer(buffer.get(), length, descending);
+
+        for (Nd4jLong e = 0; e < length; e++)
+            x[getPosition(xShapeInfo, e)] = buffer[e];
     }
 
     template<typename T>
     void SpecialMethods<T>::sortTadGeneric(void *vx, Nd4jLong *xShapeInfo, int *dimension, int dimensionLength, Nd4jLong *tadShapeInfo, Nd4jLong *tadOffsets, bool descending) {
         auto x = reinterpret_cast<T *>(vx);
 
-        //quickSort_parallel(x, xShapeInfo, shape::length(xShapeInfo), omp_get_max_threads(), descending);
         Nd4jLong xLength = shape::length(xShapeInfo);
         Nd4jLong xTadLength = shape::tadLength(xShapeInfo, dimension, dimensionLength);
-        int numTads = xLength / xTadLength;
+        Nd4jLong numTads = xLength / xTadLength;
 
-        PRAGMA_OMP_PARALLEL_FOR
-        for (int r = 0; r < numTads; r++) {
-            T *dx = x + tadOffsets[r];
+        const bool contiguous = shape::elementWiseStride(tadShapeInfo) == 1;
+        const Nd4jLong grain = nd4j::math::nd4j_max<Nd4jLong>(1, Environment::getInstance()->elementwiseThreshold() / xTadLength);
+
+        // long TADs still get their share of threads for chunked sorting
+        ThreadPool::getInstance()->parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+            std::unique_ptr<T[]> buffer(contiguous ? nullptr : new T[xTadLength]);
+
+            for (auto r = start; r < stop; r++) {
+                T *dx = x + tadOffsets[r];
+
+                if (contiguous) {
+                    sortBuffer(dx, xTadLength, descending);
+                    continue;
+                }
+
+                for (Nd4jLong e = 0; e < xTadLength; e++)
+                    buffer[e] = dx[getPosition(tadShapeInfo, e)];
+
+                sortBuffer(buffer.get(), xTadLength, descending);
+
+                for (Nd4jLong e = 0; e < xTadLength; e++)
+                    dx[getPosition(tadShapeInfo, e)] = buffer[e];
+            }
+        }, 0, numTads, grain);
+    }
 
-            quickSort_parallel(dx, tadShapeInfo, xTadLength, 1, descending);
+
+    // Floyd-Rivest selection: k-th smallest element of [left, right] goes to position k, smaller ones to the left of it
+    template <typename T>
+    static void floydRivestSelect(T* array, Nd4jLong left, Nd4jLong right, Nd4jLong k, int depth) {
+        while (right > left) {
+            // pathological inputs degrade to introselect of standard library
+            if (depth-- <= 0) {
+                std::nth_element(array + left, array + k, array + right + 1);
+                return;
+            }
+
+            // narrowing range to the sample which contains k-th element with high probability
+            if (right - left > 600) {
+                const double n = static_cast<double>(right - left + 1);
+                const double i = static_cast<double>(k - left + 1);
+                const double z = std::log(n);
+                const double s = 0.5 * std::exp(2. * z / 3.);
+                const double sd = 0.5 * std::sqrt(z * s * (n - s) / n) * (i < n / 2 ? -1. : 1.);
+                const auto newLeft  = std::max<Nd4jLong>(left,  static_cast<Nd4jLong>(std::floor(k - i * s / n + sd)));
+                const auto newRight = std::min<Nd4jLong>(right, static_cast<Nd4jLong>(std::floor(k + (n - i) * s / n + sd)));
+                floydRivestSelect(array, newLeft, newRight, k, depth);
+            }
+
+            const T t = array[k];
+            auto i = left;
+            auto j = right;
+
+            std::swap(array[left], array[k]);
+            if (t < array[right])
+                std::swap(array[right], array[left]);
+
+            while (i < j) {
+                std::swap(array[i], array[j]);
+                i++;
+                j--;
+                while (array[i] < t)
+                    i++;
+                while (t < array[j])
+                    j--;
+            }
+
+            if (!(array[left] < t) && !(t < array[left]))
+                std::swap(array[left], array[j]);
+            else {
+                j++;
+                std::swap(array[j], array[right]);
+            }
+
+            if (j <= k)
+                left = j + 1;
+            if (k <= j)
+                right = j - 1;
         }
     }
 
+    template<typename T>
+    T SpecialMethods<T>::nthElementGeneric(T* buffer, Nd4jLong length, Nd4jLong n, bool descending) {
+        const auto k = descending ? length - 1 - n : n;
+
+        floydRivestSelect(buffer, 0, length - 1, k, 2 * static_cast<int>(std::log2(static_cast<double>(length))) + 16);
+
+        return buffer[k];
+    }
+
 
     template<typename T>
     void SpecialMethods<T>::decodeBitmapGeneric(void *dx, Nd4jLong N, void *vz, Nd4jLong *zShapeInfo) {
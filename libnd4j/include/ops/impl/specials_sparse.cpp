@@ -28,6 +28,9 @@
 #endif
 #include <types/float16.h>
 #include <types/types.h>
+#include <specials.h>
+#include <cstring>
+#include <memory>
 
 namespace nd4j {
     namespace sparse {
@@ -93,128 +96,33 @@ namespace nd4j {
         }
 
         template <typename T>
-        Nd4jLong SparseUtils<T>::coo_quickSort_findPivot(Nd4jLong *indices, T *array, Nd4jLong left, Nd4jLong right,
-                                                         int rank) {
-            Nd4jLong  mid = (left + right) / 2;
-
-            // ensure left < mid
-            if (ltIndices(indices, rank, mid, left)) {  // ensure lo < mid
-               swapEverything(indices, array, rank, mid, left);
-            }
-
-            // ensure left < right
-            if (ltIndices(indices, rank, right, left)) {
-                swapEverything(indices, array, rank, right, left);
-            }
-
-            // ensure mid < right
-            if (ltIndices(indices, rank, right, mid)) {
-                swapEverything(indices, array, rank, right, mid);
-            }
-
-            // mid is the median of the 3, and is the optimal pivot point
-            return mid;
-    }
-
-        template<typename T>
-        void SparseUtils<T>::coo_quickSort_parallel_internal(Nd4jLong *indices, T* array, Nd4jLong left, Nd4jLong right, int cutoff, int rank) {
-            Nd4jLong span = right - left;  // elements to be partitioned - 1
-
-            if (span == 1){
-                // only 2 elements to partition. swap if needed and return directly without further sorting.
-                if (ltIndices(indices, rank, right, left)){
-                    swapEverything(indices, array, rank, left, right);
-                }
-                return;
-            }
-
-
-            // find optimal pivot and sort left < right < right
-            Nd4jLong pvt = coo_quickSort_findPivot(indices, array, left, right, rank);
-
-            if (span == 2){
-                // only 3 elements to partition. findPivot has already sorted them. no further sorting is needed.
+        void SparseUtils<T>::sortCooIndicesGeneric(Nd4jLong *indices, T *values, Nd4jLong length, int rank) {
+            if (length < 2)
                 return;
-            }
-
-            // index that is greater than pivot - leftmost element is already partitioned because of findPivot.
-            Nd4jLong i = left + 1;
-
-            // index that is smaller than pivot - rightmost element is already partitioned because of findPivot.
-            Nd4jLong j = right - 1;
 
+            std::unique_ptr<Nd4jLong[]> keys(new Nd4jLong[length]);
+            std::unique_ptr<Nd4jLong[]> permutation(new Nd4jLong[length]);
+            for (Nd4jLong e = 0; e < length; e++)
+                permutation[e] = e;
 
-            {
-                // flag that indicates that pivot index lies between i and j and *could* be swapped.
-                bool checkPivot = true;
-                /* PARTITION PART */
-                while (i <= j) {
-                    while (ltIndices(indices, rank, i, pvt))
-                        i++;
-
-                    while (gtIndices(indices, rank, j, pvt))
-                        j--;
-
-
-                    if (i <= j) {
-                        if(i != j) { // swap can be fairly expensive. don't swap i -> i
-                            swapEverything(indices, array, rank, i, j);
-                        }
-
-                        // only check pivot if it hasn't already been swapped.
-                        if (checkPivot) {
-                            // check if we moved the pivot, if so, change pivot index accordingly
-                            if (pvt == j) {
-                                pvt = i;
-                                checkPivot = false;
-                            } else if (pvt == i) {
-                                pvt = j;
-                                checkPivot = false;
-                            }
-                        }
-
-                        i++;
-                        j--;
-                    }
-                }
+            // stable sorts by each dimension, starting from inner one, give lexicographic order
+            for (int d = rank - 1; d >= 0; d--) {
+                for (Nd4jLong e = 0; e < length; e++)
+                    keys[e] = indices[permutation[e] * rank + d];
 
+                SpecialMethods<Nd4jLong>::sortBufferByKey(keys.get(), permutation.get(), length, false);
             }
 
-            if ( (span < cutoff) ){
-                if (left < j){ coo_quickSort_parallel_internal(indices, array, left, j, cutoff, rank); }
-                if (i < right){ coo_quickSort_parallel_internal(indices, array, i, right, cutoff, rank); }
-
-            }else{
-#pragma omp task
-                { coo_quickSort_parallel_internal(indices, array, left, j, cutoff, rank); }
-#pragma omp task
-                { coo_quickSort_parallel_internal(indices, array, i, right, cutoff, rank); }
+            std::unique_ptr<Nd4jLong[]> sortedIndices(new Nd4jLong[length * rank]);
+            std::unique_ptr<T[]> sortedValues(new T[length]);
+            for (Nd4jLong e = 0; e < length; e++) {
+                memcpy(sortedIndices.get() + e * rank, indices + permutation[e] * rank, rank * sizeof(Nd4jLong));
+                sortedValues[e] = values[permutation[e]];
             }
 
-        }
-
-        template <typename T>
-        void SparseUtils<T>::coo_quickSort_parallel(Nd4jLong *indices, T* array, Nd4jLong lenArray, int numThreads, int rank){
-
-            int cutoff = 1000;
-
-            PRAGMA_OMP_PARALLEL_THREADS(numThreads)
-            {
-#pragma omp single nowait
-                {
-                    coo_quickSort_parallel_internal(indices, array, 0, lenArray-1, cutoff, rank);
-                }
-            }
-
-        }
-
-        template <typename T>
-        void SparseUtils<T>::sortCooIndicesGeneric(Nd4jLong *indices, T *values, Nd4jLong length, int rank) {
-#ifdef _OPENMP
-            coo_quickSort_parallel(indices, values, length, omp_get_max_threads(), rank);
-#else
-            coo_quickSort_parallel(indices, values, length, 1, rank);
-#endif
+            memcpy(indices, sortedIndices.get(), length * rank * sizeof(Nd4jLong));
+            for (Nd4jLong e = 0; e < length; e++)
+                values[e] = sortedValues[e];
         }
 
         BUILD_SINGLE_TEMPLATE(template class ND4J_EXPORT SparseUtils, , LIBND4J_TYPES);
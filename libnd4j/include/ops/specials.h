@@ -47,8 +47,6 @@ namespace nd4j {
         static void averageGeneric(void **x, void *z, Nd4jLong  *zShapeInfo, int n, const Nd4jLong length, bool propagate);
 
         static Nd4jLong getPosition(Nd4jLong *xShapeInfo, Nd4jLong index);
-        static void quickSort_parallel_internal(T* array, Nd4jLong *xShapeInfo, int left, int right, int cutoff, bool descending);
-        static void quickSort_parallel(void* array, Nd4jLong *xShapeInfo, Nd4jLong lenArray, int numThreads, bool descending);
 
         static int nextPowerOf2(int number);
         static int lastPowerOf2(int number);
@@ -56,6 +54,23 @@ namespace nd4j {
         static void sortGeneric(void *x, Nd4jLong *xShapeInfo, bool descending);
         static void sortTadGeneric(void *x, Nd4jLong *xShapeInfo, int *dimension, int dimensionLength, Nd4jLong *tadShapeInfo, Nd4jLong *tadOffsets, bool descending);
 
+        /**
+         * sorts contiguous buffer: sorting network for tiny arrays, LSD radix sort otherwise,
+         * large arrays are sorted in parallel chunks merged pairwise
+         */
+        static void sortBuffer(T* buffer, Nd4jLong length, bool descending);
+
+        /**
+         * stable sort of contiguous keys, indices are permuted along with them
+         */
+        static void sortBufferByKey(T* keys, Nd4jLong* indices, Nd4jLong length, bool descending);
+
+        /**
+         * returns n-th element of contiguous buffer in ascending (or descending) order, using Floyd-Rivest selection.
+         * Buffer is reordered in place: elements before returned one aren't greater than it, elements after it aren't smaller
+         */
+        static T nthElementGeneric(T* buffer, Nd4jLong length, Nd4jLong n, bool descending);
+
         static void decodeBitmapGeneric(void *dx, Nd4jLong N, void *dz, Nd4jLong *zShapeInfo);
         static Nd4jLong encodeBitmapGeneric(void *dx, Nd4jLong *zShapeInfo, Nd4jLong N, int *dz, float threshold);
     };
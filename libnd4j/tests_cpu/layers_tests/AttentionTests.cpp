@@ -215,4 +215,67 @@ TEST_F(AttentionTests, basic_multi_head_dot_product_bp_attention_with_mask) {
     ASSERT_EQ(Status::OK(), result->status());
 
     delete result;
-}
\ No newline at end of file
+}
+
+TEST_F(AttentionTests, fused_dot_product_attention_with_mask) {
+    auto keys = NDArrayFactory::create<double>('c', {2, 3, 8, 150});
+    auto values = NDArrayFactory::create<double>('c', {2, 3, 6, 150});
+    auto queries = NDArrayFactory::create<double>('c', {2, 3, 8, 70});
+    auto mask = NDArrayFactory::create<double>('c', {2, 150});
+
+    RandomGenerator rng(119L, 5L);
+    RandomLauncher::fillUniform(rng, &keys, -1.0, 1.0);
+    RandomLauncher::fillUniform(rng, &values, -1.0, 1.0);
+    RandomLauncher::fillUniform(rng, &queries, -1.0, 1.0);
+    mask.assign(1.);
+    for (int e = 0; e < 150; e += 7)
+        mask.p(1, e, 0.);
+
+    // requesting weights goes through the materialized path, otherwise the blocked kernel is used
+    nd4j::ops::dot_product_attention op;
+    auto fused = op.execute({&queries, &keys, &values, &mask}, {}, {1, 0}, {});
+    auto reference = op.execute({&queries, &keys, &values, &mask}, {}, {1, 1}, {});
+    ASSERT_EQ(Status::OK(), fused->status());
+    ASSERT_EQ(Status::OK(), reference->status());
+
+    ASSERT_TRUE(reference->at(0)->isSameShape(fused->at(0)));
+    ASSERT_TRUE(reference->at(0)->equalsTo(fused->at(0)));
+
+    delete fused;
+    delete reference;
+}
+
+TEST_F(AttentionTests, fused_dot_product_attention_bp_with_mask) {
+    auto keys = NDArrayFactory::create<double>('c', {2, 2, 5, 130});
+    auto values = NDArrayFactory::create<double>('c', {2, 2, 4, 130});
+    auto queries = NDArrayFactory::create<double>('c', {2, 2, 5, 70});
+    auto eps = NDArrayFactory::create<double>('c', {2, 2, 4, 70});
+    auto mask = NDArrayFactory::create<double>('c', {2, 130});
+
+    RandomGenerator rng(119L, 7L);
+    RandomLauncher::fillUniform(rng, &keys, -1.0, 1.0);
+    RandomLauncher::fillUniform(rng, &values, -1.0, 1.0);
+    RandomLauncher::fillUniform(rng, &queries, -1.0, 1.0);
+    RandomLauncher::fillUniform(rng, &eps, -1.0, 1.0);
+    mask.assign(1.);
+    for (int e = 3; e < 130; e += 5)
+        mask.p(0, e, 0.);
+
+    // f-ordered eps is not fusable, so the second run takes the materialized path
+    auto epsF = eps.dup('f');
+
+    nd4j::ops::dot_product_attention_bp op;
+    auto fused = op.execute({&queries, &keys, &values, &eps, &mask}, {}, {1}, {});
+    auto reference = op.execute({&queries, &keys, &values, epsF, &mask}, {}, {1}, {});
+    ASSERT_EQ(Status::OK(), fused->status());
+    ASSERT_EQ(Status::OK(), reference->status());
+
+    for (int e = 0; e < 3; ++e) {
+        ASSERT_TRUE(reference->at(e)->isSameShape(fused->at(e)));
+        ASSERT_TRUE(reference->at(e)->equalsTo(fused->at(e)));
+    }
+
+    delete epsF;
+    delete fused;
+    delete reference;
+}
@@ -1952,6 +1952,93 @@ TYPED_TEST(TypedConvolutionTests1, conv2d_test4) {
     delete results;
 }
 
+//////////////////////////////////////////////////////////////////////
+TYPED_TEST(TypedConvolutionTests1, conv2d_winograd_1) {
+
+    // 3x3 stride-1 with enough channels goes through Winograd F(4x4, 3x3) for NHWC and F(2x2, 3x3) for NCHW
+    int bS=2, iH=9,iW=10,  iC=16,oC=16,  kH=3,kW=3,  sH=1,sW=1,  pH=0,pW=0,  dH=1,dW=1;
+    int       oH=9,oW=10;
+    int paddingMode = 1;             // 1-SAME, 0-VALID;
+
+    for (int dataFormat = 0; dataFormat < 2; ++dataFormat) {
+        const bool isNCHW = dataFormat == 0;
+        NDArray input   = isNCHW ? NDArrayFactory::create<TypeParam>('c', {bS, iC, iH, iW}) : NDArrayFactory::create<TypeParam>('c', {bS, iH, iW, iC});
+        NDArray weights = NDArrayFactory::create<TypeParam>('c', {kH, kW, iC, isNCHW ? 2 : oC});
+        NDArray bias    = NDArrayFactory::create<TypeParam>('c', {isNCHW ? 2 : oC});
+
+        input.linspace(-1., 0.001);
+        weights.linspace(-0.05, 0.0001);
+        bias.linspace(1.);
+
+        const int outC = weights.sizeAt(3);
+        NDArray expOutput = isNCHW ? NDArrayFactory::create<TypeParam>('c', {bS, outC, oH, oW}) : NDArrayFactory::create<TypeParam>('c', {bS, oH, oW, outC});
+
+        for (int b = 0; b < bS; ++b)
+            for (int oc = 0; oc < outC; ++oc)
+                for (int oh = 0; oh < oH; ++oh)
+                    for (int ow = 0; ow < oW; ++ow) {
+                        double sum = bias.e<double>(oc);
+                        for (int kh = 0; kh < kH; ++kh)
+                            for (int kw = 0; kw < kW; ++kw) {
+                                int ih = oh - 1 + kh, iw = ow - 1 + kw;
+                                if (ih < 0 || ih >= iH || iw < 0 || iw >= iW)
+                                    continue;
+                                for (int ic = 0; ic < iC; ++ic)
+                                    sum += (isNCHW ? input.e<double>(b, ic, ih, iw) : input.e<double>(b, ih, iw, ic)) * weights.e<double>(kh, kw, ic, oc);
+                            }
+                        if (isNCHW)
+                            expOutput.p(b, oc, oh, ow, sum);
+                        else
+                            expOutput.p(b, oh, ow, oc, sum);
+                    }
+
+        nd4j::ops::conv2d op;
+        auto results = op.execute({&input, &weights, &bias}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat});
+        auto output = results->at(0);
+
+        ASSERT_EQ(Status::OK(), results->status());
+
+        ASSERT_TRUE(expOutput.isSameShape(output));
+        ASSERT_TRUE(expOutput.equalsTo(output, 1e-3));
+
+        delete results;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TYPED_TEST(TypedConvolutionTests1, pooling2d_nhwc_1) {
+
+    // channels-last pooling must give the same result as channels-first one
+    int bS=2, iH=7,iW=8,  iC=5,  kH=3,kW=2,  sH=2,sW=2,  pH=1,pW=1,  dH=1,dW=1;
+
+    NDArray inputNHWC = NDArrayFactory::create<TypeParam>('c', {bS, iH, iW, iC});
+    inputNHWC.linspace(-3., 0.1);
+    auto permuted  = inputNHWC.permute({0, 3, 1, 2});
+    auto inputNCHW = permuted->dup('c');
+
+    nd4j::ops::maxpool2d maxOp;
+    nd4j::ops::avgpool2d avgOp;
+
+    for (int mode = 0; mode < 2; ++mode) {
+        auto resNHWC = mode == 0 ? maxOp.execute({&inputNHWC}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, 0, 0, 1}) : avgOp.execute({&inputNHWC}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, 0, 0, 1});
+        auto resNCHW = mode == 0 ? maxOp.execute({inputNCHW},  {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, 0, 0, 0}) : avgOp.execute({inputNCHW},  {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, 0, 0, 0});
+
+        ASSERT_EQ(Status::OK(), resNHWC->status());
+        ASSERT_EQ(Status::OK(), resNCHW->status());
+
+        auto expected = resNCHW->at(0)->permute({0, 2, 3, 1});
+        ASSERT_TRUE(expected->isSameShape(resNHWC->at(0)));
+        ASSERT_TRUE(expected->equalsTo(resNHWC->at(0)));
+
+        delete expected;
+        delete resNHWC;
+        delete resNCHW;
+    }
+
+    delete permuted;
+    delete inputNCHW;
+}
+
 //////////////////////////////////////////////////////////////////////
 TYPED_TEST(TypedConvolutionTests1, conv3d_test11) {
 
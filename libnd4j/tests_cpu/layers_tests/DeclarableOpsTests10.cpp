@@ -1130,6 +1130,31 @@ TEST_F(DeclarableOpsTests10, NTH_Element_Test_8) {
     delete results;
 }
 
+///////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests10, NTH_Element_Test_9) {
+
+    // rows are different permutations of 0..1000, long enough for sampling step of selection
+    NDArray input = NDArrayFactory::create<float>('c', {3, 1001});
+    for (int r = 0; r < 3; r++)
+        for (int e = 0; e < 1001; e++)
+            input.p(r, e, (e * (7919 + r * 2)) % 1001);
+
+    NDArray n = NDArrayFactory::create<int>(123);
+    NDArray exp = NDArrayFactory::create<float>('c', {3}, {123.f, 123.f, 123.f});
+    NDArray expReverse = NDArrayFactory::create<float>('c', {3}, {877.f, 877.f, 877.f});
+
+    nd4j::ops::nth_element op;
+    auto results = op.execute({&input, &n}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+    ASSERT_TRUE(exp.equalsTo(results->at(0)));
+    delete results;
+
+    results = op.execute({&input, &n}, {}, {1});
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+    ASSERT_TRUE(expReverse.equalsTo(results->at(0)));
+    delete results;
+}
+
 ///////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests10, broadcast_to_test1) {
 
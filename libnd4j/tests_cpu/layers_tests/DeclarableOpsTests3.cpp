@@ -163,6 +163,60 @@ TEST_F(DeclarableOpsTests3, Test_Unique_2) {
     delete result;
 }
 
+TEST_F(DeclarableOpsTests3, Test_Unique_3) {
+    auto x= NDArrayFactory::create<float>('c', {12}, {3, -1, 7, 3, 0, -1, 5, 7, 7, -2, 0, 3});
+    auto expV= NDArrayFactory::create<float>('c', {6}, {3, -1, 7, 0, 5, -2});
+    auto expI= NDArrayFactory::create<Nd4jLong>('c', {12}, {0, 1, 2, 0, 3, 1, 4, 2, 2, 5, 3, 0});
+    auto expC= NDArrayFactory::create<Nd4jLong>('c', {6}, {3, 2, 3, 2, 1, 1});
+
+    nd4j::ops::unique_with_counts op;
+    auto result = op.execute({&x}, {}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+    ASSERT_EQ(3, result->size());
+
+    auto v = result->at(0);
+    auto i = result->at(1);
+    auto c = result->at(2);
+
+    ASSERT_TRUE(expV.isSameShape(v));
+    ASSERT_TRUE(expV.equalsTo(v));
+
+    ASSERT_TRUE(expI.isSameShape(i));
+    ASSERT_TRUE(expI.equalsTo(i));
+
+    ASSERT_TRUE(expC.isSameShape(c));
+    ASSERT_TRUE(expC.equalsTo(c));
+
+    delete result;
+}
+
+TEST_F(DeclarableOpsTests3, Test_Unique_4) {
+    auto x= NDArrayFactory::create<float>('c', {5}, {0.f, 1.f, -0.f, 1.f, 0.f});
+    auto expI= NDArrayFactory::create<Nd4jLong>('c', {5}, {0, 1, 0, 1, 0});
+    auto expC= NDArrayFactory::create<Nd4jLong>('c', {2}, {3, 2});
+
+    nd4j::ops::unique_with_counts op;
+    auto result = op.execute({&x}, {}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    auto v = result->at(0);
+    auto i = result->at(1);
+    auto c = result->at(2);
+
+    // signed zeros form single group, represented by its first occurrence
+    ASSERT_EQ(2, v->lengthOf());
+    ASSERT_EQ(0.f, v->e<float>(0));
+    ASSERT_FALSE(std::signbit(v->e<float>(0)));
+    ASSERT_EQ(1.f, v->e<float>(1));
+
+    ASSERT_TRUE(expI.equalsTo(i));
+    ASSERT_TRUE(expC.equalsTo(c));
+
+    delete result;
+}
+
 TEST_F(DeclarableOpsTests3, Test_Rint_1) {
     auto x= NDArrayFactory::create<float>('c', {1, 7}, {-1.7, -1.5, -0.2, 0.2, 1.5, 1.7, 2.0});
     auto exp= NDArrayFactory::create<float>('c', {1, 7}, {-2., -2., -0., 0., 2., 2., 2.});
@@ -789,6 +843,41 @@ TEST_F(DeclarableOpsTests3, Test_Batched_Gemm_Validation_2) {
     }
 }
 
+TEST_F(DeclarableOpsTests3, Test_Batched_Gemm_Alpha_1) {
+    const int batch = 16;
+    auto a = NDArrayFactory::create<float>('c', {1, batch});
+    auto b = NDArrayFactory::create<float>('c', {1, batch});
+    auto x = NDArrayFactory::create<float>('f', {3, 3}, {1, 2, 3, 4, 5, 6, 7, 8, 9});
+    auto y = NDArrayFactory::create<float>('f', {3, 3}, {1, 2, 3, 4, 5, 6, 7, 8, 9});
+    a.linspace(1);
+    b.assign(0.f);
+
+    auto exp = MmulHelper::mmul(&x, &y);
+
+    std::vector<NDArray*> inputs = {&a, &b};
+    for (int e = 0; e < batch; e++)
+        inputs.emplace_back(&x);
+    for (int e = 0; e < batch; e++)
+        inputs.emplace_back(&y);
+
+    nd4j::ops::batched_gemm op;
+    auto result = op.execute(inputs, {}, {111, 111, 3, 3, 3, 3, 3, 3, batch});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    ASSERT_EQ(batch, result->size());
+
+    for (int e = 0; e < batch; e++) {
+        auto z = result->at(e);
+        auto scaled = *exp * (float) (e + 1);
+
+        ASSERT_TRUE(scaled.isSameShape(z));
+        ASSERT_TRUE(scaled.equalsTo(z));
+    }
+
+    delete exp;
+    delete result;
+}
+
 TEST_F(DeclarableOpsTests3, Test_Manual_Gemm_1) {
     auto x= NDArrayFactory::create<float>('c', {3, 4}, {1, 2, 3, 4, 5, 6, 7, 8 , 9, 10, 11, 12});
     auto y= NDArrayFactory::create<float>('c', {4, 3}, {1, 2, 3, 4, 5, 6, 7, 8 , 9, 10, 11, 12});
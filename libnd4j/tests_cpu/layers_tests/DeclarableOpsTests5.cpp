@@ -1136,6 +1136,87 @@ TEST_F(DeclarableOpsTests5, Test_TopK_5) {
     delete result;
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests5, Test_TopK_6) {
+    auto x = NDArrayFactory::create<float>('c', {4, 1000});
+    x.linspace(1);
+
+    auto expV = NDArrayFactory::create<float>('c', {4, 3}, {1000.f, 999.f, 998.f, 2000.f, 1999.f, 1998.f, 3000.f, 2999.f, 2998.f, 4000.f, 3999.f, 3998.f});
+    auto expI = NDArrayFactory::create<Nd4jLong>('c', {4, 3}, {999, 998, 997, 999, 998, 997, 999, 998, 997, 999, 998, 997});
+
+    nd4j::ops::top_k op;
+    auto result = op.execute({&x}, {}, {3, 1});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+    ASSERT_EQ(2, result->size());
+
+    auto v = result->at(0);
+    auto i = result->at(1);
+
+    ASSERT_TRUE(expV.isSameShape(v));
+    ASSERT_TRUE(expV.equalsTo(v));
+
+    ASSERT_TRUE(expI.isSameShape(i));
+    ASSERT_TRUE(expI.equalsTo(i));
+
+    delete result;
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests5, Test_TopK_7) {
+    auto x = NDArrayFactory::create<double>('c', {2, 5}, {5.0, 1.0, 5.0, 3.0, 5.0, 2.0, 7.0, 2.0, 7.0, 1.0});
+    auto expV = NDArrayFactory::create<double>('c', {2, 2}, {5.0, 5.0, 7.0, 7.0});
+    auto expI = NDArrayFactory::create<Nd4jLong>('c', {2, 2}, {0, 2, 1, 3});
+
+    nd4j::ops::top_k op;
+    auto result = op.execute({&x}, {}, {2, 1});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+    ASSERT_EQ(2, result->size());
+
+    auto v = result->at(0);
+    auto i = result->at(1);
+
+    ASSERT_TRUE(expV.isSameShape(v));
+    ASSERT_TRUE(expV.equalsTo(v));
+
+    ASSERT_TRUE(expI.isSameShape(i));
+    ASSERT_TRUE(expI.equalsTo(i));
+
+    delete result;
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests5, Test_TopK_8) {
+    auto x = NDArrayFactory::create<float>('c', {1, 10}, {1.f, NAN, 3.f, -0.f, 7.f, NAN, 2.f, 0.f, 5.f, 4.f});
+    auto expI2 = NDArrayFactory::create<Nd4jLong>('c', {1, 2}, {1, 5});
+    auto expI5 = NDArrayFactory::create<Nd4jLong>('c', {1, 5}, {1, 5, 4, 8, 9});
+
+    // small k goes via heap, large k sorts whole row: NaN must be the largest value for both
+    nd4j::ops::top_k op;
+    auto result2 = op.execute({&x}, {}, {2, 1});
+    auto result5 = op.execute({&x}, {}, {5, 1});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result2->status());
+    ASSERT_EQ(ND4J_STATUS_OK, result5->status());
+
+    auto v5 = result5->at(0);
+
+    ASSERT_TRUE(expI2.equalsTo(result2->at(1)));
+    ASSERT_TRUE(expI5.equalsTo(result5->at(1)));
+
+    ASSERT_TRUE(std::isnan(result2->at(0)->e<float>(0)));
+    ASSERT_TRUE(std::isnan(result2->at(0)->e<float>(1)));
+    ASSERT_TRUE(std::isnan(v5->e<float>(0)));
+    ASSERT_TRUE(std::isnan(v5->e<float>(1)));
+    ASSERT_EQ(7.f, v5->e<float>(2));
+    ASSERT_EQ(5.f, v5->e<float>(3));
+    ASSERT_EQ(4.f, v5->e<float>(4));
+
+    delete result2;
+    delete result5;
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests5, Test_InTopK_1) {
     auto x = NDArrayFactory::create<double>('c', {2, 3}, {1.0, 11.0, 3.0, 14.0, 5.0, 6.0});
@@ -1760,6 +1760,54 @@ TEST_F(DeclarableOpsTests7, TestUnsortedSegmentSum_4) {
     delete result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests7, TestUnsortedSegmentSum_5) {
+    const int rows = 1000;
+    const int cols = 8;
+    const int classes = 10;
+    auto x = NDArrayFactory::create<float>('c', {rows, cols});
+    auto idx = NDArrayFactory::create<int>('c', {rows});
+    auto exp = NDArrayFactory::create<float>('c', {classes, cols});
+    x.linspace(1.f);
+
+    for (int r = 0; r < rows; r++) {
+        idx.p(r, (r * 7) % classes);
+        for (int c = 0; c < cols; c++)
+            exp.p((r * 7) % classes, c, exp.e<float>((r * 7) % classes, c) + x.e<float>(r, c));
+    }
+
+    nd4j::ops::unsorted_segment_sum op;
+
+    auto result = op.execute({&x, &idx}, {}, {classes});
+    ASSERT_EQ(result->status(), Status::OK());
+    ASSERT_TRUE(exp.isSameShape(result->at(0)));
+    ASSERT_TRUE(exp.equalsTo(result->at(0)));
+
+    // same data through non-contiguous rows
+    auto xF = x.dup('f');
+    auto resultF = op.execute({xF, &idx}, {}, {classes});
+    ASSERT_EQ(resultF->status(), Status::OK());
+    ASSERT_TRUE(exp.equalsTo(resultF->at(0)));
+
+    delete resultF;
+    delete xF;
+    delete result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests7, TestUnsortedSegmentSum_6) {
+    auto x = NDArrayFactory::create<double>('c', {4, 2}, {1., 2., 3., 4., 5., 6., 7., 8.});
+    auto idx = NDArrayFactory::create<int>({0, -1, 1, 0});
+
+    nd4j::ops::unsorted_segment_sum op;
+
+    // negative segment id is rejected instead of being used as index
+    auto result = op.execute({&x, &idx}, {}, {2});
+    ASSERT_NE(result->status(), Status::OK());
+
+    delete result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests7, TestSegmentProd_1) {
     auto x = NDArrayFactory::create<double>({1.8, 2.5, 4.,  9., 2.1, 2.4,3.,9., 2.1, 2.1,0.7, 0.1, 3., 4.2, 2.2, 1.});
@@ -3559,6 +3607,25 @@ TEST_F(DeclarableOpsTests7, percentile_test12) {
     delete result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests7, percentile_test13) {
+
+    auto input = NDArrayFactory::create<double>('c', {2, 5}, {5., 1., 4., 2., 3., 10., 30., 20., 50., 40.});
+
+    auto expected = NDArrayFactory::create<double>('c', {2}, {2.2, 22.});
+
+    nd4j::ops::percentile op;
+                                       //q,  interpolation, keepDims
+    auto result = op.execute({&input}, {30,  3,             0}, {1});
+    auto output = result->at(0);
+
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+    ASSERT_TRUE(expected.isSameShape(output));
+    ASSERT_TRUE(expected.equalsTo(output));
+
+    delete result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests7, transpose_test3) {
 
@@ -2648,36 +2648,68 @@ TEST_F(DeclarableOpsTests9, gru_cell_bp_test3) {
 }
 
 ////////////////////////////////////////////////////////////////////
-// TEST_F(DeclarableOpsTests9, gru_bp_test1) {
+TEST_F(DeclarableOpsTests9, gru_bp_test1) {
 
-//     const int time = 5;
-//     const int bS   = 2;
-//     const int iS   = 3;
-//     const int nU   = 4;
+    const int time = 5;
+    const int bS   = 2;
+    const int iS   = 3;
+    const int nU   = 4;
 
-//     NDArray<double> x     ('c', {time, bS, iS});
-//     NDArray<double> h0    ('c', {bS, nU});
-//     NDArray<double> Wx    ('c', {iS, 3*nU});
-//     NDArray<double> Wh    ('c', {nU, 3*nU});
-//     NDArray<double> b     ('c', {3*nU});
-//     NDArray<double> dLdh  ('c', {time, bS, nU});
+    NDArray x     ('c', {time, bS, iS}, nd4j::DataType::DOUBLE);
+    NDArray h0    ('c', {bS, nU}, nd4j::DataType::DOUBLE);
+    NDArray Wx    ('c', {iS, 3*nU}, nd4j::DataType::DOUBLE);
+    NDArray Wh    ('c', {nU, 3*nU}, nd4j::DataType::DOUBLE);
+    NDArray b     ('c', {3*nU}, nd4j::DataType::DOUBLE);
+    NDArray dLdh  ('c', {time, bS, nU}, nd4j::DataType::DOUBLE);
 
-//     x.linspace(0.5, 0.5);
-//     h0 = 1.;
-//     Wx = 0.003;
-//     Wh = 0.006;
-//     b  = 0.5;
+    x.linspace(0.5, 0.5);
+    h0 = 1.;
+    Wx = 0.003;
+    Wh = 0.006;
+    b  = 0.5;
 
-//     const OpArgsHolder<double> argsHolderFF({&x, &h0, &Wx, &Wh, &b}, {}, {});
-//     const OpArgsHolder<double> argsHolderBP({&x, &h0, &Wx, &Wh, &b, &dLdh}, {}, {});
+    const OpArgsHolder argsHolderFF({&x, &h0, &Wx, &Wh, &b}, {}, {});
+    const OpArgsHolder argsHolderBP({&x, &h0, &Wx, &Wh, &b, &dLdh}, {}, {});
 
-//     nd4j::ops::gru<double> opFF;
-//     nd4j::ops::gru_bp<double> opBP;
+    nd4j::ops::gru opFF;
+    nd4j::ops::gru_bp opBP;
 
-//     const bool isGradCorrect = GradCheck::checkGrad(opFF, opBP, argsHolderFF, argsHolderBP);
+    const bool isGradCorrect = GradCheck::checkGrad(opFF, opBP, argsHolderFF, argsHolderBP);
 
-//     ASSERT_TRUE(isGradCorrect);
-// }
+    ASSERT_TRUE(isGradCorrect);
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests9, gru_bp_test2) {
+
+    const int time = 3;
+    const int bS   = 3;
+    const int iS   = 2;
+    const int nU   = 3;
+
+    NDArray x     ('c', {time, bS, iS}, nd4j::DataType::DOUBLE);
+    NDArray h0    ('c', {bS, nU}, nd4j::DataType::DOUBLE);
+    NDArray Wx    ('c', {iS, 3*nU}, nd4j::DataType::DOUBLE);
+    NDArray Wh    ('c', {nU, 3*nU}, nd4j::DataType::DOUBLE);
+    NDArray b     ('c', {3*nU}, nd4j::DataType::DOUBLE);
+    NDArray dLdh  ('c', {time, bS, nU}, nd4j::DataType::DOUBLE);
+
+    x.linspace(-1., 0.1);
+    h0.linspace(-0.4, 0.1);
+    Wx.linspace(0.3, -0.03);
+    Wh.linspace(-0.5, 0.04);
+    b.linspace(0.1, 0.05);
+
+    const OpArgsHolder argsHolderFF({&x, &h0, &Wx, &Wh, &b}, {}, {});
+    const OpArgsHolder argsHolderBP({&x, &h0, &Wx, &Wh, &b, &dLdh}, {}, {});
+
+    nd4j::ops::gru opFF;
+    nd4j::ops::gru_bp opBP;
+
+    const bool isGradCorrect = GradCheck::checkGrad(opFF, opBP, argsHolderFF, argsHolderBP);
+
+    ASSERT_TRUE(isGradCorrect);
+}
 
 ////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests9, gru_cell_bp_test3_1) {
@@ -629,6 +629,31 @@ TEST_F(FlatBuffersTest, Ae_00) {
     delete graph;
 }
 
+TEST_F(FlatBuffersTest, Ae_00_Mapped) {
+    nd4j::ops::rank op1;
+
+    auto mapped = GraphExecutioner::importFromFlatBuffers("./resources/ae_00.fb");
+
+    auto data = readFlatBuffers("./resources/ae_00.fb");
+    auto copied = GraphExecutioner::importFromFlatPointer(reinterpret_cast<Nd4jPointer>(data));
+    delete[] data;
+
+    ASSERT_TRUE(mapped->isMapped());
+    ASSERT_FALSE(copied->isMapped());
+
+    ASSERT_EQ(ND4J_STATUS_OK, GraphExecutioner::execute(mapped));
+    ASSERT_EQ(ND4J_STATUS_OK, GraphExecutioner::execute(copied));
+
+    auto z = mapped->getVariableSpace()->getVariable(18)->getNDArray();
+    auto exp = copied->getVariableSpace()->getVariable(18)->getNDArray();
+
+    ASSERT_TRUE(exp->isSameShape(z));
+    ASSERT_TRUE(exp->equalsTo(z));
+
+    delete copied;
+    delete mapped;
+}
+
 TEST_F(FlatBuffersTest, expand_dims) {
     nd4j::ops::rank op1;
 
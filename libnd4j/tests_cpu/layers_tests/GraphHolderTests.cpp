@@ -20,6 +20,8 @@
 
 #include "testlayers.h"
 #include <graph/GraphHolder.h>
+#include <graph/VariableProxyPool.h>
+#include <GraphExecutioner.h>
 
 using namespace nd4j;
 using namespace nd4j::ops;
@@ -83,4 +85,80 @@ TEST_F(GraphHolderTests, SimpleTests_3) {
 
 
     delete graph2;
-}
\ No newline at end of file
+}
+
+TEST_F(GraphHolderTests, SharedExecution_1) {
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {5, 5});
+    x->assign(-2.0f);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    auto nodeA = new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {2});
+    auto nodeB = new Node(OpType_TRANSFORM_STRICT, transform::Cosine, 2, {1}, {3});
+    auto nodeC = new Node(OpType_TRANSFORM_SAME, transform::Abs, 3, {2}, {});
+
+    graph->addNode(nodeA);
+    graph->addNode(nodeB);
+    graph->addNode(nodeC);
+
+    ASSERT_TRUE(graph->isShareable());
+
+    VariableProxyPool pool(graph);
+
+    for (int e = 0; e < 3; e++) {
+        auto proxy = pool.acquire();
+        ASSERT_EQ(1, pool.active());
+
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph, proxy));
+
+        ASSERT_TRUE(proxy->hasVariable(3));
+        auto z = proxy->getVariable(3)->getNDArray();
+        ASSERT_TRUE(z != nullptr);
+        ASSERT_NEAR(0.4161468, z->reduceNumber(reduce::Mean).e<float>(0), 1e-5);
+
+        // results must stay within proxy
+        ASSERT_FALSE(graph->getVariableSpace()->getVariable(3)->hasNDArray());
+
+        pool.release(proxy);
+        ASSERT_EQ(1, pool.size());
+        ASSERT_EQ(0, pool.active());
+    }
+
+    delete graph;
+}
+
+TEST_F(GraphHolderTests, ReplaceGraph_1) {
+    auto graph = new Graph;
+    auto graph2 = new Graph;
+    Nd4jLong graphId = 113;
+
+    GraphHolder::getInstance()->registerGraph(graphId, graph);
+    ASSERT_TRUE(graph == GraphHolder::getInstance()->pullGraph(graphId));
+
+    // previous graph is released by holder
+    GraphHolder::getInstance()->replaceGraph(graphId, graph2);
+
+    ASSERT_TRUE(GraphHolder::getInstance()->hasGraph(graphId));
+    ASSERT_TRUE(graph2 == GraphHolder::getInstance()->pullGraph(graphId));
+
+    GraphHolder::getInstance()->dropGraph(graphId);
+
+    ASSERT_FALSE(GraphHolder::getInstance()->hasGraph(graphId));
+}
+
+TEST_F(GraphHolderTests, RegisterGraph_Exists_1) {
+    Graph graph;
+    Graph graph2;
+    Nd4jLong graphId = 114;
+
+    GraphHolder::getInstance()->registerGraph(graphId, &graph);
+
+    ASSERT_ANY_THROW(GraphHolder::getInstance()->registerGraph(graphId, &graph2));
+    ASSERT_TRUE(&graph == GraphHolder::getInstance()->pullGraph(graphId));
+
+    GraphHolder::getInstance()->forgetGraph(graphId);
+
+    ASSERT_FALSE(GraphHolder::getInstance()->hasGraph(graphId));
+}
@@ -332,6 +332,62 @@ TEST_F(GraphTests, QuadInput1) {
     delete graph;
 }
 
+TEST_F(GraphTests, QuadInput2) {
+    auto graph = new Graph();
+
+    auto x0 = NDArrayFactory::create_<float>('c', {5, 5});
+    x0->assign(0.0);
+
+    auto x1 = NDArrayFactory::create_<float>('c', {5, 5});
+    x1->assign(-1.0);
+
+    auto x2 = NDArrayFactory::create_<float>('c', {5, 5});
+    x2->assign(-2.0);
+
+    auto x3 = NDArrayFactory::create_<float>('c', {5, 5});
+    x3->assign(-3.0);
+
+    auto z = NDArrayFactory::create_<float>('c', {5, 5});
+    z->assign(119.0);
+
+    graph->getVariableSpace()->putVariable(-1, x0);
+    graph->getVariableSpace()->putVariable(-2, x1);
+    graph->getVariableSpace()->putVariable(-3, x2);
+    graph->getVariableSpace()->putVariable(-4, x3);
+    graph->getVariableSpace()->putVariable(-5, z);
+
+    auto nodeA = new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {11});
+    auto nodeB = new Node(OpType_TRANSFORM_SAME, transform::Abs, 2, {-2}, {11});
+    auto nodeC = new Node(OpType_TRANSFORM_SAME, transform::Abs, 3, {-3}, {21});
+    auto nodeD = new Node(OpType_TRANSFORM_SAME, transform::Abs, 4, {-4}, {21});
+
+    auto nodeP1 = new Node(OpType_PAIRWISE, pairwise::Add, 11, {1, 2}, {31});
+    auto nodeP2 = new Node(OpType_PAIRWISE, pairwise::Add, 21, {3, 4}, {31});
+
+    auto nodeZ = new Node(OpType_PAIRWISE, pairwise::Add, 31, {11, 21}, {-5});
+
+    graph->addNode(nodeA);
+    graph->addNode(nodeB);
+    graph->addNode(nodeC);
+    graph->addNode(nodeD);
+    graph->addNode(nodeP1);
+    graph->addNode(nodeP2);
+    graph->addNode(nodeZ);
+
+    ASSERT_EQ(4, graph->rootNodes());
+    ASSERT_EQ(7, graph->totalNodes());
+
+    // independent nodes within each layer will be executed concurrently
+    graph->getExecutorConfiguration()->_executionMode = ExecutionMode_AUTO;
+
+    auto status = GraphExecutioner::execute(graph);
+    ASSERT_EQ(Status::OK(), status);
+
+    ASSERT_NEAR(6.0, z->reduceNumber(reduce::Mean).e<float>(0), 1e-5);
+
+    delete graph;
+}
+
 TEST_F(GraphTests, InternalBranching1) {
     auto graph = new Graph();
 
@@ -1638,3 +1694,245 @@ TEST_F(GraphTests, Test_Minifier_3) {
     //ASSERT_EQ(0, unlink("libnd4j_mini3.hpp"));
 
 }
+
+TEST_F(GraphTests, Test_Elementwise_Fusion_1) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {3, 4}, {-1.f, 2.f, -3.f, 4.f, -5.f, 6.f, -7.f, 8.f, -9.f, 10.f, -11.f, 12.f});
+    auto y = NDArrayFactory::create_<float>('c', {3, 4});
+    auto b = NDArrayFactory::create_<float>('c', {4}, {1.f, 2.f, 3.f, 4.f});
+    auto exp = NDArrayFactory::create<float>('c', {3, 4}, {-2.f, -4.f, -6.f, -8.f, -6.f, -8.f, -10.f, -12.f, -10.f, -12.f, -14.f, -16.f});
+    y->assign(0.5f);
+
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, y);
+    graph.getVariableSpace()->putVariable(-3, b);
+
+    // -(abs(x) * 2 * y + b)
+    auto nodeA = new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1});
+    auto nodeB = new Node(OpType_SCALAR, scalar::Multiply, 2, {1}, {}, {}, 2.0f);
+    auto nodeC = new Node(OpType_PAIRWISE, pairwise::Multiply, 3, {2, -2});
+    auto nodeD = new Node(OpType_BROADCAST, broadcast::Add, 4, {3, -3}, {}, {1});
+    auto nodeE = new Node(OpType_TRANSFORM_SAME, transform::Neg, 5, {4});
+
+    graph.addNode(nodeA);
+    graph.addNode(nodeB);
+    graph.addNode(nodeC);
+    graph.addNode(nodeD);
+    graph.addNode(nodeE);
+
+    graph.buildGraph();
+    graph.fuseElementwiseNodes();
+
+    // whole chain is collapsed into its last node
+    ASSERT_FALSE(graph.hasNode(1));
+    ASSERT_FALSE(graph.hasNode(4));
+    ASSERT_TRUE(graph.hasNode(5));
+    ASSERT_EQ(3, graph.nodeById(5)->input()->size());
+
+    // fused nodes are released, so they must be gone from handles too
+    ASSERT_EQ(1, graph.getAllNodes()->size());
+    ASSERT_EQ(5, graph.getAllNodes()->at(0)->id());
+
+    auto status = GraphExecutioner::execute(&graph);
+    ASSERT_EQ(Status::OK(), status);
+
+    auto z = graph.getVariableSpace()->getVariable(5)->getNDArray();
+
+    ASSERT_TRUE(exp.isSameShape(z));
+    ASSERT_TRUE(exp.equalsTo(z));
+}
+
+TEST_F(GraphTests, Test_Elementwise_Fusion_2) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+    auto col = NDArrayFactory::create_<float>('c', {2}, {10.f, 20.f});
+    auto expA = NDArrayFactory::create<float>('c', {2, 3}, {-20.f, -30.f, -40.f, -100.f, -120.f, -140.f});
+    auto expB = NDArrayFactory::create<float>('c', {2, 3}, {2.f, 3.f, 4.f, 5.f, 6.f, 7.f});
+
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, col);
+
+    // node 1 has 2 consumers, so only 2 -> 3 is fused. broadcast along columns goes via sequential path
+    auto nodeA = new Node(OpType_SCALAR, scalar::Add, 1, {-1}, {}, {}, 1.0f);
+    auto nodeB = new Node(OpType_BROADCAST, broadcast::Multiply, 2, {1, -2}, {}, {0});
+    auto nodeC = new Node(OpType_TRANSFORM_SAME, transform::Neg, 3, {2});
+    auto nodeD = new Node(OpType_TRANSFORM_SAME, transform::Abs, 4, {1});
+
+    graph.addNode(nodeA);
+    graph.addNode(nodeB);
+    graph.addNode(nodeC);
+    graph.addNode(nodeD);
+
+    graph.buildGraph();
+    graph.fuseElementwiseNodes();
+
+    ASSERT_TRUE(graph.hasNode(1));
+    ASSERT_FALSE(graph.hasNode(2));
+    ASSERT_TRUE(graph.hasNode(3));
+    ASSERT_TRUE(graph.hasNode(4));
+
+    auto status = GraphExecutioner::execute(&graph);
+    ASSERT_EQ(Status::OK(), status);
+
+    auto zA = graph.getVariableSpace()->getVariable(3)->getNDArray();
+    auto zB = graph.getVariableSpace()->getVariable(4)->getNDArray();
+
+    ASSERT_TRUE(expA.equalsTo(zA));
+    ASSERT_TRUE(expB.equalsTo(zB));
+}
+
+TEST_F(GraphTests, Test_Constant_Folding_1) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 2}, {-1.f, 2.f, -3.f, 4.f});
+    auto y = NDArrayFactory::create_<float>('c', {2, 2}, {1.f, 1.f, 1.f, 1.f});
+    auto exp = NDArrayFactory::create<float>('c', {2, 2}, {3.f, 4.f, 5.f, 6.f});
+    auto expX = x->dup();
+
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, y);
+    graph.getVariableSpace()->getVariable(-1)->markConstant(true);
+
+    // nodes 1 and 2 depend on constant only, node 3 uses regular variable
+    auto nodeA = new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1});
+    auto nodeB = new Node(OpType_SCALAR, scalar::Add, 2, {1}, {}, {}, 1.0f);
+    auto nodeC = new Node(OpType_PAIRWISE, pairwise::Add, 3, {2, -2});
+
+    graph.addNode(nodeA);
+    graph.addNode(nodeB);
+    graph.addNode(nodeC);
+
+    graph.buildGraph();
+    auto folded = graph.foldConstants();
+
+    ASSERT_EQ(2, folded.size());
+    ASSERT_FALSE(graph.hasNode(1));
+    ASSERT_FALSE(graph.hasNode(2));
+    ASSERT_TRUE(graph.hasNode(3));
+    ASSERT_TRUE(graph.getVariableSpace()->getVariable(2)->isConstant());
+
+    graph.tagInplaceNodes();
+
+    // second run must see the same constants
+    for (int e = 0; e < 2; e++) {
+        auto status = GraphExecutioner::execute(&graph);
+        ASSERT_EQ(Status::OK(), status);
+
+        auto z = graph.getVariableSpace()->getVariable(3)->getNDArray();
+        ASSERT_TRUE(exp.equalsTo(z));
+    }
+
+    ASSERT_TRUE(expX->equalsTo(x));
+
+    delete expX;
+}
+
+TEST_F(GraphTests, Test_Dead_Nodes_1) {
+    Graph graph;
+    graph.getExecutorConfiguration()->_outputMode = OutputMode_EXPLICIT;
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 2}, {-1.f, 2.f, -3.f, 4.f});
+    auto exp = NDArrayFactory::create<float>('c', {2, 2}, {-1.f, -2.f, -3.f, -4.f});
+
+    graph.getVariableSpace()->putVariable(-1, x);
+
+    // only node 2 is requested, so branch 3 -> 4 isn't needed
+    auto nodeA = new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1});
+    auto nodeB = new Node(OpType_TRANSFORM_SAME, transform::Neg, 2, {1});
+    auto nodeC = new Node(OpType_TRANSFORM_FLOAT, transform::Sqrt, 3, {1});
+    auto nodeD = new Node(OpType_TRANSFORM_SAME, transform::Neg, 4, {3});
+
+    graph.addNode(nodeA);
+    graph.addNode(nodeB);
+    graph.addNode(nodeC);
+    graph.addNode(nodeD);
+    graph.addOutput(2);
+
+    graph.buildGraph();
+    auto pruned = graph.pruneDeadNodes();
+
+    ASSERT_EQ(2, pruned.size());
+    ASSERT_TRUE(graph.hasNode(1));
+    ASSERT_TRUE(graph.hasNode(2));
+    ASSERT_FALSE(graph.hasNode(3));
+    ASSERT_FALSE(graph.hasNode(4));
+
+    auto status = GraphExecutioner::execute(&graph);
+    ASSERT_EQ(Status::OK(), status);
+
+    auto outputs = graph.fetchOutputs();
+    ASSERT_EQ(1, outputs->size());
+    ASSERT_TRUE(exp.equalsTo(outputs->at(0)->getNDArray()));
+
+    delete outputs;
+}
+
+TEST_F(GraphTests, Test_Constant_Folding_2) {
+    Graph graph;
+    graph.getExecutorConfiguration()->_outputMode = OutputMode_OPTIMIZED;
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 2}, {-1.f, 2.f, -3.f, 4.f});
+    auto y = NDArrayFactory::create_<float>('c', {2, 2}, {1.f, 1.f, 1.f, 1.f});
+    auto exp = NDArrayFactory::create<float>('c', {2, 2}, {-3.f, -4.f, -5.f, -6.f});
+
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, y);
+    graph.getVariableSpace()->getVariable(-1)->markConstant(true);
+
+    // nodes 1 and 2 are folded, nodes 3 and 4 are fused
+    auto nodeA = new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1});
+    auto nodeB = new Node(OpType_SCALAR, scalar::Add, 2, {1}, {}, {}, 1.0f);
+    auto nodeC = new Node(OpType_PAIRWISE, pairwise::Add, 3, {2, -2});
+    auto nodeD = new Node(OpType_TRANSFORM_SAME, transform::Neg, 4, {3});
+
+    graph.addNode(nodeA);
+    graph.addNode(nodeB);
+    graph.addNode(nodeC);
+    graph.addNode(nodeD);
+
+    graph.buildGraph();
+
+    ASSERT_FALSE(graph.hasNode(1));
+    ASSERT_FALSE(graph.hasNode(2));
+    ASSERT_FALSE(graph.hasNode(3));
+
+    // same walk as timings in executeFlatBuffer: every handle must be alive
+    ASSERT_EQ(1, graph.getAllNodes()->size());
+    for (auto node: *graph.getAllNodes()) {
+        ASSERT_TRUE(graph.hasNode(node->id()));
+        ASSERT_TRUE(node->getContextPrototype() != nullptr);
+    }
+
+    auto status = GraphExecutioner::execute(&graph);
+    ASSERT_EQ(Status::OK(), status);
+
+    auto z = graph.getVariableSpace()->getVariable(4)->getNDArray();
+    ASSERT_TRUE(exp.equalsTo(z));
+}
+
+TEST_F(GraphTests, Test_Constant_Folding_3) {
+    Graph graph;
+
+    auto shape = NDArrayFactory::create_<Nd4jLong>('c', {2}, {2, 2});
+    graph.getVariableSpace()->putVariable(-1, shape);
+    graph.getVariableSpace()->getVariable(-1)->markConstant(true);
+
+    // inputs are constant, but every run must produce new random values
+    nd4j::ops::randomuniform opA;
+    nd4j::ops::skipgram opB;
+    auto nodeA = new Node(&opA, 1, {-1}, {}, {}, 0.0f, {0.0, 1.0});
+    auto nodeB = new Node(&opB, 2, {-1});
+
+    graph.addNode(nodeA);
+    graph.addNode(nodeB);
+
+    graph.buildGraph();
+    auto folded = graph.foldConstants();
+
+    ASSERT_EQ(0, folded.size());
+    ASSERT_TRUE(graph.hasNode(1));
+    ASSERT_TRUE(graph.hasNode(2));
+    ASSERT_EQ(2, graph.getAllNodes()->size());
+}
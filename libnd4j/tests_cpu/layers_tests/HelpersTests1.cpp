@@ -2055,4 +2055,78 @@ TEST_F(HelpersTests1, mmulMxV_7) {
 
     nd4j::MmulHelper::mmul(&a, &x, &y, 1., 0.);    
     ASSERT_TRUE(y.equalsTo(&exp));    
-}
\ No newline at end of file
+}
+//////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, mmulMxM_fallback_1) {
+
+    // mixed types are handled by fallback gemm
+    NDArray x('c', {3,3}, {10,11,12,13,14,15,16,17,18}, nd4j::DataType::INT32);
+    NDArray y('f', {3,3}, {1,4,7,2,5,8,3,6,9}, nd4j::DataType::FLOAT32);
+    NDArray z('c', {3,3}, nd4j::DataType::FLOAT32);
+    NDArray exp('c', {3,3}, {138.,171.,204. ,174.,216.,258. ,210.,261.,312.}, nd4j::DataType::FLOAT32);
+
+    nd4j::MmulHelper::mmul(&x, &y, &z, 1., 0.);
+    ASSERT_TRUE(z.equalsTo(&exp));
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, mmulMxM_fallback_2) {
+
+    // dimensions aren't multiples of blocking parameters, and K spans several blocks
+    const Nd4jLong M = 131;
+    const Nd4jLong N = 70;
+    const Nd4jLong K = 300;
+
+    NDArray a('c', {M,K}, nd4j::DataType::FLOAT32);
+    NDArray b('f', {K,N}, nd4j::DataType::DOUBLE);
+    a.linspace(-1., 0.001);
+    b.linspace(0.5, -0.002);
+
+    auto aD = a.cast(nd4j::DataType::DOUBLE);
+    NDArray exp('f', {M,N}, nd4j::DataType::DOUBLE);
+    NDArray z('f', {M,N}, nd4j::DataType::DOUBLE);
+    exp.assign(1.);
+    z.assign(1.);
+
+    nd4j::MmulHelper::mmul(aD, &b, &exp, 2., 0.5);
+    nd4j::MmulHelper::mmul(&a, &b, &z, 2., 0.5);
+
+    ASSERT_TRUE(z.equalsTo(&exp, 1e-5));
+
+    delete aD;
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, mmulMxM_half_1) {
+
+    // with fp16 accumulation this sum would stall far below expected value
+    const Nd4jLong K = 4096;
+
+    NDArray a('c', {16,K}, nd4j::DataType::HALF);
+    NDArray b('c', {K,16}, nd4j::DataType::HALF);
+    NDArray z('c', {16,16}, nd4j::DataType::HALF);
+    a.assign(0.01);
+    b.assign(1.);
+
+    nd4j::MmulHelper::mmul(&a, &b, &z, 1., 0.);
+
+    ASSERT_NEAR(K * a.e<float>(0), z.e<float>(0), 0.05);
+    ASSERT_NEAR(K * a.e<float>(0), z.e<float>(255), 0.05);
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, mmulMxM_bfloat16_1) {
+
+    const Nd4jLong K = 1024;
+
+    NDArray a('c', {8,K}, nd4j::DataType::BFLOAT16);
+    NDArray b('f', {K,8}, nd4j::DataType::BFLOAT16);
+    NDArray z('c', {8,8}, nd4j::DataType::BFLOAT16);
+    a.assign(0.5);
+    b.assign(0.25);
+
+    nd4j::MmulHelper::mmul(&a, &b, &z, 1., 0.);
+
+    ASSERT_NEAR(128.f, z.e<float>(0), 1e-3);
+    ASSERT_NEAR(128.f, z.e<float>(63), 1e-3);
+}
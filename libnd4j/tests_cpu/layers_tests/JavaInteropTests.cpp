@@ -24,6 +24,7 @@
 #include <ops/declarable/OpRegistrator.h>
 #include <graph/GraphHolder.h>
 #include <graph/FlatUtils.h>
+#include <ConstantTadHelper.h>
 #include "testlayers.h"
 #include <array>
 
@@ -1111,6 +1112,60 @@ TEST_F(JavaInteropTests, Test_Fastpath_6) {
     ASSERT_EQ(Status::OK(), status);
 }
 
+TEST_F(JavaInteropTests, Test_Sort_1) {
+    auto x = NDArrayFactory::create<float>('c', {40});
+    auto expA = NDArrayFactory::create<float>('c', {40});
+    auto expD = NDArrayFactory::create<float>('c', {40});
+    for (int e = 0; e < 40; e++) {
+        x.p(e, (float) ((e * 7) % 40) - 20.f);
+        expA.p(e, (float) e - 20.f);
+        expD.p(e, 19.f - (float) e);
+    }
+
+    NativeOps nativeOps;
+    nativeOps.sort(nullptr, x.buffer(), x.shapeInfo(), x.specialBuffer(), x.specialShapeInfo(), false);
+    ASSERT_EQ(expA, x);
+
+    nativeOps.sort(nullptr, x.buffer(), x.shapeInfo(), x.specialBuffer(), x.specialShapeInfo(), true);
+    ASSERT_EQ(expD, x);
+}
+
+TEST_F(JavaInteropTests, Test_SortTad_1) {
+    auto x = NDArrayFactory::create<int>('c', {3, 20});
+    auto exp = NDArrayFactory::create<int>('c', {3, 20});
+    for (int r = 0; r < 3; r++) {
+        for (int e = 0; e < 20; e++) {
+            x.p(r, e, ((e * 7) % 20) - 10 + r * 100);
+            exp.p(r, e, e - 10 + r * 100);
+        }
+    }
+
+    int dimension = 1;
+    auto pack = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(x.getShapeInfo(), {dimension});
+
+    NativeOps nativeOps;
+    nativeOps.sortTad(nullptr, x.buffer(), x.shapeInfo(), x.specialBuffer(), x.specialShapeInfo(), &dimension, 1, pack.primaryShapeInfo(), pack.primaryOffsets(), false);
+
+    ASSERT_EQ(exp, x);
+}
+
+TEST_F(JavaInteropTests, Test_SortCooIndices_1) {
+    Nd4jLong indices[] = {1, 0,  0, 2,  1, 1,  0, 1,  2, 0};
+    Nd4jLong values[] = {10, 20, 30, 40, 50};
+
+    Nd4jLong expI[] = {0, 1,  0, 2,  1, 0,  1, 1,  2, 0};
+    Nd4jLong expV[] = {40, 20, 10, 30, 50};
+
+    NativeOps nativeOps;
+    nativeOps.sortCooIndices(nullptr, indices, values, 5, 2);
+
+    for (int e = 0; e < 10; e++)
+        ASSERT_EQ(expI[e], indices[e]);
+
+    for (int e = 0; e < 5; e++)
+        ASSERT_EQ(expV[e], values[e]);
+}
+
 /*
 TEST_F(JavaInteropTests, Test_Results_Conversion_1) {
     NativeOps ops;
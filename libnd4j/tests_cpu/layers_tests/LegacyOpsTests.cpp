@@ -31,6 +31,7 @@
 #include <ops/declarable/LegacyBroadcastOp.h>
 #include <helpers/TAD.h>
 #include <helpers/ConstantTadHelper.h>
+#include <helpers/ThreadPool.h>
 
 using namespace nd4j;
 using namespace nd4j::ops;
@@ -325,6 +326,70 @@ TEST_F(LegacyOpsTests, ReduceTests_8) {
 }
 
 
+TEST_F(LegacyOpsTests, ReduceTests_9) {
+    auto x = NDArrayFactory::create<double>('c', {40000, 3});
+    x.linspace(1);
+
+    // few long strided TADs
+    auto sum = x.reduceAlongDims(reduce::Sum, {0});
+    auto expSum = NDArrayFactory::create<double>('c', {3}, {2399980000., 2400020000., 2400060000.});
+
+    ASSERT_TRUE(expSum.isSameShape(sum));
+    ASSERT_TRUE(expSum.equalsTo(sum));
+
+    // few long contiguous TADs
+    auto y = NDArrayFactory::create<double>('c', {3, 40000});
+    y.linspace(1);
+
+    auto mean = y.reduceAlongDims(reduce::Mean, {1});
+    auto expMean = NDArrayFactory::create<double>('c', {3}, {20000.5, 60000.5, 100000.5});
+
+    ASSERT_TRUE(expMean.isSameShape(mean));
+    ASSERT_TRUE(expMean.equalsTo(mean));
+}
+
+TEST_F(LegacyOpsTests, ReduceTests_10) {
+    auto x = NDArrayFactory::create<float>('c', {2, 50000});
+    x.linspace(0.001, 0.0137);
+
+    // failed assertion returns early, so previous mode is restored on scope exit
+    struct DeterministicGuard {
+        bool _previous;
+
+        explicit DeterministicGuard(bool deterministic) : _previous(Environment::getInstance()->isDeterministic()) {
+            Environment::getInstance()->setDeterministic(deterministic);
+        }
+
+        ~DeterministicGuard() {
+            Environment::getInstance()->setDeterministic(_previous);
+        }
+    };
+
+    NDArray sum, norm;
+    {
+        DeterministicGuard guard(true);
+
+        sum = x.reduceAlongDims(reduce::Sum, {1});
+        norm = x.reduceNumber(reduce::Norm2);
+
+        // results must be bitwise the same for any number of threads
+        ThreadPool::Session session(1);
+
+        auto sumSingle = x.reduceAlongDims(reduce::Sum, {1});
+        auto normSingle = x.reduceNumber(reduce::Norm2);
+
+        for (int e = 0; e < sum.lengthOf(); e++)
+            ASSERT_EQ(sum.e<float>(e), sumSingle.e<float>(e));
+
+        ASSERT_EQ(norm.e<float>(0), normSingle.e<float>(0));
+    }
+
+    DeterministicGuard guard(false);
+
+    auto exp = x.reduceAlongDims(reduce::Sum, {1});
+    ASSERT_TRUE(exp.equalsTo(sum, 1e-3));
+}
+
 TEST_F(LegacyOpsTests, IndexReduceTests_1) {
     auto x = NDArrayFactory::create<float>('c', {5, 5});
     x.linspace(1);
@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include "testlayers.h"
+#include <graph/Graph.h>
+#include <graph/MemoryPlan.h>
+#include <graph/VariableProxyPool.h>
+#include <GraphExecutioner.h>
+
+using namespace nd4j;
+using namespace nd4j::graph;
+
+class MemoryPlanTests : public testing::Test {
+public:
+
+};
+
+static Graph* buildChain() {
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {5, 5});
+    x->assign(-2.0f);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {2}));
+    graph->addNode(new Node(OpType_TRANSFORM_STRICT, transform::Cosine, 2, {1}, {3}));
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 3, {2}, {4}));
+    graph->addNode(new Node(OpType_TRANSFORM_STRICT, transform::Cosine, 4, {3}, {}));
+
+    return graph;
+}
+
+TEST_F(MemoryPlanTests, Test_Build_1) {
+    auto graph = buildChain();
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+    ASSERT_TRUE(MemoryPlan::isPlannable(graph));
+
+    MemoryPlan plan;
+    plan.build(graph, MemoryPlan::footprint(graph, graph->getVariableSpace()));
+
+    // last node is graph output, so it's not planned
+    ASSERT_EQ(3, plan.numberOfBuffers());
+    ASSERT_FALSE(plan.hasBuffer({4, 0}));
+
+    // node_1 and node_3 are never alive at the same time
+    ASSERT_EQ(plan.offset({1, 0}), plan.offset({3, 0}));
+    ASSERT_NE(plan.offset({1, 0}), plan.offset({2, 0}));
+
+    ASSERT_EQ(256, plan.arenaSize());
+    ASSERT_EQ(384, plan.totalSize());
+
+    delete graph;
+}
+
+TEST_F(MemoryPlanTests, Test_Execution_1) {
+    auto graph = buildChain();
+
+    VariableProxyPool pool(graph);
+
+    for (int e = 0; e < 3; e++) {
+        auto proxy = pool.acquire();
+        ASSERT_TRUE(proxy->isMemoryPlanningEnabled());
+
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph, proxy));
+
+        // plan is built after first round, and used afterwards
+        auto plan = graph->memoryPlan(MemoryPlan::signature(graph, proxy));
+        ASSERT_TRUE(plan != nullptr);
+        ASSERT_EQ(3, plan->numberOfBuffers());
+
+        auto z = proxy->getVariable(4)->getNDArray();
+        ASSERT_TRUE(z != nullptr);
+        ASSERT_NEAR(0.9146533, z->reduceNumber(reduce::Mean).e<float>(0), 1e-5);
+
+        pool.release(proxy);
+    }
+
+    delete graph;
+}
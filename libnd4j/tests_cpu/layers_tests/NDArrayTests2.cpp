@@ -22,6 +22,7 @@
 #include <memory>
 #include <NDArray.h>
 #include <DebugHelper.h>
+#include <helpers/ConstantShapeHelper.h>
 #include <ops/declarable/headers/parity_ops.h>
 
 using namespace nd4j;
@@ -1308,3 +1309,58 @@ TEST_F(NDArrayTest2, all_tads_1) {
 
     delete arrays;
 }
+
+TEST_F(NDArrayTest2, interned_shape_1) {
+    auto x = NDArrayFactory::create<float>('c', {4, 6});
+    x.linspace(1);
+
+    auto subA = x({0,2, 0,3}, true);
+    auto subB = x({2,4, 3,6}, true);
+
+    // sub-arrays of the same shape share single shapeInfo
+    ASSERT_TRUE(subA.getShapeInfo() == subB.getShapeInfo());
+    ASSERT_TRUE(subA.getShapeInfo() == ConstantShapeHelper::getInstance()->createFromExisting(subB.getShapeInfo()));
+    ASSERT_EQ(7.f, subA.e<float>(1, 0));
+    ASSERT_EQ(24.f, subB.e<float>(1, 2));
+
+    auto tadA = x.tensorAlongDimension(0, {1});
+    auto tadB = x.tensorAlongDimension(3, {1});
+    ASSERT_TRUE(tadA->getShapeInfo() == tadB->getShapeInfo());
+    ASSERT_EQ(19.f, tadB->e<float>(0));
+
+    // modification of shared shapeInfo goes to own copy
+    subA.updateStrides('f');
+    ASSERT_FALSE(subA.getShapeInfo() == subB.getShapeInfo());
+    ASSERT_EQ('c', subB.ordering());
+
+    delete tadA;
+    delete tadB;
+}
+
+TEST_F(NDArrayTest2, interned_shape_2) {
+    // local cache, so global one isn't filled up for other tests
+    ConstantShapeHelper helper(4);
+
+    auto x = NDArrayFactory::create<float>('c', {6, 6});
+    std::vector<Nd4jLong*> interned;
+    for (int i = 1; i <= 4; i++) {
+        auto sub = x({0,i, 0,6}, true);
+        auto ptr = helper.tryCreateFromExisting(sub.getShapeInfo());
+        ASSERT_TRUE(ptr != nullptr);
+        ASSERT_TRUE(shape::equalsStrict(ptr, sub.getShapeInfo()));
+        interned.emplace_back(ptr);
+    }
+
+    ASSERT_EQ(4, helper.cacheSize());
+
+    // cache is full: known shapes are still returned, new ones aren't added
+    auto known = x({0,2, 0,6}, true);
+    auto unknown = x({0,5, 0,6}, true);
+    ASSERT_TRUE(helper.tryCreateFromExisting(known.getShapeInfo()) == interned[1]);
+    ASSERT_TRUE(helper.tryCreateFromExisting(unknown.getShapeInfo()) == nullptr);
+    ASSERT_EQ(4, helper.cacheSize());
+
+    // unbounded interning isn't affected by limit
+    ASSERT_TRUE(helper.createFromExisting(unknown.getShapeInfo()) != nullptr);
+    ASSERT_EQ(5, helper.cacheSize());
+}
@@ -21,6 +21,8 @@
 #include "testlayers.h"
 #include <NDArray.h>
 #include <OmpLaunchHelper.h>
+#include <helpers/ThreadPool.h>
+#include <atomic>
 
 
 using namespace nd4j;
@@ -145,4 +147,58 @@ TEST_F(OmpLaunchHelperTests, test_tad_threads_5) {
     Nd4jLong tadLength = Environment::getInstance()->elementwiseThreshold();
 
     ASSERT_EQ(exp, OmpLaunchHelper::tadThreads(tadLength, numTads));
-}
\ No newline at end of file
+}
+
+TEST_F(OmpLaunchHelperTests, ThreadPool_ParallelFor_1) {
+    const Nd4jLong length = 10000;
+    std::vector<int> hits(length, 0);
+
+    ThreadPool::getInstance()->parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+        for (auto e = start; e < stop; e++)
+            hits[e]++;
+    }, 0, length, 64);
+
+    for (Nd4jLong e = 0; e < length; e++)
+        ASSERT_EQ(1, hits[e]);
+}
+
+TEST_F(OmpLaunchHelperTests, ThreadPool_ParallelReduce_1) {
+    auto sum = ThreadPool::getInstance()->parallel_reduce<Nd4jLong>([](Nd4jLong start, Nd4jLong stop) -> Nd4jLong {
+        Nd4jLong s = 0;
+        for (auto e = start; e < stop; e++)
+            s += e;
+        return s;
+    }, [](Nd4jLong a, Nd4jLong b) -> Nd4jLong { return a + b; }, 0, 100000, 0L, 128);
+
+    ASSERT_EQ(4999950000L, sum);
+}
+
+TEST_F(OmpLaunchHelperTests, ThreadPool_Nested_1) {
+    std::atomic<Nd4jLong> counter(0);
+
+    ThreadPool::Session session(2);
+    ThreadPool::getInstance()->parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+        for (auto e = start; e < stop; e++)
+            ThreadPool::getInstance()->parallel_for([&](Nd4jLong s, Nd4jLong f) {
+                counter += f - s;
+            }, 0, 100);
+    }, 0, 16);
+
+    ASSERT_EQ(1600L, counter.load());
+    ASSERT_EQ(1, ThreadPool::getInstance()->effectiveThreads(1000, 1000));
+}
+
+TEST_F(OmpLaunchHelperTests, ThreadPool_MinThreads_1) {
+    auto pool = ThreadPool::getInstance();
+    auto previous = pool->minThreads();
+
+    ThreadPool::Session session(4);
+    pool->setMinThreads(4);
+    auto threads = pool->effectiveThreads(1000, 1000);
+    auto tiny = pool->effectiveThreads(2, 1000);
+    pool->setMinThreads(previous);
+
+    // grain alone would keep such range on single thread, but range can't be split wider than its length
+    ASSERT_EQ(pool->maxThreads() < 4 ? pool->maxThreads() : 4, threads);
+    ASSERT_EQ(pool->maxThreads() < 2 ? pool->maxThreads() : 2, tiny);
+}
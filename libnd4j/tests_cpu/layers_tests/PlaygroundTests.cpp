@@ -1043,6 +1043,47 @@ TEST_F(PlaygroundTests, loop_test_1) {
     delete[] t;
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(PlaygroundTests, threshold_encoding_test_1) {
+    const Nd4jLong length = 10000000;
+    const float threshold = 0.99f;
+    auto x = NDArrayFactory::create<float>('c', {length});
+    x.linspace(-1.0f, 2.0f / length);
+
+    NativeOps ops;
+    const int numBlocks = length / THRESHOLD_BLOCK_SIZE + (length % THRESHOLD_BLOCK_SIZE ? 1 : 0);
+    std::vector<int> blocks(numBlocks + 1);
+    std::vector<int> offsets(numBlocks);
+    std::vector<int> encoded(length / 10 + 4);
+    auto z = NDArrayFactory::create<float>('c', {length});
+
+    FloatBits fb;
+    fb.f_ = threshold;
+
+    int iterations = 10;
+    Nd4jLong encTime = 0;
+    Nd4jLong decTime = 0;
+    for (int i = 0; i < iterations; i++) {
+        auto encStart = std::chrono::system_clock::now();
+        ops.encodeThresholdP1(nullptr, x.buffer(), x.shapeInfo(), length, blocks.data(), threshold);
+        ops.encodeThresholdP2Int(nullptr, blocks.data(), numBlocks, offsets.data());
+
+        encoded[0] = nd4j::math::nd4j_min<int>(blocks[0], encoded.size() - 4);
+        encoded[1] = length;
+        encoded[2] = fb.i_;
+        ops.encodeThresholdP3(nullptr, x.buffer(), x.shapeInfo(), offsets.data(), length, encoded.data());
+        auto encEnd = std::chrono::system_clock::now();
+
+        ops.decodeThreshold(nullptr, encoded.data(), length, z.buffer(), z.shapeInfo());
+        auto decEnd = std::chrono::system_clock::now();
+
+        encTime += std::chrono::duration_cast<std::chrono::microseconds> (encEnd - encStart).count();
+        decTime += std::chrono::duration_cast<std::chrono::microseconds> (decEnd - encEnd).count();
+    }
+
+    nd4j_printf("Threshold encoding: %lld us; decoding: %lld us; encoded: %i of %lld\n", encTime / iterations, decTime / iterations, encoded[0], length);
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(PlaygroundTests, ndarray_tile_test1) {
 
@@ -1570,6 +1611,44 @@ TEST_F(PlaygroundTests, test_addi_assign) {
     nd4j_printf("Bandwidth: %f GB/s\n", bw);
 }
 
+TEST_F(PlaygroundTests, test_fallback_gemm_1) {
+    int iterations = 10;
+    const Nd4jLong M = 512, N = 512, K = 512;
+
+    // mixed types go through fallback gemm, uniform types go through BLAS (if available)
+    auto aF = NDArrayFactory::create<float>('c', {M, K});
+    auto a = NDArrayFactory::create<double>('c', {M, K});
+    auto b = NDArrayFactory::create<double>('f', {K, N});
+    auto c = NDArrayFactory::create<double>('c', {M, N});
+    aF.linspace(0.01, 0.001);
+    a.linspace(0.01, 0.001);
+    b.linspace(0.01, 0.001);
+
+    for (int e = 0; e < 2; e++) {
+        MmulHelper::mmul(&aF, &b, &c, 1., 0.);
+        MmulHelper::mmul(&a, &b, &c, 1., 0.);
+    }
+
+    auto timeStart = std::chrono::system_clock::now();
+    for (int e = 0; e < iterations; e++)
+        MmulHelper::mmul(&aF, &b, &c, 1., 0.);
+
+    auto timeEnd = std::chrono::system_clock::now();
+    auto fallbackTime = std::chrono::duration_cast<std::chrono::microseconds> ((timeEnd - timeStart) / iterations).count();
+
+    timeStart = std::chrono::system_clock::now();
+    for (int e = 0; e < iterations; e++)
+        MmulHelper::mmul(&a, &b, &c, 1., 0.);
+
+    timeEnd = std::chrono::system_clock::now();
+    auto blasTime = std::chrono::duration_cast<std::chrono::microseconds> ((timeEnd - timeStart) / iterations).count();
+
+    auto gflops = [&](Nd4jLong time) { return 2. * M * N * K / time / 1000.; };
+
+    nd4j_printf("Fallback gemm: %lld us, %f GFLOPS\n", fallbackTime, gflops(fallbackTime));
+    nd4j_printf("BLAS gemm: %lld us, %f GFLOPS\n", blasTime, gflops(blasTime));
+}
+
 /*
 /////////////////////////////////////////////////////////////////////
 TEST_F(PlaygroundTests, conv2d_1) {
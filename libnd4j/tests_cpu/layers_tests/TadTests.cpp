@@ -303,6 +303,31 @@ TEST_F(TadTests, calcOffsets_1) {
         ASSERT_TRUE(offsets[e] == expOffsetsF[e]);
 }
 
+///////////////////////////////////////////////////////////////////
+TEST_F(TadTests, TadCache_Concurrent_1) {
+    auto x = NDArrayFactory::create<float>('c', {7, 11, 13});
+    auto helper = nd4j::ConstantTadHelper::getInstance();
+
+    auto expected = helper->tadForDimensions(x.shapeInfo(), {2});
+    auto misses = helper->cacheMisses();
+    auto hits = helper->cacheHits();
+
+    std::atomic<int> mismatches(0);
+
+    PRAGMA_OMP_PARALLEL_FOR_THREADS(4)
+    for (int e = 0; e < 1000; e++) {
+        auto &pack = helper->tadForDimensions(x.shapeInfo(), {2});
+        if (pack.primaryShapeInfo() != expected.primaryShapeInfo() || pack.numberOfTads() != 77)
+            mismatches++;
+    }
+
+    ASSERT_EQ(0, mismatches.load());
+
+    // all lookups above are cache hits, nothing was rebuilt
+    ASSERT_EQ(misses, helper->cacheMisses());
+    ASSERT_EQ(hits + 1000, helper->cacheHits());
+}
+
 /*
  // FIXME: we want this test passing eventually
 TEST_F(TadTests, Tad_1D_1) {
@@ -63,4 +63,50 @@ TEST_F(TypeCastTests, Test_ConvertDtype_1) {
 
     for (int e = 0; e < 5; e++)
         ASSERT_NEAR(exp[e], dst[e], (float16) 0.01f);
-}
\ No newline at end of file
+}
+TEST_F(TypeCastTests, Test_Threshold_Encoding_1) {
+    const Nd4jLong length = 5000;
+    const float threshold = 0.5f;
+    auto x = NDArrayFactory::create<float>('c', {length});
+    x.linspace(-1.0f, 2.0f / length);
+    auto orig = x.dup();
+
+    NativeOps ops;
+    const int numBlocks = length / THRESHOLD_BLOCK_SIZE + (length % THRESHOLD_BLOCK_SIZE ? 1 : 0);
+    std::vector<int> blocks(numBlocks + 1);
+    std::vector<int> offsets(numBlocks);
+
+    ops.encodeThresholdP1(nullptr, x.buffer(), x.shapeInfo(), length, blocks.data(), threshold);
+    ops.encodeThresholdP2Int(nullptr, blocks.data(), numBlocks, offsets.data());
+
+    int exp = 0;
+    for (Nd4jLong e = 0; e < length; e++)
+        if (nd4j::math::nd4j_abs<float>(orig->e<float>(e)) >= threshold)
+            exp++;
+
+    ASSERT_EQ(exp, blocks[0]);
+    ASSERT_EQ(0, offsets[0]);
+    ASSERT_EQ(blocks[1], offsets[1]);
+
+    FloatBits fb;
+    fb.f_ = threshold;
+    std::vector<int> encoded(blocks[0] + 4);
+    encoded[0] = blocks[0];
+    encoded[1] = length;
+    encoded[2] = fb.i_;
+
+    ops.encodeThresholdP3(nullptr, x.buffer(), x.shapeInfo(), offsets.data(), length, encoded.data());
+
+    // encoded indices go in ascending order
+    for (int e = 5; e < encoded.size(); e++)
+        ASSERT_LT(nd4j::math::nd4j_abs<int>(encoded[e - 1]), nd4j::math::nd4j_abs<int>(encoded[e]));
+
+    // decoded update + residual gives back the original values
+    auto z = NDArrayFactory::create<float>('c', {length});
+    ops.decodeThreshold(nullptr, encoded.data(), length, z.buffer(), z.shapeInfo());
+
+    z += x;
+    ASSERT_TRUE(orig->equalsTo(z));
+
+    delete orig;
+}
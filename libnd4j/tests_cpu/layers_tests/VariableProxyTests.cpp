@@ -170,4 +170,27 @@ TEST_F(VariableProxyTests, Test_Clone_1) {
     ASSERT_TRUE(clone->hasVariable(119));
 
     delete clone;
-}
\ No newline at end of file
+}
+
+TEST_F(VariableProxyTests, Test_Shadow_1) {
+    auto x = NDArrayFactory::create_<float>('c', {2, 2}, {1, 2, 3, 4});
+    VariableSpace ref;
+
+    ref.putVariable(119, new Variable(nullptr, "empty", 119));
+
+    VariableProxy proxy(&ref);
+
+    ASSERT_TRUE(proxy.hasVariable(119));
+
+    // empty backed variable shouldn't be updated via proxy
+    proxy.getVariable(119)->setNDArray(x);
+
+    ASSERT_FALSE(ref.getVariable(119)->hasNDArray());
+    ASSERT_TRUE(proxy.getVariable(119)->hasNDArray());
+    ASSERT_TRUE(x == proxy.getVariable(119)->getNDArray());
+
+    proxy.reset();
+
+    ASSERT_TRUE(proxy.hasVariable(119));
+    ASSERT_FALSE(proxy.getVariable(119)->hasNDArray());
+}
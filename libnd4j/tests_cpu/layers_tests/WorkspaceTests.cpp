@@ -252,6 +252,83 @@ TEST_F(WorkspaceTests, Test_Externalized_1) {
     ASSERT_NEAR(2.0f, m, 1e-5);
 }
 
+TEST_F(WorkspaceTests, Test_Concurrent_Allocation_1) {
+    Workspace workspace(64 * 1000);
+    std::vector<int8_t*> pointers(2000);
+
+    // half of allocations fit into workspace, the rest goes to spills
+    PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(dynamic, 16))
+    for (int e = 0; e < 2000; e++) {
+        pointers[e] = reinterpret_cast<int8_t *>(workspace.allocateBytes(64));
+        memset(pointers[e], e % 127, 64);
+    }
+
+    ASSERT_EQ(64 * 1000, workspace.getCurrentOffset());
+    ASSERT_EQ(64 * 1000, workspace.getSpilledSize());
+
+    // no memory was handed out twice
+    for (int e = 0; e < 2000; e++)
+        for (int i = 0; i < 64; i++)
+            ASSERT_EQ(e % 127, pointers[e][i]);
+
+    workspace.scopeOut();
+    workspace.scopeIn();
+
+    ASSERT_EQ(0, workspace.getSpilledSize());
+}
+
+TEST_F(WorkspaceTests, Test_Growth_1) {
+    Workspace workspace(1024);
+    workspace.setGrowthFactor(1.5);
+
+    for (int e = 0; e < 4; e++)
+        workspace.allocateBytes(512);
+
+    ASSERT_EQ(1024, workspace.getSpilledSize());
+    workspace.scopeOut();
+
+    // workspace learns from spills of previous cycle
+    ASSERT_EQ(3072, workspace.getCurrentSize());
+    ASSERT_EQ(0, workspace.getSpilledSize());
+    ASSERT_EQ(1, workspace.getSpilledCycles());
+    ASSERT_EQ(1024, workspace.getTotalSpilledSize());
+    ASSERT_EQ(2048, workspace.getPeakSize());
+
+    workspace.scopeIn();
+    for (int e = 0; e < 4; e++)
+        workspace.allocateBytes(512);
+
+    ASSERT_EQ(0, workspace.getSpilledSize());
+    workspace.scopeOut();
+
+    ASSERT_EQ(3072, workspace.getCurrentSize());
+    ASSERT_EQ(2, workspace.getNumberOfCycles());
+    ASSERT_EQ(1, workspace.getSpilledCycles());
+}
+
+TEST_F(WorkspaceTests, Test_Growth_2) {
+    Workspace workspace(1024);
+    workspace.setMaxSize(1536);
+
+    for (int e = 0; e < 4; e++)
+        workspace.allocateBytes(512);
+
+    workspace.scopeOut();
+    ASSERT_EQ(1536, workspace.getCurrentSize());
+
+    // max size is respected, so part of allocations still goes to spills
+    workspace.scopeIn();
+    for (int e = 0; e < 4; e++)
+        workspace.allocateBytes(512);
+
+    ASSERT_EQ(512, workspace.getSpilledSize());
+    workspace.scopeOut();
+
+    ASSERT_EQ(1536, workspace.getCurrentSize());
+    ASSERT_EQ(2, workspace.getSpilledCycles());
+    ASSERT_EQ(1536, workspace.getTotalSpilledSize());
+}
+
 // TODO: uncomment this test once long shapes are introduced
 /*
 TEST_F(WorkspaceTests, Test_Big_Allocation_1) {